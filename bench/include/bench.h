@@ -0,0 +1,90 @@
+// Minimal benchmarking utilities for the benchmark executable
+
+#ifndef CONVEXPOLYGONS_BENCH_H
+#define CONVEXPOLYGONS_BENCH_H
+
+#include <chrono>
+#include <cmath>  // std::cos, std::sin, M_PI
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "class/Point.h"
+
+
+namespace bench {
+
+    /// A named benchmark routine
+    struct Benchmark {
+        std::string name;
+        std::function<void()> run;
+    };
+
+    /// All benchmarks registered with the BENCHMARK macro
+    inline
+    std::vector<Benchmark> &registry() {
+        static std::vector<Benchmark> benchmarks;
+        return benchmarks;
+    }
+
+    /// Registers a benchmark on construction (see the BENCHMARK macro)
+    struct Registrar {
+        Registrar(const std::string &name, std::function<void()> run) {
+            registry().push_back({name, std::move(run)});
+        }
+    };
+
+
+    /// Number of heap allocations (with `operator new`) since the start of the program
+    unsigned long allocations();
+
+
+    /// Best wall-clock time (in seconds) out of `reps` executions of `fn`
+    template<typename Function>
+    double time(Function &&fn, int reps = 5) {
+        double best = 0;
+        for (int i = 0; i < reps; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            fn();
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            if (i == 0 or elapsed.count() < best) best = elapsed.count();
+        }
+        return best;
+    }
+
+    /// Prints a timing line, optionally with the speedup relative to a baseline time
+    inline
+    void report(const std::string &label, double seconds, double baseline = 0) {
+        std::cout << "  " << label << ": " << seconds*1e3 << " ms";
+        if (baseline > 0) std::cout << "  (x" << baseline/seconds << ")";
+        std::cout << std::endl;
+    }
+
+
+    /**
+     * Points evenly spaced on a circle, in counter-clockwise order. Same workload as
+     * `make_points` in `test/generator.py` (coordinates scaled by 1e12).
+     */
+    inline
+    Points circle(unsigned long n, double phase = 0, double x = 0, double y = 0) {
+        const double scale = 1e12, a = 2*M_PI/n;
+        Points points(n);
+        for (unsigned long i = 0; i < n; ++i)
+            points[i] = {scale*(std::cos(phase + i*a) + x), scale*(std::sin(phase + i*a) + y)};
+        return points;
+    }
+
+}
+
+
+#define _BENCH_CONCAT2(a, b) a##b
+#define _BENCH_CONCAT(a, b) _BENCH_CONCAT2(a, b)
+
+/// Defines and registers a benchmark routine with the given name
+#define BENCHMARK(name) \
+    static void _BENCH_CONCAT(_bench_, __LINE__)(); \
+    static bench::Registrar _BENCH_CONCAT(_bench_registrar_, __LINE__)(name, _BENCH_CONCAT(_bench_, __LINE__)); \
+    static void _BENCH_CONCAT(_bench_, __LINE__)()
+
+
+#endif //CONVEXPOLYGONS_BENCH_H
@@ -0,0 +1,73 @@
+#include "bench.h"
+
+#include <malloc.h>  // mallinfo2
+#include <random>
+#include "class/CompactPolygon.h"
+
+
+// Memory of a session with many polygons, stored as ConvexPolygon or CompactPolygon
+BENCHMARK("CompactPolygon: bytes per vertex (100000 polygons of 16 vertices)") {
+    const unsigned long n = 100000, k = 16;
+    auto heap = []{ struct mallinfo2 info = mallinfo2(); return info.uordblks + info.hblkhd; };
+
+    std::vector<ConvexPolygon> polygons;
+    std::size_t before = heap();
+    polygons.reserve(n);
+    for (unsigned long i = 0; i < n; ++i) polygons.push_back(ConvexPolygon(bench::circle(k, i, i%1000, i/1000)));
+    std::cout << "  doubles: " << double(heap() - before)/(n*k) << " bytes per vertex" << std::endl;
+
+    std::vector<CompactPolygon> compact;
+    before = heap();
+    compact.reserve(n);
+    for (const ConvexPolygon &pol : polygons) compact.emplace_back(pol);
+    std::cout << "  compact: " << double(heap() - before)/(n*k) << " bytes per vertex" << std::endl;
+}
+
+
+// Queries decoding the vertices on the fly vs the same loops over the doubles
+BENCHMARK("CompactPolygon: query throughput vs doubles (1000 polygons of 1000 vertices)") {
+    std::mt19937 randGen(42);
+    std::uniform_real_distribution<double> coord(-2e12, 2e12);  // (see bench::circle())
+    const unsigned long n = 1000, k = 1000;
+
+    std::vector<ConvexPolygon> polygons;
+    std::vector<CompactPolygon> compact;
+    for (unsigned long i = 0; i < n; ++i) {
+        polygons.push_back(ConvexPolygon(bench::circle(k, i)));
+        compact.emplace_back(polygons.back());
+    }
+    Points queries(n);
+    for (Point &P : queries) P = {coord(randGen), coord(randGen)};
+
+    double sink = 0;
+    auto compare = [&](const std::string &label, const std::function<void(unsigned long)> &doubles,
+                       const std::function<void(unsigned long)> &compacted) {
+        const double baseline = bench::time([&]{ for (unsigned long i = 0; i < n; ++i) doubles(i); });
+        bench::report(label + " (doubles)", baseline);
+        bench::report(label + " (compact)", bench::time([&]{ for (unsigned long i = 0; i < n; ++i) compacted(i); }), baseline);
+    };
+
+    compare("area", [&](unsigned long i) {
+        // (the same shoelace loop as CompactPolygon::area(), since ConvexPolygon::area() is memoized)
+        const Vertices &V = polygons[i].getVertices();
+        double sum = 0;
+        for (unsigned long j = 0; j + 1 < V.size(); ++j) sum += V[j].x*V[j + 1].y - V[j + 1].x*V[j].y;
+        sink += std::abs(sum)/2;
+    }, [&](unsigned long i) { sink += compact[i].area(); });
+    compare("perimeter", [&](unsigned long i) {
+        const Vertices &V = polygons[i].getVertices();
+        double sum = 0;
+        for (unsigned long j = 0; j + 1 < V.size(); ++j) sum += (V[j + 1] - V[j]).norm();
+        sink += sum;
+    }, [&](unsigned long i) { sink += compact[i].perimeter(); });
+    compare("inside (x1000 points)", [&](unsigned long i) {
+        for (const Point &P : queries) sink += isInside(P, polygons[i]);
+    }, [&](unsigned long i) {
+        for (const Point &P : queries) sink += compact[i].contains(P);
+    });
+
+    const double encoding = bench::time([&]{ for (const ConvexPolygon &pol : polygons) sink += CompactPolygon(pol).vertexCount(); });
+    bench::report("encode", encoding);
+    bench::report("decode", bench::time([&]{ for (const CompactPolygon &pol : compact) sink += pol.decode().vertexCount(); }));
+    if (sink == 0) std::cout << "  (unexpected result)" << std::endl;
+}
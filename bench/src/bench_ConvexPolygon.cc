@@ -0,0 +1,442 @@
+#include "bench.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <malloc.h>  // mallinfo2
+#include <memory>
+#include <numeric>  // std::accumulate
+#include <random>
+#include <boost/range/adaptors.hpp>  // boost::adaptors::sliced
+#include "class/ConvexPolygon.h"
+#include "geom.h"
+
+
+// Growing a polygon one point at a time: insert() vs the union with a one-point polygon
+BENCHMARK("ConvexPolygon: insert vs union (random disk, circle)") {
+    std::mt19937 randGen(42);
+    std::uniform_real_distribution<double> coord(-1, 1);
+
+    const unsigned long n = 5000;  // the union is quadratic on the circle
+    Points disk, circle = bench::circle(n);
+    while (disk.size() < n) {
+        Point P = {coord(randGen), coord(randGen)};
+        if (P.x*P.x + P.y*P.y <= 1) disk.push_back(P);
+    }
+    std::shuffle(circle.begin(), circle.end(), randGen);
+
+    for (const auto &workload : {std::make_pair("disk", &disk), std::make_pair("circle", &circle)}) {
+        const Points &points = *workload.second;
+        std::cout << " " << workload.first << ", n = " << n << std::endl;
+
+        double unions = bench::time([&]{
+            ConvexPolygon pol;
+            for (const Point &P : points) pol = convexUnion(pol, ConvexPolygon({P}));
+        }, 1);
+        double inserts = bench::time([&]{
+            ConvexPolygon pol;
+            for (const Point &P : points) pol.insert(P);
+        });
+        bench::report("union", unions);
+        bench::report("insert", inserts, unions);
+    }
+}
+
+
+// Vertex-wise metrics of large polygons, vectorized over the vertex arrays vs the previous
+// implementations over the array of points (reproduced here as the baseline)
+BENCHMARK("ConvexPolygon: metrics (circle)") {
+    for (unsigned long n : {100000ul, 1000000ul}) {
+        const ConvexPolygon pol(bench::circle(n));
+        const Vertices &v = pol.getVertices();
+        std::cout << " n = " << n << std::endl;
+
+        double sink = 0;  // so that nothing is optimized out
+        auto compare = [&](const std::string &label, const std::function<double()> &before,
+                           const std::function<double()> &after) {
+            double baseline = bench::time([&]{ sink += before(); });
+            bench::report(label + ", points", baseline);
+            bench::report(label + ", vertex arrays", bench::time([&]{ sink += after(); }), baseline);
+        };
+
+        // The arrays are built on first use (and then shared by pol's copies):
+        bench::report("vertex arrays (first use)", bench::time([&]{ sink += pol.getVertexArrays().x[0]; }, 1));
+        // (the metrics are memoized, so we call the kernels directly)
+        const double *x = pol.getVertexArrays().x.data(), *y = pol.getVertexArrays().y.data();
+        const unsigned long m = pol.vertexCount();
+
+        compare("area", [&]{
+            double sum = 0;
+            for (auto it = v.begin(); it < v.end() - 1; ++it) sum += (it[1].x - it[0].x)*(it[1].y + it[0].y);
+            return std::abs(sum/2);
+        }, [&]{ return std::abs(geom::shoelaceSum(x, y, m)/2); });
+        compare("perimeter", [&]{
+            double sum = 0;
+            for (auto it = v.begin(); it < v.end() - 1; ++it) sum += distance(it[0], it[1]);
+            return sum;
+        }, [&]{ return geom::chainLength(x, y, m); });
+        compare("bounding box", [&]{
+            return std::accumulate(v.begin(), v.end(), v.front(), bottomLeft).x
+                   + std::accumulate(v.begin(), v.end(), v.front(), upperRight).x;
+        }, [&]{
+            Point min, max;
+            geom::coordinateBounds(x, y, m, min, max);
+            return min.x + max.x;
+        });
+        compare("centroid", [&]{
+            return geom::barycenter(v | boost::adaptors::sliced(0, pol.vertexCount())).x;
+        }, [&]{ return geom::coordinateSum(x, y, m).x/m; });
+        if (sink == 0) std::cout << "  (unexpected result)" << std::endl;
+    }
+}
+
+
+// Many queries of every metric of the same polygon, as done by repeated commands
+BENCHMARK("ConvexPolygon: repeated metric queries") {
+    const int queries = 1000;
+    for (unsigned long n : {1000ul, 100000ul}) {
+        const ConvexPolygon pol(bench::circle(n));
+        const VertexArrays &soa = pol.getVertexArrays();
+        const double *x = soa.x.data(), *y = soa.y.data();
+        const unsigned long m = pol.vertexCount();
+        std::cout << " n = " << n << ", " << queries << " queries" << std::endl;
+
+        double sink = 0;
+        double baseline = bench::time([&]{
+            for (int i = 0; i < queries; ++i) {
+                Point min, max;
+                geom::coordinateBounds(x, y, m, min, max);
+                sink += geom::shoelaceSum(x, y, m) + geom::chainLength(x, y, m) + geom::coordinateSum(x, y, m).x/m + max.x;
+            }
+        });
+        bench::report("recomputed", baseline);
+
+        ConvexPolygon::resetCacheStats();
+        bench::report("memoized", bench::time([&]{
+            for (int i = 0; i < queries; ++i)
+                sink += pol.area() + pol.perimeter() + pol.centroid().x + pol.boundingBox().NE().x;
+        }), baseline);
+        ConvexPolygon::CacheStats stats = ConvexPolygon::cacheStats();
+        std::cout << "  (" << stats.hits << " hits, " << stats.misses << " misses)" << std::endl;
+        if (sink == 0) std::cout << "  (unexpected result)" << std::endl;
+    }
+}
+
+
+// A session with lots of tiny polygons (triangles and boxes, as made by the `bbox` command):
+// inline vertex storage vs a vector of points (the previous layout, reproduced here)
+BENCHMARK("ConvexPolygon: many small polygons") {
+    struct VectorPolygon {  // the layout of a ConvexPolygon before Vertices
+        Points vertices;
+        RGBColor color;
+        std::shared_ptr<void> cache;
+    };
+    const unsigned long n = 10000000;
+    const Point A = {0, 0}, B = {0, 1}, C = {1, 0}, D = {1, 1};
+    std::cout << " n = " << n << " (half triangles, half boxes)" << std::endl;
+
+    auto session = [&](const std::string &label, const std::function<void(unsigned long)> &run) {
+        const unsigned long allocations = bench::allocations();
+        auto heap = []{ struct mallinfo2 info = mallinfo2(); return info.uordblks + info.hblkhd; };
+        const std::size_t before = heap();
+        const double seconds = bench::time([&]{ run(n); }, 1);
+        std::cout << "  " << label << ": " << seconds*1e3 << " ms, "
+                  << (bench::allocations() - allocations) << " allocations, "
+                  << double(heap() - before)/n << " bytes per polygon" << std::endl;
+    };
+
+    {
+        std::vector<VectorPolygon> polygons;
+        session("vector of points", [&](unsigned long n) {
+            polygons.reserve(n);
+            for (unsigned long i = 0; i < n; ++i) {
+                if (i%2) polygons.push_back({{A, B, C, A}, RGBColor(), {}});
+                else polygons.push_back({{A, B, D, C, A}, RGBColor(), {}});
+            }
+        });
+    }
+    {
+        std::vector<ConvexPolygon> polygons;
+        session("inline vertices", [&](unsigned long n) {
+            polygons.reserve(n);
+            for (unsigned long i = 0; i < n; ++i) {
+                if (i%2) polygons.push_back(ConvexPolygon::fromHull({A, B, C}, true));
+                else polygons.push_back(Box(A, D));
+            }
+        });
+    }
+    std::cout << "  (sizeof: " << sizeof(VectorPolygon) << " vs " << sizeof(ConvexPolygon) << " bytes)" << std::endl;
+}
+
+
+// A session that copies big polygons around (saving results under other IDs, and snapshots
+// of every polygon), and then modifies a few of the copies: shared vertex buffers vs deep
+// copies of the vertices (the previous layout, reproduced with a vector of points)
+BENCHMARK("ConvexPolygon: copies of big polygons") {
+    const unsigned long k = 1000, n = 1000;  // k polygons of n vertices
+    std::vector<ConvexPolygon> originals;
+    for (unsigned long i = 0; i < k; ++i) originals.push_back(ConvexPolygon(bench::circle(n, i)));
+    std::vector<Points> deep;
+    for (const ConvexPolygon &pol : originals) deep.emplace_back(pol.getVertices());
+    std::cout << " " << k << " polygons of " << n << " vertices, 10 copies each, 1 in 10 copies modified" << std::endl;
+
+    auto session = [&](const std::string &label, const std::function<void()> &run, double baseline = 0) {
+        const unsigned long allocations = bench::allocations();
+        const double seconds = bench::time(run, 1);
+        bench::report(label, seconds, baseline);
+        std::cout << "  (" << (bench::allocations() - allocations) << " allocations)" << std::endl;
+        return seconds;
+    };
+
+    const Point P = {2e12, 0};  // (outside every polygon)
+    const double baseline = session("deep copies", [&]{
+        std::vector<Points> copies;
+        copies.reserve(10*k);
+        for (int c = 0; c < 10; ++c) copies.insert(copies.end(), deep.begin(), deep.end());
+        for (unsigned long i = 0; i < copies.size(); i += 10) copies[i].push_back(P);
+    });
+    ConvexPolygon::resetStorageStats();
+    session("shared buffers", [&]{
+        std::vector<ConvexPolygon> copies;
+        copies.reserve(10*k);
+        for (int c = 0; c < 10; ++c) copies.insert(copies.end(), originals.begin(), originals.end());
+        for (unsigned long i = 0; i < copies.size(); i += 10) copies[i].insert(P);
+    }, baseline);
+    const ConvexPolygon::StorageStats stats = ConvexPolygon::storageStats();
+    std::cout << "  (" << stats.buffers << " buffers allocated, " << stats.shares << " shared, "
+              << stats.copies << " copied)" << std::endl;
+}
+
+
+// Intersection of two big circles, as in examples/intersection (a circle and a translation
+// thereof) and test/text/circle-rot.txt (a small rotation: every edge crosses two others)
+BENCHMARK("ConvexPolygon: intersection (circle, circle-transl, circle-rot)") {
+    for (unsigned long n : {100000ul, 1000000ul}) {
+        const ConvexPolygon circle(bench::circle(n)), translated(bench::circle(n, 0, 0.7)),
+                rotated(bench::circle(n, M_PI/n/2));
+        std::cout << " n = " << n << std::endl;
+
+        unsigned long vertices = 0;
+        bench::report("circle & circle-transl", bench::time([&]{
+            vertices = intersection(circle, translated).vertexCount();
+        }, 3));
+        std::cout << "  (" << vertices << " vertices)" << std::endl;
+        bench::report("circle & circle-rot", bench::time([&]{
+            vertices = intersection(circle, rotated).vertexCount();
+        }, 3));
+        std::cout << "  (" << vertices << " vertices)" << std::endl;
+    }
+}
+
+
+// Union of two big circles (as in the intersection benchmark), and of a big circle and a
+// small polygon sticking out of it
+BENCHMARK("ConvexPolygon: union (circle, circle-transl, small polygon)") {
+    for (unsigned long n : {100000ul, 1000000ul}) {
+        const ConvexPolygon circle(bench::circle(n)), translated(bench::circle(n, 0, 0.7)),
+                small(bench::circle(8, 0, 1.1, 0.3));
+        std::cout << " n = " << n << std::endl;
+
+        unsigned long vertices = 0;
+        bench::report("circle | circle-transl", bench::time([&]{
+            vertices = convexUnion(circle, translated).vertexCount();
+        }, 3));
+        std::cout << "  (" << vertices << " vertices)" << std::endl;
+        bench::report("circle | small polygon", bench::time([&]{
+            vertices = convexUnion(circle, small).vertexCount();
+        }, 3));
+        std::cout << "  (" << vertices << " vertices)" << std::endl;
+    }
+}
+
+
+// Union and intersection of many polygons: a chain of binary operations, as scripts used
+// to do, vs the n-ary ones. The union is of small circles along a big one (so the partial
+// results of the chain keep growing), and the intersection is of big circles around a
+// point that moves along a small one.
+BENCHMARK("ConvexPolygon: n-ary union and intersection") {
+    typedef ConvexPolygon (*Binary)(const ConvexPolygon &, const ConvexPolygon &);
+    typedef std::function<ConvexPolygon(const std::vector<ConvexPolygon> &)> NAry;
+    auto compare = [](const std::string &label, const std::vector<ConvexPolygon> &polygons,
+                      Binary binary, const NAry &nary) {
+        unsigned long vertices = 0;
+        double chained = bench::time([&]{
+            ConvexPolygon result = polygons.front();
+            for (auto it = polygons.begin() + 1; it != polygons.end(); ++it) result = binary(result, *it);
+            vertices = result.vertexCount();
+        }, 1);
+        bench::report(label + ", chained", chained);
+        bench::report(label + ", n-ary", bench::time([&]{ vertices = nary(polygons).vertexCount(); }, 1), chained);
+        std::cout << "  (" << vertices << " vertices)" << std::endl;
+    };
+
+    for (unsigned long count : {16ul, 256ul, 4096ul}) {
+        const unsigned long n = 1000;
+        std::vector<ConvexPolygon> circles;
+        for (unsigned long k = 0; k < count; ++k) {
+            const double angle = 2*M_PI*k/count;
+            circles.emplace_back(bench::circle(n, 0, count*std::cos(angle), count*std::sin(angle)));
+        }
+        std::cout << " " << count << " circles, n = " << n << std::endl;
+        compare("union", circles, convexUnion, [](const std::vector<ConvexPolygon> &pols) { return convexUnion(pols); });
+    }
+    for (unsigned long count : {16ul, 256ul}) {
+        const unsigned long n = 20000;
+        std::vector<ConvexPolygon> circles;
+        for (unsigned long k = 0; k < count; ++k) {
+            const double shift = 2*M_PI*k/count;
+            circles.emplace_back(bench::circle(n, M_PI*k/count/n, 0.1*std::cos(shift), 0.1*std::sin(shift)));
+        }
+        std::cout << " " << count << " circles, n = " << n << std::endl;
+        compare("intersection", circles, intersection,
+                [](const std::vector<ConvexPolygon> &pols) { return intersection(pols); });
+    }
+}
+
+
+// The `inside` command: a big circle inside a slightly bigger one, a triangle inside the
+// circle, and a circle next to it (rejected by their bounding boxes)
+BENCHMARK("ConvexPolygon: inside (circle, bigger circle, triangle, translated circle)") {
+    const ConvexPolygon triangle({{0, 0}, {0.5, 0.5}, {0.5, -0.5}});
+    for (unsigned long n : {100000ul, 1000000ul}) {
+        Points points = bench::circle(n);
+        const ConvexPolygon circle(points), translated(bench::circle(n, 0, 1.5));
+        for (Point &P : points) P = {1.001*P.x, 1.001*P.y};
+        const ConvexPolygon bigger(points);
+        circle.boundingBox(), bigger.boundingBox(), translated.boundingBox();  // (memoized, as after the first query)
+        std::cout << " n = " << n << std::endl;
+
+        bool inside = false;
+        bench::report("circle in bigger circle", bench::time([&]{ inside = isInside(circle, bigger); }));
+        std::cout << "  (" << (inside ? "yes" : "no") << ")" << std::endl;
+        bench::report("triangle in circle", bench::time([&]{
+            for (int i = 0; i < 1000; ++i) inside = isInside(triangle, circle);
+        }));
+        std::cout << "  (" << (inside ? "yes" : "no") << ", 1000 queries)" << std::endl;
+        bench::report("translated circle in circle", bench::time([&]{ inside = isInside(translated, circle); }));
+        std::cout << "  (" << (inside ? "yes" : "no") << ")" << std::endl;
+    }
+}
+
+
+// Classifying many points (a random square around a circle) against the same polygon: one
+// by one, in vectorized batches, and sorted by angle around the centroid (swept)
+BENCHMARK("ConvexPolygon: classify points (random square, circle)") {
+    std::mt19937 randGen(42);
+    std::uniform_real_distribution<double> coord(-1.2, 1.2);
+    const unsigned long k = 10000000;
+    Points points(k);
+    for (Point &P : points) P = {coord(randGen), coord(randGen)};
+    std::unique_ptr<bool[]> inside(new bool[k]);
+
+    for (unsigned long n : {1000ul, 100000ul}) {
+        const ConvexPolygon circle(bench::circle(n));
+        circle.getVertexArrays(), circle.centroid();  // (memoized, as after the first query)
+        std::cout << " k = " << k << ", n = " << n << std::endl;
+
+        double baseline = bench::time([&]{
+            for (unsigned long i = 0; i < k; ++i) inside[i] = isInside(points[i], circle);
+        }, 1);
+        bench::report("one by one", baseline);
+        bench::report("batch", bench::time([&]{ isInside(points.data(), k, circle, inside.get()); }, 1), baseline);
+
+        Points sorted = points;
+        const Point center = circle.centroid();
+        std::sort(sorted.begin(), sorted.end(), [&center](const Point &P, const Point &Q) {
+            return std::atan2(P.y - center.y, P.x - center.x) > std::atan2(Q.y - center.y, Q.x - center.x);
+        });
+        bench::report("batch, sorted by angle", bench::time([&]{
+            isInside(sorted.data(), k, circle, inside.get());
+        }, 1), baseline);
+    }
+}
+
+
+// Overlap tests between big polygons, with the predicate vs. building the intersection
+BENCHMARK("ConvexPolygon: intersects vs intersection (circle, overlapping, touching, disjoint)") {
+    for (unsigned long n : {1000ul, 100000ul}) {
+        const ConvexPolygon circle(bench::circle(n)), overlapping(bench::circle(n, 0.5, 1.5)),
+                touching(bench::circle(n, 0, 2)), disjoint(bench::circle(n, 0.5, 2.1));
+        std::cout << " n = " << n << std::endl;
+
+        for (const auto &other : {std::make_pair("overlapping", &overlapping), std::make_pair("touching", &touching),
+                                  std::make_pair("disjoint", &disjoint)}) {
+            const int queries = n >= 100000 ? 10 : 100;
+            bool result = false, expected = false;
+            const unsigned long allocations = bench::allocations();
+            const double predicate = bench::time([&]{
+                for (int i = 0; i < queries; ++i) result = intersects(circle, *other.second);
+            });
+            const unsigned long predicateAllocations = bench::allocations() - allocations;
+            const double construction = bench::time([&]{
+                for (int i = 0; i < queries; ++i) expected = not intersection(circle, *other.second).empty();
+            });
+            std::cout << "  " << other.first << " (" << (result ? "yes" : "no") << (result == expected ? "" : ", MISMATCH")
+                      << ", " << queries << " queries, " << predicateAllocations << " allocations):" << std::endl;
+            bench::report("intersection", construction);
+            bench::report("intersects", predicate, construction);
+        }
+    }
+}
+
+
+// Minkowski sums by merging edges vs. the hull of every pairwise sum of vertices
+BENCHMARK("ConvexPolygon: Minkowski sum (circle, smaller circle)") {
+    for (auto sizes : {std::make_pair(100ul, 100ul), std::make_pair(1000ul, 1000ul), std::make_pair(100000ul, 10ul)}) {
+        const ConvexPolygon big(bench::circle(sizes.first)), small(bench::circle(sizes.second, 0.5, 0, 0));
+        std::cout << " n = " << sizes.first << ", m = " << sizes.second << std::endl;
+
+        ConvexPolygon expected, sum;
+        const double baseline = bench::time([&]{
+            Points sums;
+            sums.reserve(sizes.first*sizes.second);
+            for (const Point &P : big.getVertices() | boost::adaptors::sliced(0, sizes.first))
+                for (const Point &Q : small.getVertices() | boost::adaptors::sliced(0, sizes.second))
+                    sums.push_back({P.x + Q.x, P.y + Q.y});
+            expected = ConvexPolygon(move(sums));
+        }, 1);
+        bench::report("hull of pairwise sums", baseline);
+        bench::report("minkowskiSum", bench::time([&]{ sum = minkowskiSum(big, small); }), baseline);
+        std::cout << "  (" << sum.vertexCount() << " vertices" << (sum == expected ? "" : ", MISMATCH") << ")" << std::endl;
+    }
+}
+
+
+// Distances by brute force (every vertex to every edge) vs. the logarithmic searches
+BENCHMARK("ConvexPolygon: distances (circle, translated circle, random points)") {
+    std::mt19937 randGen(42);
+    std::uniform_real_distribution<double> coord(-2e12, 2e12);
+    auto edgeDistance = [](const Point &P, const Vertices &vertices) {
+        double result = INFINITY;
+        for (unsigned long i = 0; i + 1 < vertices.size(); ++i)
+            result = std::min(result, geom::distance(P, geom::Segment{vertices[i], vertices[i + 1]}));
+        return result;
+    };
+
+    for (unsigned long n : {1000ul, 10000ul}) {
+        const ConvexPolygon circle(bench::circle(n)), translated(bench::circle(n, 0.5, 2.5));
+        std::cout << " n = " << n << std::endl;
+
+        double expected = INFINITY, result = 0;
+        const double baseline = bench::time([&]{
+            for (const Point &P : translated.getVertices()) expected = std::min(expected, edgeDistance(P, circle.getVertices()));
+            for (const Point &P : circle.getVertices()) expected = std::min(expected, edgeDistance(P, translated.getVertices()));
+        }, 1);
+        bench::report("polygons, vertices to edges", baseline);
+        bench::report("polygons, GJK", bench::time([&]{ result = distance(circle, translated); }), baseline);
+        std::cout << "  (" << result/1e12 << (std::abs(result - expected) < 1e-9*expected ? "" : ", MISMATCH") << ")" << std::endl;
+
+        const unsigned long k = 10000;
+        Points points(k);
+        for (Point &P : points) P = {coord(randGen), coord(randGen)};
+        std::unique_ptr<double[]> distances(new double[k]);
+        const double pointsBaseline = bench::time([&]{
+            for (unsigned long i = 0; i < k; ++i)
+                distances[i] = isInside(points[i], circle) ? 0 : edgeDistance(points[i], circle.getVertices());
+        }, 1);
+        bench::report("10000 points, to every edge", pointsBaseline);
+        bench::report("10000 points, batch", bench::time([&]{
+            distance(points.data(), k, circle, distances.get());
+        }), pointsBaseline);
+    }
+}
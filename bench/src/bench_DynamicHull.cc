@@ -0,0 +1,54 @@
+#include "bench.h"
+
+#include <random>
+#include "class/ConvexPolygon.h"
+#include "class/DynamicHull.h"
+#include "class/SlidingWindowHull.h"
+
+
+// Hull of the last w points of a stream, queried after every new point
+BENCHMARK("DynamicHull: sliding window (random disk)") {
+    std::mt19937 randGen(42);
+    std::uniform_real_distribution<double> coord(-1, 1);
+
+    const unsigned long n = 20000, w = 4000;
+    Points points;
+    while (points.size() < n) {
+        Point P = {coord(randGen), coord(randGen)};
+        if (P.x*P.x + P.y*P.y <= 1) points.push_back(P);
+    }
+    std::cout << " n = " << n << ", window = " << w << std::endl;
+
+    unsigned long checksum[3] = {0, 0, 0};  // total number of vertices, so that nothing is optimized out
+    double rebuild = bench::time([&]{
+        checksum[0] = 0;
+        for (unsigned long i = w; i <= n; ++i)
+            checksum[0] += ConvexPolygon(Points(points.begin() + i - w, points.begin() + i)).vertexCount();
+    }, 1);
+    double dynamic = bench::time([&]{
+        checksum[1] = 0;
+        DynamicHull hull(Points(points.begin(), points.begin() + w));
+        for (unsigned long i = w; i <= n; ++i) {
+            checksum[1] += hull.polygon().vertexCount();
+            if (i == n) break;
+            hull.erase(points[i - w]);
+            hull.insert(points[i]);
+        }
+    });
+    double window = bench::time([&]{
+        checksum[2] = 0;
+        SlidingWindowHull hull;
+        for (unsigned long i = 0; i < w; ++i) hull.push(points[i]);
+        for (unsigned long i = w; i <= n; ++i) {
+            checksum[2] += hull.polygon().vertexCount();
+            if (i == n) break;
+            hull.pop();
+            hull.push(points[i]);
+        }
+    });
+
+    bench::report("rebuild", rebuild);
+    bench::report("DynamicHull", dynamic, rebuild);
+    bench::report("SlidingWindowHull", window, rebuild);
+    if (checksum[0] != checksum[1] or checksum[0] != checksum[2]) std::cout << "  MISMATCH" << std::endl;
+}
@@ -0,0 +1,110 @@
+#include "bench.h"
+
+#include <map>
+#include <random>
+#include <string>
+#include "class/PolygonMap.h"
+
+
+// A map with `n` small random polygons (of up to 8 vertices) spread over a square
+static PolygonMap _scatteredPolygons(unsigned long n, std::mt19937 &randGen) {
+    std::uniform_real_distribution<double> coord(0, 1000), offset(-0.5, 0.5);
+    std::uniform_int_distribution<int> size(3, 8);
+    PolygonMap polygons;
+    for (unsigned long i = 0; i < n; ++i) {
+        const Point center = {coord(randGen), coord(randGen)};
+        Points points(size(randGen));
+        for (Point &P : points) P = {center.x + offset(randGen), center.y + offset(randGen)};
+        polygons.assign("p" + std::to_string(i), ConvexPolygon(points));
+    }
+    return polygons;
+}
+
+
+// Stabbing and overlap queries through the R-tree vs scanning every polygon
+BENCHMARK("PolygonMap: spatial queries (random small polygons)") {
+    std::mt19937 randGen(42);
+    std::uniform_real_distribution<double> coord(0, 1000);
+    for (unsigned long n : {10000ul, 1000000ul}) {
+        PolygonMap polygons = _scatteredPolygons(n, randGen);
+        const std::vector<std::string> ids = polygons.ids();
+        std::vector<const ConvexPolygon *> all;  // (so that the scans don't look up IDs)
+        for (const std::string &id : ids) all.push_back(&static_cast<const PolygonMap &>(polygons).at(id));
+        std::cout << " n = " << n << std::endl;
+
+        const double build = bench::time([&]{ polygons.containing({0, 0}); }, 1);  // (bulk-loads the index)
+        bench::report("bulk-load the index", build);
+
+        const int queries = n > 100000 ? 10 : 100;
+        unsigned long scanned = 0, indexed = 0;
+        const double scan = bench::time([&]{
+            for (int q = 0; q < queries; ++q) {
+                const Point P = {coord(randGen), coord(randGen)};
+                for (const ConvexPolygon *pol : all) scanned += isInside(P, *pol);
+            }
+        }, 1);
+        bench::report(std::to_string(queries) + " points, scanning", scan);
+        bench::report(std::to_string(queries) + " points, containing", bench::time([&]{
+            for (int q = 0; q < queries; ++q) indexed += polygons.containing({coord(randGen), coord(randGen)}).size();
+        }), scan);
+
+        const ConvexPolygon probe({{500, 500}, {500, 503}, {503, 503}, {503, 500}});
+        const double scanOverlap = bench::time([&]{
+            for (const ConvexPolygon *pol : all) scanned += intersects(probe, *pol);
+        }, 1);
+        bench::report("1 polygon, scanning", scanOverlap);
+        bench::report("1 polygon, overlapping", bench::time([&]{ indexed += polygons.overlapping(probe).size(); }),
+                      scanOverlap);
+
+        // Interleaved updates and queries, which reindex the changed polygons one by one:
+        std::uniform_int_distribution<unsigned long> index(0, n - 1);
+        const double updates = bench::time([&]{
+            for (int q = 0; q < 1000; ++q) {
+                polygons.assign(ids[index(randGen)], probe);
+                indexed += polygons.containing({coord(randGen), coord(randGen)}).size();
+            }
+        }, 1);
+        bench::report("1000 x (assign + containing)", updates);
+        if (scanned == 0 or indexed == 0) std::cout << "  (no hits?)" << std::endl;
+    }
+}
+
+
+// Looking polygons up by ID: a std::map (what PolygonMap used to be) vs the hash table vs handles
+BENCHMARK("PolygonMap: ID lookups") {
+    std::mt19937 randGen(42);
+    for (unsigned long n : {1000ul, 1000000ul}) {
+        std::cout << " n = " << n << std::endl;
+        std::map<std::string, ConvexPolygon> tree;
+        PolygonMap polygons;
+        std::vector<std::string> ids;
+        for (unsigned long i = 0; i < n; ++i) {
+            ids.push_back("polygon-" + std::to_string(i));
+            polygons.assign(ids.back(), tree[ids.back()] = ConvexPolygon(Points{{double(i), 0}}));
+        }
+
+        // The same random sequence of IDs (as in a script), with the handles resolved beforehand:
+        const unsigned long lookups = 1000000;
+        std::uniform_int_distribution<unsigned long> index(0, n - 1);
+        std::vector<const std::string *> queries;
+        std::vector<PolygonMap::Handle> handles;
+        for (unsigned long i = 0; i < lookups; ++i) {
+            queries.push_back(&ids[index(randGen)]);
+            handles.push_back(polygons.find(*queries.back()));
+        }
+
+        const PolygonMap &view = polygons;
+        unsigned long total = 0;
+        const double map = bench::time([&]{
+            for (const std::string *id : queries) total += tree.find(*id)->second.vertexCount();
+        });
+        bench::report("1M lookups, std::map", map);
+        bench::report("1M lookups, PolygonMap", bench::time([&]{
+            for (const std::string *id : queries) total += view.at(*id).vertexCount();
+        }), map);
+        bench::report("1M lookups, by handle", bench::time([&]{
+            for (PolygonMap::Handle h : handles) total += view.get(h).vertexCount();
+        }), map);
+        if (total != 3*5*lookups) std::cout << "  MISMATCH" << std::endl;
+    }
+}
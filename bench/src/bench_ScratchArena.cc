@@ -0,0 +1,46 @@
+#include "bench.h"
+
+#include <random>
+#include "class/ConvexPolygon.h"
+#include "class/ScratchArena.h"
+
+
+// Heap allocations of the hull and intersection algorithms, once the arena of the thread
+// has grown to fit their temporaries (each repetition is a command, with a scope of its own)
+BENCHMARK("ScratchArena: allocations per operation (steady state)") {
+    std::mt19937 randGen(42);
+    std::uniform_real_distribution<double> coord(-1, 1);
+    const int reps = 1000;
+
+    Points cloud(10000);
+    for (Point &P : cloud) P = {coord(randGen), coord(randGen)};
+    const ConvexPolygon circle(bench::circle(1000)), translated(bench::circle(1000, 0, 0.7)),
+            small(bench::circle(8, 0, 1.1, 0.3));
+    std::vector<ConvexPolygon> many;
+    for (int i = 0; i < 100; ++i) many.push_back(ConvexPolygon(bench::circle(16, 0, 3*std::cos(i), 3*std::sin(i))));
+
+    auto measure = [&](const std::string &label, const std::function<void(int)> &run) {
+        { ScratchArena::Scope scope; run(-1); }  // (warm-up: grows the arena)
+        const unsigned long allocations = bench::allocations();
+        const double seconds = bench::time([&]{
+            for (int i = 0; i < reps; ++i) {
+                ScratchArena::Scope scope;
+                run(i);
+            }
+        }, 1);
+        std::cout << "  " << label << ": " << seconds*1e6/reps << " us, "
+                  << double(bench::allocations() - allocations)/reps << " allocations" << std::endl;
+    };
+
+    std::vector<Points> inputs(reps, cloud);  // (copied beforehand, as if parsed)
+    unsigned long vertices = 0;
+    measure("hull of 10000 random points", [&](int i) {
+        vertices += ConvexPolygon(i < 0 ? Points(cloud) : std::move(inputs[i])).vertexCount();
+    });
+    measure("intersection (circle, circle-transl)", [&](int) { vertices += intersection(circle, translated).vertexCount(); });
+    measure("union (circle, circle-transl)", [&](int) { vertices += convexUnion(circle, translated).vertexCount(); });
+    measure("union (circle, small polygon)", [&](int) { vertices += convexUnion(circle, small).vertexCount(); });
+    measure("union of 100 small polygons", [&](int) { vertices += convexUnion(many).vertexCount(); });
+    std::cout << "  (arena: " << ScratchArena::local().capacity() << " bytes)" << std::endl;
+    if (vertices == 0) std::cout << "  (unexpected result)" << std::endl;
+}
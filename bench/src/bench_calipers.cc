@@ -0,0 +1,74 @@
+#include "bench.h"
+
+#include <algorithm>
+#include <cmath>
+#include "calipers.h"
+#include "class/ConvexPolygon.h"
+
+
+// Rotated ellipse with `n` vertices (its bounding box isn't the minimum-area rectangle)
+static ConvexPolygon _ellipse(unsigned long n) {
+    Points points = bench::circle(n);
+    const double c = std::cos(0.3), s = std::sin(0.3);
+    for (Point &P : points) P = {c*P.x - s*0.4*P.y, s*P.x + c*0.4*P.y};
+    return ConvexPolygon(move(points));
+}
+
+
+// Rotating calipers vs. trying every pair of vertices / every edge against every vertex
+BENCHMARK("calipers: diameter, width and rectangle (ellipse)") {
+    for (unsigned long n : {1000ul, 10000ul}) {
+        const ConvexPolygon ellipse = _ellipse(n);
+        const Vertices &V = ellipse.getVertices();
+        std::cout << " n = " << n << std::endl;
+
+        double maxDist = 0;
+        const double pairs = bench::time([&]{
+            for (const Point &P : V)
+                for (const Point &Q : V) maxDist = std::max(maxDist, (Q - P).squaredNorm());
+        }, 1);
+        bench::report("diameter, every pair", pairs);
+        bench::report("diameter, calipers", bench::time([&]{ diameter(ellipse); }), pairs);
+
+        double minArea = INFINITY;
+        const double edges = bench::time([&]{
+            for (unsigned long i = 0; i + 1 < V.size(); ++i) {
+                const Vector2D edge = V[i + 1] - V[i];
+                double minAlong = INFINITY, maxAlong = -INFINITY, maxAcross = 0;
+                for (const Point &P : V) {
+                    minAlong = std::min(minAlong, geom::dotProd(P - V[i], edge));
+                    maxAlong = std::max(maxAlong, geom::dotProd(P - V[i], edge));
+                    maxAcross = std::max(maxAcross, geom::crossProd(P - V[i], edge));
+                }
+                minArea = std::min(minArea, (maxAlong - minAlong)*maxAcross/edge.squaredNorm());
+            }
+        }, 1);
+        bench::report("rectangle, every edge", edges);
+        bench::report("rectangle, calipers", bench::time([&]{ minAreaRectangle(ellipse); }), edges);
+    }
+}
+
+
+// The calipers on big polygons, compared to a single pass over the vertices (for the axis-aligned bounding box)
+BENCHMARK("calipers: 1M-vertex polygons (ellipse)") {
+    const ConvexPolygon ellipse = _ellipse(1000000);
+    std::cout << " n = " << ellipse.vertexCount() << std::endl;
+
+    Point SW, NE;
+    const double box = bench::time([&]{
+        SW = NE = ellipse.getVertices().front();
+        for (const Point &P : ellipse.getVertices()) {
+            SW = {std::min(SW.x, P.x), std::min(SW.y, P.y)};
+            NE = {std::max(NE.x, P.x), std::max(NE.y, P.y)};
+        }
+    });
+    bench::report("bounding box (one pass)", box);
+    geom::Segment d, w;
+    bench::report("diameter", bench::time([&]{ d = diameter(ellipse); }), box);
+    bench::report("width", bench::time([&]{ w = width(ellipse); }), box);
+    ConvexPolygon rectangle;
+    bench::report("min-area rectangle", bench::time([&]{ rectangle = minAreaRectangle(ellipse); }), box);
+    std::cout << "  (diameter " << distance(d.startPt, d.endPt)/1e12 << ", width " << distance(w.startPt, w.endPt)/1e12
+              << ", rectangle area " << rectangle.area()/1e24 << " vs bounding box "
+              << (NE.x - SW.x)*(NE.y - SW.y)/1e24 << ")" << std::endl;
+}
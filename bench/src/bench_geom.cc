@@ -0,0 +1,47 @@
+#include "bench.h"
+
+#include <random>
+#include "geom.h"
+#include "hull.h"
+
+
+// Batch orientation predicates at every supported instruction set vs one call per point
+BENCHMARK("geom: batch turns (random square, circle hull)") {
+    std::mt19937 randGen(42);
+    std::uniform_real_distribution<double> coord(-1, 1);
+
+    const unsigned long n = 1000000, block = 256;  // blocks small enough to stay in cache
+    Points points(n);
+    for (Point &P : points) P = {coord(randGen), coord(randGen)};
+    const Points circle = hull::monotoneChain(bench::circle(n));
+    std::cout << " n = " << n << ", blocks of " << block << std::endl;
+
+    bool result[block];
+    unsigned long checksum = 0;  // so that nothing is optimized out
+    double calls = bench::time([&]{
+        for (unsigned long i = 0; i + block <= n; i += block)
+            for (unsigned long j = 0; j < block; ++j) result[j] = geom::isClockwiseTurn(points[i], points[i + 1], points[i + j]);
+        checksum += result[0];
+    });
+    bench::report("isClockwiseTurn", calls);
+
+    const geom::simd::Level detected = geom::simd::detect();
+    for (auto level : {geom::simd::Level::scalar, geom::simd::Level::sse2,
+                       geom::simd::Level::avx2, geom::simd::Level::avx512}) {
+        if (level > detected) break;
+        geom::simd::level() = level;
+        double batch = bench::time([&]{
+            for (unsigned long i = 0; i + block <= n; i += block) geom::clockwiseTurns(points[i], points[i + 1], &points[i], block, result);
+            checksum += result[0];
+        });
+        bench::report(std::string("clockwiseTurns, ") + geom::simd::name(level), batch, calls);
+    }
+
+    geom::simd::level() = geom::simd::Level::scalar;
+    double scalarHull = bench::time([&]{ checksum += hull::isHull(circle); });
+    geom::simd::level() = detected;
+    double simdHull = bench::time([&]{ checksum += hull::isHull(circle); });
+    bench::report("isHull, scalar", scalarHull);
+    bench::report(std::string("isHull, ") + geom::simd::name(detected), simdHull, scalarHull);
+    if (checksum == 0) std::cout << "  (unexpected checksum)" << std::endl;
+}
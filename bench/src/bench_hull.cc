@@ -0,0 +1,109 @@
+#include "bench.h"
+
+#include <algorithm>
+#include <random>
+#include "hull.h"
+#include "class/ThreadPool.h"
+
+
+// Compares the monotone chain with the reference Graham scan on the circles of `test/generator.py`
+BENCHMARK("hull: monotone chain vs graham scan (circle)") {
+    std::mt19937 randGen(42);
+
+    for (unsigned long n : {100000ul, 1000000ul}) {
+        Points ordered = bench::circle(n), shuffled = ordered;
+        std::shuffle(shuffled.begin(), shuffled.end(), randGen);
+
+        for (const auto &workload : {std::make_pair("ordered", &ordered), std::make_pair("shuffled", &shuffled)}) {
+            std::cout << " n = " << n << ", " << workload.first << std::endl;
+            const Points &points = *workload.second;
+
+            double graham = bench::time([&]{ hull::grahamScan(points); });
+            double monotone = bench::time([&]{ hull::monotoneChain(points); });
+            bench::report("graham scan", graham);
+            bench::report("monotone chain", monotone, graham);
+        }
+    }
+}
+
+
+// Serial vs parallel monotone chain on the shared thread pool
+BENCHMARK("hull: parallel monotone chain (circle, random square)") {
+    std::mt19937 randGen(42);
+    std::uniform_real_distribution<double> coord(-1e6, 1e6);
+    std::cout << " threads = " << ThreadPool::shared().size() << std::endl;
+
+    Points square(4000000);
+    for (Point &P : square) P = {coord(randGen), coord(randGen)};
+    Points circle = bench::circle(1000000);
+    std::shuffle(circle.begin(), circle.end(), randGen);
+
+    for (const auto &workload : {std::make_pair("circle, n = 1M", &circle), std::make_pair("square, n = 4M", &square)}) {
+        std::cout << " " << workload.first << std::endl;
+        const Points &points = *workload.second;
+
+        double serial = bench::time([&]{ hull::monotoneChain(points); });
+        double parallel = bench::time([&]{ hull::parallelMonotoneChain(points); });
+        bench::report("serial", serial);
+        bench::report("parallel", parallel, serial);
+    }
+}
+
+
+// Effect of culling interior points before building the hull
+BENCHMARK("hull: Akl-Toussaint filter (random disk, random square)") {
+    std::mt19937 randGen(42);
+    std::uniform_real_distribution<double> coord(-1, 1);
+
+    Points square(1000000), disk;
+    for (Point &P : square) P = {coord(randGen), coord(randGen)};
+    for (const Point &P : square) if (P.x*P.x + P.y*P.y <= 1) disk.push_back(P);
+
+    for (const auto &workload : {std::make_pair("disk", &disk), std::make_pair("square", &square)}) {
+        const Points &points = *workload.second;
+        std::cout << " " << workload.first << ", n = " << points.size() << std::endl;
+
+        hull::filterStats().reset();
+        double unfiltered = bench::time([&]{ hull::monotoneChain(points); });
+        double filtered = bench::time([&]{
+            Points copy = points;
+            hull::aklToussaintFilter(copy);
+            hull::monotoneChain(move(copy));
+        });
+        bench::report("monotone chain", unfiltered);
+        bench::report("filter + monotone chain", filtered, unfiltered);
+
+        const hull::FilterStats &stats = hull::filterStats();
+        std::cout << "  discarded: " << 100.0*stats.discarded/stats.examined << "%" << std::endl;
+    }
+}
+
+
+// Output-sensitive hull on inputs with few hull vertices, with and without culling interior points first
+BENCHMARK("hull: chan vs monotone chain (random disk, random square)") {
+    std::mt19937 randGen(42);
+    std::uniform_real_distribution<double> coord(-1, 1);
+
+    Points square(4000000), disk;
+    for (Point &P : square) P = {coord(randGen), coord(randGen)};
+    for (const Point &P : square) if (P.x*P.x + P.y*P.y <= 1) disk.push_back(P);
+
+    for (const auto &workload : {std::make_pair("disk", &disk), std::make_pair("square", &square)}) {
+        const Points &points = *workload.second;
+        std::cout << " " << workload.first << ", n = " << points.size()
+                  << ", h = " << hull::monotoneChain(points).size() - 1 << std::endl;
+
+        double monotone = bench::time([&]{ hull::monotoneChain(points); });
+        double chan = bench::time([&]{ hull::chan(points); });
+        bench::report("monotone chain", monotone);
+        bench::report("chan", chan, monotone);
+
+        Points filtered = points;
+        hull::aklToussaintFilter(filtered);
+        std::cout << " " << workload.first << ", after Akl-Toussaint filter, n = " << filtered.size() << std::endl;
+        double filteredMonotone = bench::time([&]{ hull::monotoneChain(filtered); });
+        double filteredChan = bench::time([&]{ hull::chan(filtered); });
+        bench::report("monotone chain", filteredMonotone);
+        bench::report("chan", filteredChan, filteredMonotone);
+    }
+}
@@ -0,0 +1,37 @@
+// Main entry point for the benchmark executable. Runs every registered
+// benchmark whose name contains the (optional) first command-line argument.
+
+#include <atomic>
+#include <cstdlib>  // std::malloc, std::free
+#include <iostream>
+#include <new>  // std::bad_alloc
+#include "bench.h"
+
+
+// Count every heap allocation (see bench::allocations()):
+static std::atomic<unsigned long> _allocations{0};
+
+void *operator new(std::size_t size) {
+    _allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+unsigned long bench::allocations() { return _allocations.load(std::memory_order_relaxed); }
+
+
+
+int main(int argc, char *argv[]) {
+    const std::string filter = argc > 1 ? argv[1] : "";
+
+    for (const bench::Benchmark &benchmark : bench::registry()) {
+        if (benchmark.name.find(filter) == std::string::npos) continue;
+        std::cout << benchmark.name << std::endl;
+        benchmark.run();
+        std::cout << std::endl;
+    }
+}
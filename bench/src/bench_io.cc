@@ -0,0 +1,32 @@
+#include "bench.h"
+
+#include <cstdio>  // std::remove
+#include <fstream>
+#include <sstream>
+#include "io-commands.h"
+
+
+// Reloading a saved polygon: recomputing its hull (as `polygon` does) vs loading it as-is
+BENCHMARK("io: load (circle)") {
+    const std::string file = "bench-load.txt";
+    for (unsigned long n : {100000ul, 1000000ul}) {
+        std::cout << " n = " << n << std::endl;
+
+        PolygonMap polygons;
+        polygons.assign("p", ConvexPolygon(bench::circle(n)));
+        save(file, {"p"}, polygons);
+
+        double hull = bench::time([&]{
+            std::ifstream fileStream(file);
+            std::string line;
+            while (getline(fileStream, line)) {
+                std::istringstream argStream(line);
+                readPolygon(argStream, polygons);
+            }
+        });
+        double trusted = bench::time([&]{ load(file, polygons); });
+        bench::report("parse + hull", hull);
+        bench::report("load", trusted, hull);
+    }
+    std::remove(file.c_str());
+}
@@ -0,0 +1,74 @@
+/// @file
+/// Rotating calipers on convex polygons.
+
+#ifndef CONVEXPOLYGONS_CALIPERS_H
+#define CONVEXPOLYGONS_CALIPERS_H
+
+#include "class/Point.h"
+#include "geom.h"
+
+
+/**
+ * Namespace for the rotating calipers algorithms. They take the vertices of a convex
+ * polygon in the format of the hull namespace (clockwise, starting with the lowest one in
+ * the geom::comp::xCoord order, with the first vertex repeated at the end). Each edge
+ * in turn is laid against a caliper, and the vertices that are extreme with respect to
+ * it (farthest from it, or farthest along it in either direction) are tracked as the
+ * edges rotate: since they only move forward, the whole sweep takes linear time.
+ */
+namespace calipers {
+
+    /**
+     * Diameter of a convex polygon: its farthest pair of vertices, found among the
+     * pairs of antipodal vertices (those that lie on two parallel supporting lines).
+     *
+     * @param vertices  the polygon's vertices (there are `n + 1` of them, the first one is
+     * repeated at the end)
+     * @param n  number of vertices in the polygon
+     * @return  a segment between two vertices at the maximum distance from each other
+     * (a single point if `n == 1`)
+     *
+     * @pre `n > 0`
+     * @throws error::ValueError if the polygon is empty
+     * @complexity linear in the number of vertices
+     */
+    geom::Segment diameter(const Point *vertices, unsigned long n);
+
+    /**
+     * Width of a convex polygon: the minimum distance between two parallel supporting
+     * lines, one of which always contains an edge.
+     *
+     * @param vertices  the polygon's vertices (there are `n + 1` of them, the first one is
+     * repeated at the end)
+     * @param n  number of vertices in the polygon
+     * @return  a segment from a vertex to its orthogonal projection onto the line of the
+     * opposite edge, whose length is the width (a single point if `n < 3`)
+     *
+     * @pre `n > 0`
+     * @throws error::ValueError if the polygon is empty
+     * @complexity linear in the number of vertices
+     */
+    geom::Segment width(const Point *vertices, unsigned long n);
+
+    /**
+     * Minimum-area bounding rectangle of a convex polygon (in any orientation). One of its
+     * sides always contains an edge of the polygon, so each edge is tried in turn, along
+     * with the vertices that are extreme in the edge's direction, in the opposite one,
+     * and perpendicularly to it.
+     *
+     * @param vertices  the polygon's vertices (there are `n + 1` of them, the first one is
+     * repeated at the end)
+     * @param n  number of vertices in the polygon
+     * @return  the corners of the rectangle, in the format of the hull namespace (the
+     * polygon itself if `n < 3`)
+     *
+     * @pre `n > 0`
+     * @throws error::ValueError if the polygon is empty
+     * @complexity linear in the number of vertices
+     */
+    Points minAreaRectangle(const Point *vertices, unsigned long n);
+
+}
+
+
+#endif //CONVEXPOLYGONS_CALIPERS_H
@@ -0,0 +1,109 @@
+/// @file
+/// Compact (quantized) storage for convex polygons.
+
+#ifndef CONVEXPOLYGONS_COMPACTPOLYGON_H
+#define CONVEXPOLYGONS_COMPACTPOLYGON_H
+
+#include <cstddef>  // std::size_t
+#include <cstdint>  // std::int32_t, std::uint32_t
+#include <vector>
+#include "class/ConvexPolygon.h"
+
+
+//-------- COMPACT POLYGON CLASS --------//
+
+/**
+ * Read-only, compact copy of a ConvexPolygon, for sessions with a huge number of vertices:
+ * each vertex is stored as a pair of 32-bit fixed-point offsets from the center of the
+ * polygon's bounding box (8 bytes instead of 16), and the color is packed in 24 bits
+ * (see RGBColor::pack()). The vertices are decoded on the fly by the queries (area(),
+ * perimeter(), boundingBox() and contains()), so the polygon needn't be decoded first.
+ *
+ * The offsets are multiples of step(), whose coordinates are the width and height of the
+ * bounding box divided by \f$ 2^{32} - 2 \f$, so each decoded coordinate is within half
+ * a step (about \f$ 1.2 \cdot 10^{-10} \f$ times the width or the height of the polygon)
+ * of the original one, plus the rounding error of the decoding itself (which is all there
+ * is for the sides of the bounding box). In particular, the decoded vertices of polygons bigger
+ * than numeric::EPSILON times \f$ 2^{33} \f$ (about 0.0086) generally differ from the
+ * original ones by more than numeric::EPSILON, so they aren't equal to them (in the
+ * sense of `operator==`).
+ */
+class CompactPolygon {
+public:
+    /// Fixed-point offset of a vertex from the origin, in units of step()
+    struct Offset {
+        std::int32_t x, y;
+    };
+
+    CompactPolygon() = default;
+
+    /**
+     * Encodes a polygon.
+     * @param pol  polygon to encode
+     * @complexity linear in the number of vertices of `pol`
+     */
+    explicit
+    CompactPolygon(const ConvexPolygon &pol);
+
+    /**
+     * Decodes the polygon. Its vertices are the decoded vertices (see vertex()), unless
+     * rounding them broke their convexity (e.g. for almost collinear vertices), in which
+     * case they are replaced by their convex hull (see ConvexPolygon::fromHull()).
+     *
+     * @return  a polygon equal to the encoded one, up to the error described in CompactPolygon
+     * @complexity linear in the number of vertices
+     */
+    ConvexPolygon decode() const;
+
+    /// @return the number of vertices (as ConvexPolygon::vertexCount())
+    unsigned long vertexCount() const { return offsets.size(); }
+
+    /// @return whether the polygon has no vertices
+    bool empty() const { return offsets.empty(); }
+
+    /**
+     * Decodes a single vertex.
+     * @param i  index of the vertex, in the order of ConvexPolygon::getVertices()
+     * @return  the decoded vertex
+     * @pre `i < vertexCount()`
+     */
+    Point vertex(unsigned long i) const {
+        return {origin.x + offsets[i].x*_step.x, origin.y + offsets[i].y*_step.y};
+    }
+
+    /// @return the quantization step in each axis, i.e. the distance between consecutive representable coordinates
+    const Vector2D &step() const { return _step; }
+
+    /// @return the color of the polygon, rounded to 8 bits per value
+    RGBColor getColor() const { return RGBColor::unpack(color); }
+
+    /**
+     * Sets the color of the polygon (rounded to 8 bits per value, see RGBColor::pack()).
+     * @param col  new color
+     */
+    void setColor(const RGBColor &col) { color = col.pack(); }
+
+    //! @name Queries
+    //! As the ones of ConvexPolygon (and isInside(const Point &, const ConvexPolygon &)), for
+    //! the decoded vertices, but without memoization: each query is linear in the number of
+    //! vertices (logarithmic for contains()).
+    ///@{
+    double area() const;
+    double perimeter() const;
+    Box boundingBox() const;  ///< @throws error::ValueError if the polygon is empty
+    bool contains(const Point &P) const;
+    ///@}
+
+    /// @return the number of bytes taken by the polygon (including its heap storage)
+    std::size_t memoryUsage() const { return sizeof(CompactPolygon) + offsets.capacity()*sizeof(Offset); }
+
+
+private:
+    Point origin = {0, 0};  // center of the bounding box
+    Vector2D _step = {0, 0};  // (0 in an axis if all of the vertices have the same coordinate)
+    std::vector<Offset> offsets;  // without repeating the first vertex at the end
+    std::uint32_t color = RGBColor().pack();
+};
+
+
+#endif //CONVEXPOLYGONS_COMPACTPOLYGON_H
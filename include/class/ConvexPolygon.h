@@ -7,24 +7,53 @@
 #define CONVEXPOLYGONS_CONVEXPOLYGONS_H
 
 #include <vector>
+#include <memory>
 #include "class/Point.h"
 #include "class/RGBColor.h"
 #include "class/Box.h"
+#include "geom.h"
 #include "details/range.h"
+#include "details/aligned.h"
+#include "details/small_vector.h"
 
 
-//-------- TYPEDEFS --------//
-
-/// Alias for a vector of points
-typedef std::vector<Point> Points;
+//-------- CONVEX POLYGON CLASS --------//
 
+/**
+ * Storage for a polygon's vertices. Up to 5 points (that is, up to quadrilaterals,
+ * since the first vertex is repeated at the end) are stored inline, so the many
+ * triangles and boxes don't need a heap allocation; bigger polygons keep their vertices
+ * on the heap, as a `std::vector` (moved in from the hull algorithms without copying),
+ * in a buffer shared between copies of the polygon (see ConvexPolygon).
+ */
+typedef SmallVector<Point, 5> Vertices;
 
 
+/**
+ * Copy of a polygon's vertices as a structure of arrays: one array with the `x`
+ * coordinates and one with the `y` coordinates, aligned to a cache line, in the same
+ * order as ConvexPolygon::getVertices() (with the first vertex repeated at the end).
+ * This is the layout used by the vectorized metrics (see geom::shoelaceSum() etc.).
+ */
+struct VertexArrays {
+    AlignedVector<double> x;  ///< `x` coordinates of the vertices
+    AlignedVector<double> y;  ///< `y` coordinates of the vertices
+};
 
-//-------- CONVEX POLYGON CLASS --------//
 
 /**
  * Interface for planar convex polygons. Can be constructed from a sequence of points.
+ *
+ * The derived properties (area(), perimeter(), centroid(), boundingBox() and
+ * getVertexArrays()) are memoized: each is computed the first time it's queried and
+ * kept until the polygon is modified. Copies share the memoized values. Const member
+ * functions are safe to call concurrently (each value is computed only once).
+ *
+ * Copies also share the vertices of big polygons (those that aren't stored inline, see
+ * Vertices): they're kept in a reference-counted buffer, which is only copied when one of
+ * the polygons that share it is modified (copy-on-write). So copying a polygon (e.g.
+ * assigning it to another ID, or keeping a snapshot of a whole PolygonMap) takes constant
+ * time, whatever its size.
  */
 class ConvexPolygon {
 public:
@@ -39,17 +68,46 @@ public:
      * to the convex hull of `points`, starting with the one with lowest `x`
      * coordinate (and lowest `y` coordinate in case of equality), ordered clockwise.
      *
-     * @complexity quasilinear in the size of `points`, \f$ O(n\log(n)) \f$
+     * @complexity quasilinear in the size of `points`, \f$ O(n\log(n)) \f$. Large inputs
+     * (see hull::Config::parallelThreshold) are processed in parallel. Inputs with
+     * few hull vertices can be processed in \f$ O(n\log(h)) \f$ with Chan's algorithm
+     * (see hull::Config::algorithm).
      */
     ConvexPolygon(const Points &points);
     ConvexPolygon(Points &&points);  ///< rvalue reference overload of ConvexPolygon(const Points &)
 
+    /**
+     * Constructs a convex polygon from the vertices of a convex hull, in the same format
+     * as they are printed (e.g. by the `save` command): clockwise, starting with the one with
+     * lowest `x` coordinate (and lowest `y` coordinate in case of equality), without repeating
+     * the first vertex at the end. The sequence is checked (see hull::isHull()) and used as-is,
+     * without computing its hull; if the check fails, this is the same as ConvexPolygon(Points &&).
+     *
+     * @param vertices  vertices of the polygon
+     * @param trusted  whether to skip the check and use `vertices` as-is unconditionally
+     * @return  the polygon with the given vertices
+     *
+     * @pre if `trusted` is `true`, `vertices` are the vertices of a convex hull in the
+     * format described above
+     *
+     * @complexity linear in the number of vertices, unless the check fails; constant if
+     * `trusted` and `vertices` has spare capacity for one more point (the first vertex is
+     * repeated at the end, which would otherwise reallocate and copy the vector)
+     */
+    static
+    ConvexPolygon fromHull(Points vertices, bool trusted = false);
+
     /**
      * Implicit conversion from a Box.
      * @param box  the box to be interpreted as a convex polygon
      */
     ConvexPolygon(const Box &box);
 
+    ConvexPolygon(const ConvexPolygon &other);
+    ConvexPolygon(ConvexPolygon &&other) = default;
+    ConvexPolygon &operator=(const ConvexPolygon &other);
+    ConvexPolygon &operator=(ConvexPolygon &&other) = default;
+
 
 
     /**
@@ -64,26 +122,29 @@ public:
      * @return whether the polygon is a empty
      * @complexity constant
      */
-    bool empty() const { return vertices.empty(); }
+    bool empty() const { return getVertices().empty(); }
 
     /**
      * Calculates the area of the polygon. If the polygon is empty, returns 0.
      * @return area of the polygon
-     * @complexity linear in the number of vertices
+     * @complexity linear in the number of vertices (vectorized, over getVertexArrays())
+     * the first time, constant afterwards (memoized)
      */
     double area() const;
 
     /**
      * Calculates the perimeter of the polygon. If the polygon is empty, returns 0.
      * @return perimeter of the polygon
-     * @complexity linear in the number of vertices
+     * @complexity linear in the number of vertices (vectorized, over getVertexArrays())
+     * the first time, constant afterwards (memoized)
      */
     double perimeter() const;
 
     /**
      * Calculates the centroid (equibarycenter) of the polygon.
      * @return centroid of the polygon
-     * @complexity  linear in the number of vertices
+     * @complexity  linear in the number of vertices (vectorized, over getVertexArrays())
+     * the first time, constant afterwards (memoized)
      *
      * @pre the polygon is not empty
      *
@@ -106,7 +167,8 @@ public:
      * Moreover, \f$ SW = (\min_{p\in P} p_x, \min_{p\in P} p_y) \f$ and
      * \f$ NE = (\max_{p\in P} p_x, \max_{p\in P} p_y) \f$ where \f$ P \f$ is the set of vertices.
      *
-     * @complexity  linear in the number of vertices
+     * @complexity  linear in the number of vertices (vectorized, over getVertexArrays())
+     * the first time, constant afterwards (memoized)
      *
      * @throws error::ValueError if the polygon is empty.
      */
@@ -122,24 +184,96 @@ public:
      * to facilitate the use and implementation of algorithms involving,
      * for example, a loop in the edges of the polygon.
      *
-     * @return a const-reference to the internal vertex vector.
+     * @return a const-reference to the internal vertex container (see Vertices), valid
+     * until the polygon is modified
      */
-    const Points &getVertices() const { return vertices; }
+    const Vertices &getVertices() const { return shared ? *shared : vertices; }
+
+    /**
+     * Getter for a structure-of-arrays copy of the polygon's vertices (see VertexArrays).
+     * The copy is built the first time it's needed (by this getter or by the metrics, which
+     * use it), and kept until the polygon is modified. Safe to call from several threads.
+     *
+     * @return a const-reference to the vertex arrays, valid until the polygon is modified
+     * @complexity linear in the number of vertices the first time, constant afterwards
+     */
+    const VertexArrays &getVertexArrays() const;
 
     const RGBColor &getColor() const { return color; }
 
     ///@}
 
+    /// Counters of queries to the memoized metrics (area(), perimeter(), centroid() and boundingBox())
+    struct CacheStats {
+        unsigned long hits;  ///< queries answered with the memoized value
+        unsigned long misses;  ///< queries that had to compute the value
+    };
+
+    /**
+     * Instrumentation: number of cache hits and misses of the memoized metrics, over
+     * every polygon, since the start of the program (or the last resetCacheStats()).
+     * @return  the current counters
+     */
+    static
+    CacheStats cacheStats();
+
+    /// Resets the counters returned by cacheStats() to zero
+    static
+    void resetCacheStats();
+
+    /// Counters of the shared vertex buffers of big polygons (see ConvexPolygon)
+    struct StorageStats {
+        unsigned long buffers;  ///< buffers allocated for new vertices
+        unsigned long shares;  ///< copies of polygons that shared a buffer instead of copying it
+        unsigned long copies;  ///< buffers copied because a polygon that shared them was modified
+    };
+
+    /**
+     * Instrumentation: number of vertex buffers allocated, shared and copied, over every
+     * polygon, since the start of the program (or the last resetStorageStats()).
+     * @return  the current counters
+     */
+    static
+    StorageStats storageStats();
+
+    /// Resets the counters returned by storageStats() to zero
+    static
+    void resetStorageStats();
+
     /**
      * Sets the color of the polygon to the specified value.
      * @param col  new color
      */
     void setColor(const RGBColor &col) { color = col; }
 
+    /**
+     * Extends the polygon to the convex hull of its vertices and a new point. The tangents
+     * from the point to the polygon are found with a binary search (see hull::tangent()),
+     * and the point is spliced into the vertex array in place of the vertices between
+     * them, keeping the format described in getVertices().
+     *
+     * @param P  point to be inserted
+     * @return  whether `P` became a vertex of the polygon (i.e., whether it was outside of it)
+     *
+     * @complexity linear in the number of vertices in the worst case: logarithmic to locate `P`
+     * and find the tangents, plus the number of removed vertices, plus shifting the vertices
+     * after the splice point (or rotating the whole array if `P` becomes the first vertex, or
+     * copying it if the vertices are shared with a copy of the polygon)
+     */
+    bool insert(const Point &P);
+
 
 private:
-    Points vertices;
+    Vertices vertices;  // inline vertices (empty if they're in `shared`)
+    std::shared_ptr<Vertices> shared;  // vertices on the heap, shared between copies (never modified if shared)
     RGBColor color;
+    struct Cache;  // memoized derived properties
+    mutable std::shared_ptr<Cache> cache;  // created on demand, and dropped on modification
+
+    Cache &getCache() const;
+
+    Vertices takeVertices();
+    void setVertices(Vertices &&newVertices);
 
     static
     Points ConvexHull(Points points);
@@ -178,23 +312,137 @@ Box boundingBox(ConstRange<ConvexPolygon> polygons);
  */
 bool isInside(const Point &P, const ConvexPolygon &pol);
 
+/**
+ * Batch version of isInside(const Point &, const ConvexPolygon &), for many points.
+ *
+ * The points are located by vectorized binary searches (see geom::insideConvexPolygon()).
+ * If there are at least as many points as vertices, and they're sorted clockwise by
+ * angle around the centroid of `pol` (starting at any angle, and going around at most
+ * once), they're classified by sweeping the polygon instead, in linear time; unsorted
+ * points fall back to the binary searches. Either way, each point gets the same result as
+ * with isInside(const Point &, const ConvexPolygon &), whatever the other points are (points
+ * near the boundary are located one by one, even in the sweep).
+ *
+ * @param points  array of points
+ * @param k  number of points in `points`
+ * @param pol  the polygon under consideration
+ * @param[out] result  array of `k` booleans: `result[i]` is whether `points[i]` is inside `pol`
+ *
+ * @complexity \f$ O(k\log(n)) \f$, where `n` is the number of vertices of `pol`;
+ * \f$ O(k + n) \f$ if the points are sorted by angle
+ */
+void isInside(const Point *points, unsigned long k, const ConvexPolygon &pol, bool *result);
+
 /**
  * Determines whether a polygon is inside another polygon.
  * @param pol1  polygon whose position (inside/outside) is to be determined
  * @param pol2  the polygon under consideration
  * @return  whether `pol1` is inside `pol2`
  *
- * @complexity  \f$ O(m\log(n)) \f$, where `m` and `n` are the number of
- * vertices in `pol1` and `pol2`, respectively
+ * Their bounding boxes are compared first, and then both boundaries are walked at the
+ * same time (see hull::contains(const Point *, unsigned long, const Point *, unsigned long)).
+ *
+ * @complexity  \f$ O(n + m) \f$, where `m` and `n` are the number of vertices in `pol1`
+ * and `pol2`, respectively; \f$ O(m\log(n)) \f$ if `pol1` is much smaller than `pol2`
  */
 bool isInside(const ConvexPolygon &pol1, const ConvexPolygon &pol2);
 
 
 /**
- * Calculates the convex union of two polygons.
+ * Determines whether two polygons intersect (or touch each other), without
+ * constructing their intersection (see hull::intersects()).
+ * @param pol1,pol2  the polygons under consideration
+ * @return  whether `pol1` and `pol2` have any point in common (always `false`
+ * if either of them is empty)
+ *
+ * @complexity logarithmic in the number of vertices of each polygon times the number
+ * of iterations of the GJK algorithm (usually small); allocates no memory
+ */
+bool intersects(const ConvexPolygon &pol1, const ConvexPolygon &pol2);
+
+
+/**
+ * Distance from a point to a polygon (see hull::distance(const Point &, const Point *, unsigned long)).
+ * @param P  the point under consideration
+ * @param pol  the polygon under consideration
+ * @return  the distance from `P` to the closest point of `pol` (0 if `P` is inside)
+ *
+ * @pre `pol` isn't empty
+ * @throws error::ValueError if `pol` is empty
+ * @complexity logarithmic in the number of vertices of `pol`
+ */
+double distance(const Point &P, const ConvexPolygon &pol);
+
+/**
+ * Batch version of distance(const Point &, const ConvexPolygon &), for many points. The
+ * points inside `pol` are found first, as in isInside(const Point *, unsigned long,
+ * const ConvexPolygon &, bool *), and only the ones outside are searched for their closest edge.
+ *
+ * @param points  array of points
+ * @param k  number of points in `points`
+ * @param pol  the polygon under consideration
+ * @param[out] result  array of `k` distances: `result[i]` is the distance from `points[i]` to `pol`
+ *
+ * @pre `pol` isn't empty
+ * @throws error::ValueError if `pol` is empty
+ * @complexity \f$ O(k\log(n)) \f$, where `n` is the number of vertices of `pol`
+ */
+void distance(const Point *points, unsigned long k, const ConvexPolygon &pol, double *result);
+
+/**
+ * Distance between two polygons (see hull::distance(const Point *, unsigned long, const Point *, unsigned long)).
+ * @param pol1,pol2  the polygons under consideration
+ * @return  the distance between the closest points of `pol1` and `pol2` (0 if they intersect)
+ *
+ * @pre neither polygon is empty
+ * @throws error::ValueError if either polygon is empty
+ * @complexity logarithmic in the number of vertices of each polygon times the number
+ * of iterations of the GJK algorithm (usually small)
+ */
+double distance(const ConvexPolygon &pol1, const ConvexPolygon &pol2);
+
+
+/**
+ * Diameter of a polygon (see calipers::diameter()).
+ * @param pol  the polygon under consideration
+ * @return  a segment between two vertices of `pol` at the maximum distance from each other
+ *
+ * @pre `pol` isn't empty
+ * @throws error::ValueError if `pol` is empty
+ * @complexity linear in the number of vertices
+ */
+geom::Segment diameter(const ConvexPolygon &pol);
+
+/**
+ * Width of a polygon, i.e. its minimum extent in any direction (see calipers::width()).
+ * @param pol  the polygon under consideration
+ * @return  a segment across `pol` whose length is its width, perpendicular to an edge
+ *
+ * @pre `pol` isn't empty
+ * @throws error::ValueError if `pol` is empty
+ * @complexity linear in the number of vertices
+ */
+geom::Segment width(const ConvexPolygon &pol);
+
+/**
+ * Minimum-area bounding rectangle of a polygon, in any orientation (see calipers::minAreaRectangle()).
+ * @param pol  the polygon under consideration
+ * @return  the rectangle (or `pol` itself, if it has less than three vertices)
+ *
+ * @pre `pol` isn't empty
+ * @throws error::ValueError if `pol` is empty
+ * @complexity linear in the number of vertices
+ */
+ConvexPolygon minAreaRectangle(const ConvexPolygon &pol);
+
+
+/**
+ * Calculates the convex union of two polygons, by merging their vertex chains (see hull::merge()).
  * @return the convex union of the first and second argument
  *
- * @complexity quasilinear in the total number of vertices
+ * @complexity linear in the total number of vertices -- \f$ O(n + m) \f$ -- or
+ * \f$ O(m\log(n) + m\log(m)) \f$ plus copying the result if the second polygon has far fewer
+ * vertices than the first (or vice versa)
  */
 ConvexPolygon convexUnion(const ConvexPolygon &, const ConvexPolygon &);
 
@@ -203,17 +451,55 @@ ConvexPolygon operator|(const ConvexPolygon &polA, const ConvexPolygon &polB);
 
 
 /**
- * Calculates the intersection of two polygons.
+ * Calculates the intersection of two polygons, by walking both boundaries at the same
+ * time (O'Rourke et al.'s algorithm), which yields the vertices of the result in order.
  * @return the intersection of the first and second argument
  *
- * @complexity quasilinear in the total number of vertices
- * -- \f$ O((n + m) \cdot \log(n + m)) \f$
+ * @complexity linear in the total number of vertices -- \f$ O(n + m) \f$ -- if the
+ * boundaries cross, or if one of the polygons contains the other, up to
+ * \f$ O(n\log(m) + m\log(n)) \f$ otherwise (e.g. if they only touch each other)
  */
 ConvexPolygon intersection(const ConvexPolygon &, const ConvexPolygon &);
 
 //! Just syntactic sugar for intersection(const ConvexPolygon &, const ConvexPolygon &)
 ConvexPolygon operator&(const ConvexPolygon &, const ConvexPolygon &);
 
+
+/**
+ * Calculates the Minkowski sum of two polygons (see hull::minkowskiSum()): the polygon
+ * swept by one of them when translated along every point of the other (or vice versa).
+ * @return the Minkowski sum of the first and second argument (empty if either is empty)
+ *
+ * @complexity linear in the total number of vertices
+ */
+ConvexPolygon minkowskiSum(const ConvexPolygon &, const ConvexPolygon &);
+
+
+/**
+ * Convex union of a set of polygons. They're combined pairwise as a balanced tree (so that
+ * the operands of each step have similar sizes), and big subtrees are reduced in parallel
+ * in ThreadPool::shared().
+ * @param polygons  any forward-traversal range of polygons
+ * @return  the convex union of all of `polygons` (the empty polygon if there are none)
+ *
+ * @complexity quasilinear in the total number of vertices
+ */
+ConvexPolygon convexUnion(ConstRange<ConvexPolygon> polygons);
+
+/**
+ * Intersection of a set of polygons, reduced as in convexUnion(ConstRange<ConvexPolygon>).
+ * The reduction stops as soon as any partial result is empty.
+ * @param polygons  any forward-traversal range of polygons
+ * @return  the intersection of all of `polygons`
+ *
+ * @pre  `polygons` isn't empty
+ * @throws error::ValueError if `polygons` is empty
+ * @complexity linear in the total number of vertices times the depth of the tree (logarithmic
+ * in the number of polygons), unless some boundaries only touch each other (see
+ * intersection(const ConvexPolygon &, const ConvexPolygon &))
+ */
+ConvexPolygon intersection(ConstRange<ConvexPolygon> polygons);
+
 ///@}
 
 
@@ -0,0 +1,108 @@
+/// @file
+/// Fully dynamic convex hull of a set of points.
+
+#ifndef CONVEXPOLYGONS_DYNAMICHULL_H
+#define CONVEXPOLYGONS_DYNAMICHULL_H
+
+#include <vector>
+#include "class/Point.h"
+#include "class/ConvexPolygon.h"
+
+
+//-------- DYNAMIC HULL CLASS --------//
+
+/**
+ * Convex hull of a multiset of points that supports both insertions and deletions.
+ * Unlike ConvexPolygon, which only stores the vertices of the hull, this keeps every
+ * point, so that a vertex can be removed and the points behind it resurface.
+ *
+ * The points are kept in the leaves of a weight-balanced binary tree, sorted by
+ * geom::comp::xCoord. Every internal node stores the bridges (the upper and lower common
+ * tangents) between the hulls of its two subtrees, in the spirit of Overmars and van
+ * Leeuwen's structure. The hulls of the subtrees are never stored explicitly: a bridge is
+ * found by descending both subtrees, guided by the bridges of their nodes. Unbalanced
+ * subtrees are rebuilt from scratch (scapegoat style).
+ *
+ * For FIFO windows of points, see SlidingWindowHull, which is faster.
+ */
+class DynamicHull {
+public:
+    DynamicHull() = default;
+
+    /**
+     * Builds the structure for a set of points at once.
+     * @param points  initial points (duplicates are allowed)
+     * @complexity \f$ O(n\log^2(n)) \f$
+     */
+    explicit
+    DynamicHull(Points points);
+
+
+    /**
+     * Adds a point.
+     * @param P  point to be added (it may already be in the set)
+     * @complexity \f$ O(\log^3(n)) \f$ amortized
+     */
+    void insert(const Point &P);
+
+    /**
+     * Removes (one copy of) a point.
+     * @param P  point to be removed
+     * @return  whether the point was found (compared exactly)
+     * @complexity \f$ O(\log^3(n)) \f$ amortized
+     */
+    bool erase(const Point &P);
+
+    /// @return the number of points, counting duplicates
+    unsigned long size() const { return pointCount; }
+
+    /// @return whether there are no points
+    bool empty() const { return pointCount == 0; }
+
+    /**
+     * Snapshot of the current convex hull.
+     * @return  the convex hull of the points, as a ConvexPolygon: a valid hull (see
+     * hull::isHull()), the same as `ConvexPolygon(points)` (where `points` are the points
+     * currently in the set) except where some of them are within numeric::EPSILON of being
+     * collinear, since the tree is updated with the same tolerant turn tests one point at a time
+     * @complexity \f$ O(h\log(n)) \f$, where \f$ h \f$ is the number of hull vertices
+     */
+    ConvexPolygon polygon() const;
+
+
+private:
+    static constexpr unsigned long NIL = -1ul;
+
+    struct Bridge { Point left, right; };  // common tangent between the hulls of two subtrees
+
+    struct Node {
+        Point point;  // leaves: the point; internal nodes: the largest point in the left subtree
+        unsigned long left = NIL, right = NIL;  // children (none, for leaves)
+        unsigned long size = 1;  // number of leaves in the subtree
+        unsigned long count = 1;  // leaves: number of copies of the point
+        Bridge upper, lower;  // internal nodes: bridges between the children's upper/lower hulls
+    };
+
+    std::vector<Node> nodes;  // node pool
+    std::vector<unsigned long> freeNodes;  // unused slots in the pool
+    unsigned long root = NIL;
+    unsigned long pointCount = 0;
+
+    bool isLeaf(unsigned long v) const { return nodes[v].left == NIL; }
+    unsigned long newNode(const Node &node);
+
+    const Point &tangentFrom(const Point &A, unsigned long v, bool lower) const;
+    Bridge bridge(unsigned long left, unsigned long right, bool lower) const;
+    bool isInterior(const Point &P, unsigned long v, bool lower) const;
+    void update(unsigned long v);
+    void updatePath(const std::vector<unsigned long> &path, const Point &P);
+
+    unsigned long build(const std::vector<unsigned long> &leaves, unsigned long first, unsigned long last);
+    void collectLeaves(unsigned long v, std::vector<unsigned long> &leaves);
+    void rebalance(const std::vector<unsigned long> &path);
+
+    void chain(unsigned long v, const Point *from, const Point *to, bool lower, Points &out) const;
+};
+
+
+#endif //CONVEXPOLYGONS_DYNAMICHULL_H
@@ -5,6 +5,7 @@
 #define CONVEXPOLYGONS_POINT_H
 
 #include <istream>
+#include <vector>
 #include "class/Vector2D.h"
 
 
@@ -18,6 +19,10 @@ struct Point {
 };
 
 
+/// Alias for a vector of points
+typedef std::vector<Point> Points;
+
+
 
 //-------- ASSOCIATED NONMEMBER FUNCTIONS --------//
 
@@ -0,0 +1,247 @@
+/// @file
+/// ID-to-polygon associative container, with a spatial index of its polygons.
+
+#ifndef CONVEXPOLYGONS_POLYGONMAP_H
+#define CONVEXPOLYGONS_POLYGONMAP_H
+
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "class/CompactPolygon.h"
+#include "class/ConvexPolygon.h"
+#include "class/RTree.h"
+
+
+//-------- POLYGON MAP CLASS --------//
+
+/**
+ * Associative container mapping identifiers (strings) to polygons. Besides looking
+ * polygons up by ID, it finds the ones that contain a point or overlap another polygon,
+ * through an RTree of their bounding boxes (empty polygons aren't indexed).
+ *
+ * Each ID is interned once, and gets a handle: a small integer that identifies its polygon
+ * until it's erased (after which the handle may be reused). Looking a polygon up by its
+ * handle is a plain array access; IDs are looked up in an open-addressing hash table (with
+ * linear probing), in expected constant time. The IDs aren't kept in any particular order:
+ * ids() sorts them on demand.
+ *
+ * The index is updated lazily: every polygon that has changed (by assign() or modify()) is
+ * only noted down, and the next query brings the index up to date. If many polygons have
+ * changed since (e.g., after loading a file), the index is bulk-loaded from scratch;
+ * otherwise, the changed ones are reinserted one by one. That's why the queries
+ * (containing() and overlapping()) aren't const: like any other modification, they
+ * mustn't run concurrently with other accesses to the map.
+ *
+ * The polygons are only handed out as const references, which stay valid until they're
+ * erased (or released, in compact mode), and they can only be modified through assign()
+ * and modify(): that way, the index can't miss a modification.
+ *
+ * For huge sessions, the map can be switched to compact mode (see setCompact()), in which
+ * the polygons are stored as CompactPolygon objects and only decoded on demand.
+ */
+class PolygonMap {
+public:
+    typedef unsigned long Handle;  ///< identifies a polygon in the map
+    static constexpr Handle NONE = -1ul;  ///< not a handle
+
+
+    /**
+     * Gets the handle of an ID.
+     * @param id  identifier of the polygon
+     * @return  its handle, or #NONE if there's no polygon with that ID
+     * @complexity expected constant
+     */
+    Handle find(const std::string &id) const;
+
+    /// Same as find(), but throws error::UndefinedID if there's no polygon with that ID
+    Handle handle(const std::string &id) const;
+
+    /**
+     * Gets the handle of an ID, inserting an empty polygon if there's none.
+     * @param id  identifier of the polygon
+     * @return  its handle
+     * @complexity expected constant (amortized)
+     */
+    Handle insert(const std::string &id);
+
+    /// @return the ID of a polygon
+    const std::string &id(Handle h) const { return slots[h].id; }
+
+    /**
+     * Gets a polygon, given its handle. In compact mode, the polygon is decoded (the
+     * first time since the last release()).
+     * @param h  handle of the polygon
+     * @return  a reference to the polygon
+     * @complexity constant (linear in the number of vertices if it has to be decoded)
+     */
+    const ConvexPolygon &get(Handle h) const;
+
+    /**
+     * Gets the polygon with a given ID.
+     * @param id  identifier of the polygon
+     * @return  a reference to the polygon
+     * @throws error::UndefinedID if no polygon has been assigned yet to `id`
+     * @complexity expected constant
+     */
+    const ConvexPolygon &at(const std::string &id) const { return get(handle(id)); }
+
+    /**
+     * Assigns a polygon to an ID, inserting it if there's none (see insert()).
+     * @param id  identifier of the polygon
+     * @param pol  the new polygon
+     * @return  the handle of the ID
+     * @complexity expected constant (amortized)
+     */
+    Handle assign(const std::string &id, ConvexPolygon pol);
+
+    /**
+     * Modifies a polygon in place (the polygon gets reindexed by the next query).
+     * @param h  handle of the polygon
+     * @param fn  function called with a (non-const) reference to the polygon, which
+     * mustn't be kept after the call
+     * @complexity that of `fn` (plus decoding the polygon, in compact mode)
+     */
+    template<typename Function>
+    void modify(Handle h, Function &&fn) { fn(touch(h)); }
+
+    /**
+     * Removes the polygon with a given ID.
+     * @param id  identifier of the polygon
+     * @return  whether there was such a polygon
+     * @complexity expected constant, plus \f$ O(\log(n)) \f$ amortized if it's indexed
+     */
+    bool erase(const std::string &id);
+
+    /// @return the number of polygons with the given ID (0 or 1)
+    unsigned long count(const std::string &id) const { return find(id) != NONE; }
+
+    /// @return the number of polygons
+    unsigned long size() const { return polygonCount; }
+
+    /// @return whether there are no polygons
+    bool empty() const { return polygonCount == 0; }
+
+    /// @return the IDs of the polygons, in lexicographical order
+    std::vector<std::string> ids() const;
+
+    /// @return the IDs of the given polygons, in lexicographical order
+    std::vector<std::string> ids(const std::vector<Handle> &handles) const;
+
+
+    //! @name Queries by handle
+    //! The same as the corresponding queries of the polygon (ConvexPolygon::area() etc.
+    //! and isInside(const Point &, const ConvexPolygon &)), but in compact mode they're
+    //! answered by the compact polygon, without decoding it (unless it's decoded already).
+    ///@{
+    double area(Handle h) const;
+    double perimeter(Handle h) const;
+    Box boundingBox(Handle h) const;  ///< @throws error::ValueError if the polygon is empty
+    bool contains(Handle h, const Point &P) const;
+    ///@}
+
+    /**
+     * Bounding box of a set of polygons (see ::boundingBox(ConstRange<ConvexPolygon>)),
+     * from the bounding boxes of each one (see boundingBox(Handle) const).
+     * @param handles  handles of the polygons
+     * @return  the bounding box of the non-empty ones
+     * @throws error::ValueError if they're all empty
+     * @complexity linear in the total number of vertices
+     */
+    Box boundingBox(const std::vector<Handle> &handles) const;
+
+
+    /**
+     * Turns the compact mode on or off. In compact mode, every polygon is stored as a
+     * CompactPolygon (8 bytes per vertex and 4 bytes for the color, instead of 16 and 24), and
+     * it's decoded whenever a ConvexPolygon is needed (by get(), at() or modify()). Decoded
+     * polygons are kept until release(), and the modified ones are encoded again by the next
+     * spatial query or release(). The queries by handle and containing() don't decode them.
+     *
+     * Turning the compact mode on encodes every polygon, so their vertices get rounded (see
+     * CompactPolygon), and turning it off decodes them all. Either way, every reference to
+     * a polygon is invalidated.
+     *
+     * @param on  whether to use the compact mode
+     * @complexity linear in the total number of vertices (if the mode changes)
+     */
+    void setCompact(bool on);
+
+    /// @return whether the map is in compact mode (see setCompact())
+    bool compact() const { return compactMode; }
+
+    /**
+     * Frees the polygons decoded in compact mode, encoding again the ones that may have
+     * changed. This invalidates every reference to them. Does nothing outside compact mode.
+     * @complexity linear in the total number of vertices of the decoded polygons
+     */
+    void release();
+
+
+    /**
+     * Finds the polygons that contain a point (see isInside(const Point &, const ConvexPolygon &)).
+     * The candidates are the ones whose bounding boxes contain it, which are then checked
+     * one by one.
+     *
+     * @param P  the point
+     * @return  the handles of the polygons that contain `P`, in no particular order
+     * @complexity \f$ O(\log(n) + k\log(m)) \f$ for well-spread polygons (plus the time to
+     * update the index), where \f$ k \f$ is the number of candidates and \f$ m \f$ their size
+     */
+    std::vector<Handle> containing(const Point &P);
+
+    /**
+     * Finds the polygons that overlap a given one (see intersects()). The candidates are
+     * the ones whose bounding boxes overlap its bounding box, which are then checked one
+     * by one.
+     *
+     * @param pol  the polygon
+     * @return  the handles of the polygons that intersect `pol`, in no particular order
+     * @complexity \f$ O(\log(n) + k\log(m)) \f$ for well-spread polygons (plus the time to
+     * update the index), where \f$ k \f$ is the number of candidates and \f$ m \f$ their size
+     */
+    std::vector<Handle> overlapping(const ConvexPolygon &pol);
+
+
+    /// Polygon-wise equality (the same IDs, with equal polygons)
+    friend bool operator==(const PolygonMap &lhs, const PolygonMap &rhs);
+    friend bool operator!=(const PolygonMap &lhs, const PolygonMap &rhs) { return not (lhs == rhs); }
+
+
+private:
+    struct Slot {
+        std::string id;
+        bool used = false;  // whether the handle belongs to a polygon (otherwise it's free)
+        bool changed = false;  // whether it's waiting to be (re)indexed
+    };
+
+    struct Bucket {
+        std::size_t hash;
+        Handle handle = NONE;  // (none if the bucket is empty)
+    };
+
+    std::deque<Slot> slots;  // indexed by handle
+    // The polygons, also indexed by handle (in deques, so that references stay valid). Only one
+    // of them is used, depending on the mode; in compact mode, `decoded` holds the decoded ones.
+    std::deque<ConvexPolygon> polygons;
+    std::deque<CompactPolygon> compactPolygons;
+    mutable std::unordered_map<Handle, ConvexPolygon> decoded;
+    bool compactMode = false;
+    std::vector<Handle> freeHandles;
+    unsigned long polygonCount = 0;
+    std::vector<Bucket> table;  // hash table of handles, by ID (its size is a power of two)
+
+    RTree index;
+    std::vector<Handle> changed;  // handles of the changed polygons
+
+    unsigned long bucketOf(const std::string &id, std::size_t hash) const;
+    void place(std::size_t hash, Handle h);
+    void removeBucket(unsigned long i);
+    ConvexPolygon &decode(Handle h) const;
+    ConvexPolygon &touch(Handle h);
+    bool isEmpty(Handle h) const;
+    void updateIndex();
+};
+
+
+#endif //CONVEXPOLYGONS_POLYGONMAP_H
@@ -4,6 +4,7 @@
 #ifndef CONVEXPOLYGONS_RGBCOLOR_H
 #define CONVEXPOLYGONS_RGBCOLOR_H
 
+#include <cstdint>  // std::uint32_t
 #include <initializer_list>  // for init list assignment
 
 
@@ -50,6 +51,29 @@ public:
     ///@}
 
 
+    //! @name Packing
+    //! Compact representation, with 8 bits per color value (see CompactPolygon)
+    ///@{
+
+    /**
+     * Packs the color in 24 bits, as `0xRRGGBB`: each value is rounded to the closest
+     * of 256 evenly spaced levels in \f$ [0, 1] \f$.
+     * @return  the packed color
+     */
+    std::uint32_t pack() const;
+
+    /**
+     * Inverse of pack(), up to rounding: each value of `unpack(c.pack())` is within
+     * \f$ 1/510 \f$ of the corresponding value of `c`.
+     * @param packed  color packed as `0xRRGGBB` (higher bits are ignored)
+     * @return  the unpacked color
+     */
+    static
+    RGBColor unpack(std::uint32_t packed);
+
+    ///@}
+
+
 private:
     double r, g, b;
 
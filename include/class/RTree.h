@@ -0,0 +1,127 @@
+/// @file
+/// R-tree spatial index of boxes.
+
+#ifndef CONVEXPOLYGONS_RTREE_H
+#define CONVEXPOLYGONS_RTREE_H
+
+#include <vector>
+#include "class/Box.h"
+#include "class/Point.h"
+
+
+//-------- R-TREE CLASS --------//
+
+/**
+ * Spatial index of a set of boxes, each labelled with a value (e.g., the handle of the
+ * object it bounds). Answers which boxes contain a point or overlap another box without
+ * looking at most of the others.
+ *
+ * Boxes are grouped in the leaves of a balanced tree, and every internal node stores the
+ * bounding box of each of its children. A whole set of boxes can be bulk-loaded at once
+ * (Sort-Tile-Recursive packing, which gives full nodes that hardly overlap); afterwards,
+ * single boxes are inserted and erased as in Guttman's R-tree: down the child whose box
+ * grows the least, splitting full nodes in two along the axis where the halves overlap
+ * the least, and reinserting the entries of nodes that become too small.
+ *
+ * The values are used as indices (to find the leaf of each of them when it's erased), so
+ * they should be small, like the positions of the objects in an array.
+ */
+class RTree {
+public:
+    /// A box and its value, for bulk loading
+    struct Entry {
+        Box box;
+        unsigned long value;
+    };
+
+    RTree() = default;
+
+    /**
+     * Bulk-loads a set of boxes.
+     * @param entries  the boxes and their (distinct) values
+     * @complexity \f$ O(n\log(n)) \f$
+     */
+    explicit
+    RTree(std::vector<Entry> entries);
+
+
+    /**
+     * Adds a box, or moves it if `value` is already in the tree.
+     * @param value  value of the box
+     * @param box  the box
+     * @complexity \f$ O(\log(n)) \f$
+     */
+    void insert(unsigned long value, const Box &box);
+
+    /**
+     * Removes the box with a given value.
+     * @param value  value of the box to be removed
+     * @return  whether there was such a box
+     * @complexity \f$ O(\log(n)) \f$ amortized
+     */
+    bool erase(unsigned long value);
+
+    /// @return whether there's a box with the given value
+    bool contains(unsigned long value) const { return value < leafOf.size() and leafOf[value] != NIL; }
+
+    /// @return the number of boxes
+    unsigned long size() const { return entryCount; }
+
+    /// @return whether there are no boxes
+    bool empty() const { return entryCount == 0; }
+
+
+    /**
+     * Finds the boxes that contain a point (or have it on their boundary).
+     * @param P  the point
+     * @param[out] result  the values of those boxes are appended to it (in no particular order)
+     * @complexity \f$ O(\log(n) + k) \f$ for well-spread boxes, where \f$ k \f$ is the number found
+     */
+    void search(const Point &P, std::vector<unsigned long> &result) const;
+
+    /**
+     * Finds the boxes that overlap a box (or touch it).
+     * @param box  the box
+     * @param[out] result  the values of those boxes are appended to it (in no particular order)
+     * @complexity \f$ O(\log(n) + k) \f$ for well-spread boxes, where \f$ k \f$ is the number found
+     */
+    void search(const Box &box, std::vector<unsigned long> &result) const;
+
+
+private:
+    static constexpr unsigned long NIL = -1ul;
+    static constexpr unsigned MAX_ENTRIES = 16;  // per node
+    static constexpr unsigned MIN_ENTRIES = 6;  // per node (except the root)
+
+    struct Rect { Point SW, NE; };  // (more compact than a Box)
+
+    struct Node {
+        unsigned count = 0;  // number of entries
+        unsigned level = 0;  // height above the leaves
+        unsigned long parent = NIL;
+        Rect rects[MAX_ENTRIES + 1];  // bounds of each entry (with room for one too many, before a split)
+        unsigned long children[MAX_ENTRIES + 1];  // leaves: values; internal nodes: child nodes
+    };
+
+    std::vector<Node> nodes;  // node pool
+    std::vector<unsigned long> freeNodes;  // unused slots in the pool
+    std::vector<unsigned long> leafOf;  // leaf containing each value (NIL if it isn't in the tree)
+    unsigned long root = NIL;
+    unsigned long entryCount = 0;
+
+    unsigned long newNode(unsigned level);
+    void append(unsigned long v, const Rect &rect, unsigned long child);
+    void removeEntry(unsigned long v, unsigned i);
+    unsigned position(unsigned long v, unsigned long child) const;
+    Rect cover(unsigned long v) const;
+
+    void insert(const Rect &rect, unsigned long child, unsigned level);
+    void adjust(unsigned long v);
+    unsigned long split(unsigned long v);
+
+    template<typename Overlaps>
+    void search(const Overlaps &overlaps, std::vector<unsigned long> &result) const;
+};
+
+
+#endif //CONVEXPOLYGONS_RTREE_H
@@ -0,0 +1,100 @@
+/// @file
+/// Per-thread arena for the temporary buffers of the algorithms.
+
+#ifndef CONVEXPOLYGONS_SCRATCHARENA_H
+#define CONVEXPOLYGONS_SCRATCHARENA_H
+
+#include <cstddef>  // std::size_t
+#include <memory>  // std::unique_ptr
+#include <memory_resource>
+#include <vector>
+
+
+/// Vector whose elements are allocated from a memory resource (e.g. a ScratchArena)
+template<typename T>
+using ScratchVector = std::pmr::vector<T>;
+
+
+//-------- SCRATCH ARENA CLASS --------//
+
+/**
+ * Memory resource for temporary buffers (see ScratchVector): a bump allocator over a
+ * buffer that is reused from one operation to the next, so that the temporaries of the
+ * hull and intersection algorithms don't go through the heap.
+ *
+ * Memory is only freed all at once, by reset(), which happens when the outermost Scope
+ * open on the arena is closed (e.g. at the end of each command). Whatever doesn't fit in
+ * the buffer comes from the heap in the meantime, and then the buffer grows to the peak
+ * usage (up to scratch::MAX_CAPACITY), so in the steady state nothing is allocated.
+ *
+ * An arena isn't thread-safe: every thread has its own one (see local()), and the buffers
+ * allocated from it mustn't grow in other threads (they can be read from anywhere, though).
+ */
+class ScratchArena : public std::pmr::memory_resource {
+public:
+    /**
+     * Marks the use of an arena by an operation: when the outermost scope open on an arena
+     * is closed, the arena is reset. Buffers from the arena must be freed (or forgotten)
+     * by then, so they should be declared after the scope.
+     */
+    class Scope {
+    public:
+        explicit
+        Scope(ScratchArena &arena = local());
+        ~Scope();
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+        /// @return the arena, as a memory resource for the temporary buffers (see ScratchVector)
+        std::pmr::memory_resource *resource() const { return &arena; }
+
+    private:
+        ScratchArena &arena;
+    };
+
+
+    /**
+     * Creates an arena.
+     * @param capacity  initial size of its buffer, in bytes
+     */
+    explicit
+    ScratchArena(std::size_t capacity = 0);
+
+    ScratchArena(const ScratchArena &) = delete;
+    ScratchArena &operator=(const ScratchArena &) = delete;
+
+    /// The arena of the calling thread
+    static
+    ScratchArena &local();
+
+    /**
+     * Frees everything allocated from the arena. If some of it didn't fit in the buffer,
+     * the buffer grows to the total size (up to scratch::MAX_CAPACITY).
+     */
+    void reset();
+
+    /// @return the size of the buffer, in bytes
+    std::size_t capacity() const { return bufferSize; }
+
+    /// @return the number of bytes allocated since the last reset (in the buffer or not)
+    std::size_t used() const { return offset + overflowed; }
+
+
+protected:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *, std::size_t, std::size_t) override {}  // (freed by reset())
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+
+private:
+    std::unique_ptr<char[]> buffer;
+    std::size_t bufferSize;
+    std::size_t offset = 0;  // start of the free part of the buffer
+    std::size_t overflowed = 0;  // bytes allocated from `overflow`
+    std::pmr::monotonic_buffer_resource overflow;  // (from the heap)
+    unsigned scopes = 0;  // number of open scopes
+};
+
+
+#endif //CONVEXPOLYGONS_SCRATCHARENA_H
@@ -0,0 +1,87 @@
+/// @file
+/// Convex hull of a sliding window of points.
+
+#ifndef CONVEXPOLYGONS_SLIDINGWINDOWHULL_H
+#define CONVEXPOLYGONS_SLIDINGWINDOWHULL_H
+
+#include <vector>
+#include "class/Point.h"
+#include "class/ConvexPolygon.h"
+
+
+//-------- SLIDING WINDOW HULL CLASS --------//
+
+/**
+ * Convex hull of a FIFO queue of points: points are pushed at the back of the
+ * window and popped from its front. This is the common case of a fully dynamic
+ * hull (see DynamicHull), and it can be handled much more cheaply.
+ *
+ * The window is split into two stacks, like a queue implemented with two stacks.
+ * Each of them keeps the convex hull of its points, built incrementally, and a log
+ * of the changes made to it by each point, so that the last point can be popped by
+ * undoing its changes. When the front stack runs out of points, the back one is
+ * transferred to it (in reverse order). The hull of the window is the hull of the
+ * vertices of both stacks' hulls.
+ */
+class SlidingWindowHull {
+public:
+    /**
+     * Adds a point at the back of the window.
+     * @param P  point to be added
+     * @complexity amortized logarithmic in the number of vertices of the hull, plus
+     * the number of vertices that have to be moved (a fast memory move)
+     */
+    void push(const Point &P);
+
+    /**
+     * Removes the point at the front of the window (the oldest one).
+     * @throws error::ValueError  if the window is empty
+     * @complexity same as push(), amortized
+     */
+    void pop();
+
+    /// @return the number of points in the window
+    unsigned long size() const { return front.points.size() + back.points.size(); }
+
+    /// @return whether the window is empty
+    bool empty() const { return size() == 0; }
+
+    /**
+     * Snapshot of the current convex hull.
+     * @return  the convex hull of the points in the window, as a ConvexPolygon: a valid
+     * hull (see hull::isHull()), the same as `ConvexPolygon(points)` (where `points` are
+     * the points in the window) except where some of them are within numeric::EPSILON of
+     * being collinear, since the stacks' hulls are updated one point at a time
+     * @complexity quasilinear in the number of vertices of both stacks' hulls
+     */
+    ConvexPolygon polygon() const;
+
+
+private:
+    /// Incremental convex hull whose last insertion can be undone
+    struct Stack {
+        static constexpr unsigned long NIL = -1ul;
+
+        /*
+         * Changes made to the hull by a push: P was inserted at `position`, after removing
+         * `removed` vertices from there (and `head` vertices from the front of the ring).
+         * The removed vertices are saved in `removedLog`. If `head` is NIL, the hull was
+         * rebuilt and `removed` is its previous size; if `position` is NIL, P was inside.
+         */
+        struct Change { unsigned long position, removed, head; };
+
+        Points points;  // the pushed points, in order
+        Points ring;  // vertices of the hull, clockwise, starting with any (not repeated at the end)
+        std::vector<Change> changes;
+        Points removedLog;
+
+        void push(const Point &P);
+        void pop();
+        void clear();
+    };
+
+    Stack front, back;
+};
+
+
+#endif //CONVEXPOLYGONS_SLIDINGWINDOWHULL_H
@@ -0,0 +1,110 @@
+/// @file
+/// Fixed-size pool of worker threads.
+
+#ifndef CONVEXPOLYGONS_THREADPOOL_H
+#define CONVEXPOLYGONS_THREADPOOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+
+/**
+ * Fixed-size pool of worker threads that run submitted tasks in FIFO order.
+ * Tasks may submit other tasks and wait for them with get(), which runs
+ * pending tasks while waiting so that nested parallelism can't deadlock the pool
+ * (and sleeps while there are none, until the result is ready or a task is submitted).
+ */
+class ThreadPool {
+public:
+    /**
+     * Starts a pool with a certain number of worker threads.
+     * @param threads  number of worker threads; if 0, uses one thread per hardware thread
+     */
+    explicit
+    ThreadPool(unsigned threads = 0);
+
+    /// Finishes all pending tasks and joins the worker threads.
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+
+    /**
+     * Schedules a task for execution in one of the worker threads.
+     * @param task  callable object taking no arguments
+     * @return a future holding the result of `task` (or the exception it threw)
+     */
+    template<typename Function>
+    auto submit(Function task) -> std::future<decltype(task())>;
+
+    /**
+     * Waits for a future obtained from submit(), running pending tasks
+     * in the calling thread in the meantime (and blocking while there are none).
+     * @param future  future to wait for
+     * @return the future's value (rethrows the task's exception, if any)
+     */
+    template<typename T>
+    T get(std::future<T> &future);
+
+    /// @return the number of worker threads
+    unsigned size() const { return (unsigned) workers.size(); }
+
+    /// Pool shared by the whole program, with one thread per hardware thread.
+    static
+    ThreadPool &shared();
+
+
+private:
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable condition;  // (signaled when a task is submitted)
+    std::condition_variable waiting;  // (signaled when a task is submitted or finished, if there are waiters)
+    unsigned waiters = 0;  // number of threads blocked in get()
+    bool stopping = false;
+
+    void work();  // worker thread loop
+    bool runPendingTask();  // runs one pending task in the calling thread, if any
+    void wait(const std::function<bool()> &ready);  // blocks until `ready()` or a task is pending
+    void finished();  // wakes up the threads blocked in get() after a task finishes
+};
+
+
+
+//-------- TEMPLATE MEMBER FUNCTIONS --------//
+
+template<typename Function>
+auto ThreadPool::submit(Function task) -> std::future<decltype(task())> {
+    // packaged_task isn't copyable, so we keep it alive through a shared pointer
+    auto packaged = std::make_shared<std::packaged_task<decltype(task())()>>(std::move(task));
+    auto future = packaged->get_future();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.emplace([this, packaged]{
+            (*packaged)();
+            finished();
+        });
+    }
+    condition.notify_one();
+    waiting.notify_all();
+    return future;
+}
+
+
+template<typename T>
+T ThreadPool::get(std::future<T> &future) {
+    auto ready = [&future]{ return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready; };
+    while (not ready())
+        if (not runPendingTask()) wait(ready);
+    return future.get();
+}
+
+
+#endif //CONVEXPOLYGONS_THREADPOOL_H
@@ -13,23 +13,35 @@ namespace cmd {
     constexpr auto
             POLYGON = "polygon",
             DELETE = "delete",
+            INSERT = "insert",
+            CLASSIFY = "classify",
+            CLASSIFY_FILE = "classify-file",
             PRINT = "print",
             PRETTYPRINT = "pretty-print",
             AREA = "area",
             PERIMETER = "perimeter",
             VERTICES = "vertices",
             CENTROID = "centroid",
+            DIAMETER = "diameter",
+            WIDTH = "width",
             SETCOL = "setcol",
             INTERSECTION = "intersection",
             UNION = "union",
+            MINKOWSKI = "minkowski",
             INSIDE = "inside",
+            INTERSECTS = "intersects",
             BBOX = "bbox",
+            RECTANGLE = "rectangle",
+            CONTAINING = "containing",
+            OVERLAPPING = "overlapping",
             LIST = "list",
             SAVE = "save",
             LOAD = "load",
             INCLUDE = "include",
             DRAW = "draw",
-            PAINT = "paint";
+            PAINT = "paint",
+            STATS = "stats",
+            COMPACT = "compact";
 
 }
 
@@ -64,6 +76,51 @@ namespace img {
 }
 
 
+/// Tuning parameters for convex hull construction
+namespace hull {
+
+    constexpr unsigned long PARALLEL_THRESHOLD = 1ul << 17;
+    ///< default number of points from which convex hulls are built in parallel
+
+    constexpr unsigned long FILTER_THRESHOLD = 64;
+    ///< default number of points from which interior points are culled before building a hull
+
+    constexpr unsigned long CHAN_THRESHOLD = 1ul << 12;
+    ///< default number of points from which Chan's algorithm is considered
+
+    constexpr unsigned long CHAN_SAMPLE_SIZE = 1024;
+    ///< number of sample points used to estimate the size of a hull
+
+    constexpr unsigned long CHAN_SAMPLE_RATIO = 32;
+    ///< Chan's algorithm is chosen if at most one in this many sample points is a hull vertex
+
+    constexpr unsigned long MERGE_TANGENT_RATIO = 32;
+    ///< two hulls are merged by finding tangents if one has at least this many times the vertices of the other
+
+    constexpr unsigned long CONTAINS_SEARCH_RATIO = 32;
+    ///< the vertices of a hull are located one by one in another one if it has at least this many times as many
+
+}
+
+
+/// Tuning parameters for operations with several polygons
+namespace ops {
+
+    constexpr unsigned long PARALLEL_THRESHOLD = 1ul << 15;
+    ///< total number of vertices from which the two halves of an n-ary reduction are computed in parallel
+
+}
+
+
+/// Tuning parameters for the temporary memory of the algorithms (see ScratchArena)
+namespace scratch {
+
+    constexpr unsigned long MAX_CAPACITY = 1ul << 25;
+    ///< maximum size (in bytes) of the buffer kept by each thread's arena; bigger temporaries come from the heap
+
+}
+
+
 /// Namespace for anything related to numerical computations
 namespace numeric {
 
@@ -0,0 +1,58 @@
+/// @file
+/// Allocator for over-aligned arrays (header-only)
+
+#ifndef CONVEXPOLYGONS_ALIGNED_H
+#define CONVEXPOLYGONS_ALIGNED_H
+
+#include <cstddef>  // std::size_t
+#include <cstdint>  // std::uintptr_t
+#include <new>  // ::operator new
+#include <vector>
+
+
+/**
+ * Minimal allocator whose allocations start at a multiple of `alignment` bytes
+ * (e.g. a cache line, so that SIMD kernels can use aligned loads).
+ *
+ * @tparam T  type of the allocated objects
+ * @tparam alignment  alignment in bytes (a power of two)
+ */
+template<typename T, std::size_t alignment = 64>
+struct AlignedAllocator {
+    typedef T value_type;
+
+    template<typename U>
+    struct rebind { typedef AlignedAllocator<U, alignment> other; };
+
+    AlignedAllocator() = default;
+
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, alignment> &) {}
+
+    T *allocate(std::size_t n) {
+        // over-allocate, and keep the original address right before the aligned block:
+        char *raw = static_cast<char *>(::operator new(n*sizeof(T) + alignment + sizeof(void *)));
+        const std::uintptr_t start = reinterpret_cast<std::uintptr_t>(raw) + sizeof(void *);
+        char *aligned = raw + ((start + alignment - 1) & ~(alignment - 1)) - reinterpret_cast<std::uintptr_t>(raw);
+        reinterpret_cast<void **>(aligned)[-1] = raw;
+        return reinterpret_cast<T *>(aligned);
+    }
+
+    void deallocate(T *p, std::size_t) {
+        ::operator delete(reinterpret_cast<void **>(p)[-1]);
+    }
+};
+
+template<typename T, typename U, std::size_t alignment>
+bool operator==(const AlignedAllocator<T, alignment> &, const AlignedAllocator<U, alignment> &) { return true; }
+
+template<typename T, typename U, std::size_t alignment>
+bool operator!=(const AlignedAllocator<T, alignment> &, const AlignedAllocator<U, alignment> &) { return false; }
+
+
+/// Vector whose data is aligned to a cache line
+template<typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+
+#endif //CONVEXPOLYGONS_ALIGNED_H
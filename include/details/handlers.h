@@ -10,7 +10,7 @@
 #include <map>
 #include <string>
 #include "consts.h"
-#include "polygonmap.h"
+#include "class/PolygonMap.h"
 
 
 /** @name Command handlers
@@ -49,12 +49,18 @@ void handleBinaryOperation(const std::string &keyword, std::istream &argStream,
 /// Subroutine to handle n-ary operations with polygons
 void handleNAryOperation(const std::string &keyword, std::istream &argStream, PolygonMap &polygons);
 
+/// Subroutine to handle queries to the spatial index of the polygons
+void handleSpatialQuery(const std::string &keyword, std::istream &argStream, PolygonMap &polygons);
+
 /// Subroutine to handle file-related commands
 void handleIOCommand(const std::string &keyword, std::istream &argStream, PolygonMap &polygons);
 
 /// Subroutine to run commands that take no arguments
 void handleNullaryCommand(const std::string &keyword, std::istream &argStream, PolygonMap &polygons);
 
+/// Subroutine to handle commands that turn a setting of the session on or off
+void handleSessionSetting(const std::string &keyword, std::istream &argStream, PolygonMap &polygons);
+
 
 ///@}
 
@@ -72,12 +78,24 @@ const std::map<std::string, CommandHandler> cmdHandlerMap = {
         {cmd::PERIMETER,    handlePolygonMethod},
         {cmd::VERTICES,     handlePolygonMethod},
         {cmd::CENTROID,     handlePolygonMethod},
+        {cmd::DIAMETER,     handlePolygonMethod},
+        {cmd::WIDTH,        handlePolygonMethod},
         {cmd::SETCOL,       handlePolygonMethod},
-        {cmd::INTERSECTION, handleBinaryOperation},
-        {cmd::UNION,        handleBinaryOperation},
+        {cmd::INSERT,       handlePolygonMethod},
+        {cmd::CLASSIFY,     handlePolygonMethod},
+        {cmd::CLASSIFY_FILE, handlePolygonMethod},
+        {cmd::INTERSECTION, handleNAryOperation},
+        {cmd::UNION,        handleNAryOperation},
+        {cmd::MINKOWSKI,    handleNAryOperation},
         {cmd::INSIDE,       handleBinaryOperation},
+        {cmd::INTERSECTS,   handleBinaryOperation},
         {cmd::BBOX,         handleNAryOperation},
+        {cmd::RECTANGLE,    handleNAryOperation},
+        {cmd::CONTAINING,   handleSpatialQuery},
+        {cmd::OVERLAPPING,  handleSpatialQuery},
         {cmd::LIST,         handleNullaryCommand},
+        {cmd::STATS,        handleNullaryCommand},
+        {cmd::COMPACT,      handleSessionSetting},
         {cmd::SAVE,         handleIOCommand},
         {cmd::LOAD,         handleIOCommand},
         {cmd::DRAW,         handleIOCommand},
@@ -102,7 +120,8 @@ CommandHandler getCommandHandler(const std::string &keyword);
 /**
  * Parses a complete command (as a string). Commands correspond to an entire
  * line of user input. Catches any exception that inherits from error::Error
- * or error::Warning.
+ * or error::Warning. Afterwards, frees the polygons that the command decoded, if
+ * the map is in compact mode (see PolygonMap::release()).
  *
  * @param[in] command  full command (keyword + arguments) issued by the user
  * @param[in, out] polygonMap  polygon map in which the operations are to be performed
@@ -0,0 +1,253 @@
+/// @file
+/// Vector with inline storage for a few elements (header-only)
+
+#ifndef CONVEXPOLYGONS_SMALL_VECTOR_H
+#define CONVEXPOLYGONS_SMALL_VECTOR_H
+
+#include <algorithm>  // std::copy, std::equal
+#include <cstddef>  // std::size_t
+#include <initializer_list>
+#include <iterator>  // std::distance, std::reverse_iterator
+#include <new>  // placement new
+#include <type_traits>  // std::is_trivially_copyable
+#include <vector>
+
+
+/**
+ * Contiguous sequence container that keeps up to `N` elements inline (inside the object
+ * itself, without allocating), and switches to a `std::vector` beyond that. Implements
+ * the subset of the `std::vector` interface used for polygon vertices.
+ *
+ * Unlike `std::vector`, it can adopt the buffer of a `std::vector` (when constructed
+ * from an rvalue one), so that big sequences are moved in without copying. Once on
+ * the heap, it stays there (even if it shrinks to `N` elements or less).
+ *
+ * Iterators are plain pointers, and they're invalidated by any modification.
+ *
+ * @tparam T  type of the elements (trivially copyable, e.g. Point)
+ * @tparam N  number of elements stored inline
+ */
+template<typename T, std::size_t N>
+class SmallVector {
+    static_assert(std::is_trivially_copyable<T>::value, "SmallVector only supports trivially copyable types");
+
+public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+    typedef T &reference;
+    typedef const T &const_reference;
+    typedef T *iterator;
+    typedef const T *const_iterator;
+
+
+    SmallVector() : count(0) {}
+
+    SmallVector(std::initializer_list<T> elements) : SmallVector(elements.begin(), elements.end()) {}
+
+    /// Constructs the container with a copy of the elements in `[first, last)`
+    template<typename InputIt>
+    SmallVector(InputIt first, InputIt last) : count(0) { assign(first, last); }
+
+    /// Constructs the container with a copy of a vector's elements
+    explicit SmallVector(const std::vector<T> &vec) : SmallVector(vec.begin(), vec.end()) {}
+
+    /// Constructs the container with the elements of a vector (adopting its buffer if they don't fit inline)
+    explicit SmallVector(std::vector<T> &&vec) : count(0) {
+        if (vec.size() <= N) assign(vec.begin(), vec.end());
+        else spill(std::move(vec));
+    }
+
+    SmallVector(const SmallVector &other) : count(0) { *this = other; }
+    SmallVector(SmallVector &&other) noexcept : count(0) { *this = std::move(other); }
+
+    ~SmallVector() { if (onHeap()) heap.~vector(); }
+
+    SmallVector &operator=(const SmallVector &other) {
+        if (this != &other) assign(other.begin(), other.end());
+        return *this;
+    }
+
+    SmallVector &operator=(SmallVector &&other) noexcept {
+        if (this == &other) return *this;
+        if (other.onHeap()) {
+            if (onHeap()) heap = std::move(other.heap);
+            else spill(std::move(other.heap));
+            other.heap.~vector();
+            other.count = 0;
+        }
+        else assign(other.begin(), other.end());
+        return *this;
+    }
+
+    /// Copy of the elements as a `std::vector`
+    explicit operator std::vector<T>() const & { return std::vector<T>(begin(), end()); }
+
+    /// Moves the elements out as a `std::vector` (without copying them if they're on the heap)
+    explicit operator std::vector<T>() && {
+        if (not onHeap()) return std::vector<T>(begin(), end());
+        std::vector<T> vec = std::move(heap);
+        heap.~vector();
+        count = 0;
+        return vec;
+    }
+
+
+
+    //! @name Element access
+    ///@{
+    T *data() { return onHeap() ? heap.data() : local; }
+    const T *data() const { return onHeap() ? heap.data() : local; }
+
+    T &operator[](size_type i) { return data()[i]; }
+    const T &operator[](size_type i) const { return data()[i]; }
+
+    T &front() { return data()[0]; }
+    const T &front() const { return data()[0]; }
+    T &back() { return data()[size() - 1]; }
+    const T &back() const { return data()[size() - 1]; }
+    ///@}
+
+    //! @name Iterators
+    ///@{
+    iterator begin() { return data(); }
+    const_iterator begin() const { return data(); }
+    iterator end() { return data() + size(); }
+    const_iterator end() const { return data() + size(); }
+
+    std::reverse_iterator<iterator> rbegin() { return std::reverse_iterator<iterator>(end()); }
+    std::reverse_iterator<const_iterator> rbegin() const { return std::reverse_iterator<const_iterator>(end()); }
+    std::reverse_iterator<iterator> rend() { return std::reverse_iterator<iterator>(begin()); }
+    std::reverse_iterator<const_iterator> rend() const { return std::reverse_iterator<const_iterator>(begin()); }
+    ///@}
+
+    //! @name Capacity
+    ///@{
+    size_type size() const { return onHeap() ? heap.size() : count; }
+    bool empty() const { return size() == 0; }
+
+    /// @return whether the elements are stored inline (i.e., without a heap allocation)
+    bool isInline() const { return not onHeap(); }
+    ///@}
+
+    //! @name Modifiers
+    ///@{
+
+    /// Replaces the contents with a copy of the elements in `[first, last)`
+    template<typename InputIt>
+    void assign(InputIt first, InputIt last) {
+        const size_type n = std::distance(first, last);
+        if (onHeap()) heap.assign(first, last);
+        else if (n <= N) {
+            std::copy(first, last, local);
+            count = n;
+        }
+        else spill(std::vector<T>(first, last));
+    }
+
+    void clear() {
+        if (onHeap()) heap.clear();
+        else count = 0;
+    }
+
+    void push_back(const T &value) {
+        if (onHeap()) heap.push_back(value);
+        else if (count < N) local[count++] = value;
+        else {
+            std::vector<T> vec;
+            vec.reserve(2*N);
+            vec.assign(local, local + count);
+            vec.push_back(value);
+            spill(std::move(vec));
+        }
+    }
+
+    void pop_back() {
+        if (onHeap()) heap.pop_back();
+        else --count;
+    }
+
+    /// Inserts `value` before `pos`
+    /// @return an iterator to the inserted element
+    iterator insert(const_iterator pos, const T &value) {
+        const size_type i = pos - begin();
+        if (onHeap()) heap.insert(heap.begin() + i, value);
+        else if (count < N) {
+            std::copy_backward(local + i, local + count, local + count + 1);
+            local[i] = value;
+            ++count;
+        }
+        else {
+            std::vector<T> vec(local, local + count);
+            vec.insert(vec.begin() + i, value);
+            spill(std::move(vec));
+        }
+        return begin() + i;
+    }
+
+    /// Removes the elements in `[first, last)`
+    /// @return an iterator following the last removed element
+    iterator erase(const_iterator first, const_iterator last) {
+        const size_type i = first - begin(), j = last - begin();
+        if (onHeap()) heap.erase(heap.begin() + i, heap.begin() + j);
+        else {
+            std::copy(local + j, local + count, local + i);
+            count -= j - i;
+        }
+        return begin() + i;
+    }
+
+    /// Removes the element at `pos`
+    /// @return an iterator following the removed element
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+    ///@}
+
+
+private:
+    static constexpr size_type HEAP = -1;
+
+    union {
+        T local[N];  // if not onHeap()
+        std::vector<T> heap;  // if onHeap()
+    };
+    size_type count;  // number of elements in `local`, or HEAP
+
+    bool onHeap() const { return count == HEAP; }
+
+    // Moves to the heap, adopting `vec` as the contents
+    void spill(std::vector<T> &&vec) {
+        new (&heap) std::vector<T>(std::move(vec));
+        count = HEAP;
+    }
+};
+
+
+
+//! @name Equality operators
+//! Element-wise equality (also against a `std::vector`).
+///@{
+template<typename T, std::size_t N>
+bool operator==(const SmallVector<T, N> &lhs, const SmallVector<T, N> &rhs) {
+    return lhs.size() == rhs.size() and std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template<typename T, std::size_t N>
+bool operator==(const SmallVector<T, N> &lhs, const std::vector<T> &rhs) {
+    return lhs.size() == rhs.size() and std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template<typename T, std::size_t N>
+bool operator==(const std::vector<T> &lhs, const SmallVector<T, N> &rhs) { return rhs == lhs; }
+
+template<typename T, std::size_t N>
+bool operator!=(const SmallVector<T, N> &lhs, const SmallVector<T, N> &rhs) { return not(lhs == rhs); }
+
+template<typename T, std::size_t N>
+bool operator!=(const SmallVector<T, N> &lhs, const std::vector<T> &rhs) { return not(lhs == rhs); }
+
+template<typename T, std::size_t N>
+bool operator!=(const std::vector<T> &lhs, const SmallVector<T, N> &rhs) { return not(lhs == rhs); }
+///@}
+
+
+#endif //CONVEXPOLYGONS_SMALL_VECTOR_H
@@ -90,24 +90,25 @@ void checkFileForWriting(const std::string &filePath) {
 
 //-------- EXTEND --------//
 
-// Variadic template to get the total size of an arbitrary number of vectors (internal use)
-template<typename T, typename ... Types>
-constexpr unsigned long _size(const std::vector<T> &vec, const Types &... others) {
-    return vec.size() + _size(others...);
+// Variadic template to get the total size of an arbitrary number of containers (internal use)
+template<typename Container, typename ... Types>
+constexpr unsigned long _size(const Container &first, const Types &... others) {
+    return first.size() + _size(others...);
 }
 
 // Base case for _size()
-template<typename T>
-constexpr unsigned long _size(const std::vector<T> &vec) {
-    return vec.size();
+template<typename Container>
+constexpr unsigned long _size(const Container &first) {
+    return first.size();
 }
 
 
 /**
  * Recursive variadic template to extend a vector with the contents of
- * an arbitrary number of vectors.
+ * an arbitrary number of containers (vectors, or anything with `begin()`,
+ * `end()` and `size()`).
  * @param[out] destination  vector to be extended
- * @param[in] vectors  vectors to copy data from
+ * @param[in] vectors  containers to copy data from
  */
 template<typename T, typename ... Types>
 void extend(std::vector<T> &destination, const Types &... vectors) {
@@ -117,15 +118,15 @@ void extend(std::vector<T> &destination, const Types &... vectors) {
 
 
 // Base case for _extend()
-template<typename T>
-void _extend(std::vector<T> &destination, const std::vector<T> &first) {
+template<typename T, typename Container>
+void _extend(std::vector<T> &destination, const Container &first) {
     destination.insert(destination.end(), first.begin(), first.end());
 }
 
 
 // Internal version of extend()
-template<typename T, typename ... Types>
-void _extend(std::vector<T> &destination, const std::vector<T> &first, const Types &... others) {
+template<typename T, typename Container, typename ... Types>
+void _extend(std::vector<T> &destination, const Container &first, const Types &... others) {
     destination.insert(destination.end(), first.begin(), first.end());
     _extend(destination, others...);
 }
@@ -23,6 +23,13 @@ namespace geom {
      */
     double crossProd(const Vector2D & u, const Vector2D& v);
 
+    /**
+     * Dot product.
+     * @param u,v  operands of the dot product
+     * @return \f$ u_x v_x + u_y v_y \f$
+     */
+    double dotProd(const Vector2D &u, const Vector2D &v);
+
     /**
      * Whether two vectors are colinear
      * @param u,v  vectors under consideration
@@ -202,8 +209,182 @@ namespace geom {
      */
     bool isInSegment(const Point &P, const Segment &seg);
 
+
+    /**
+     * Distance from a point to a segment: to its closest point, which is either
+     * the orthogonal projection of the point onto the segment or an endpoint.
+     * @param P  point under consideration
+     * @param seg  segment under consideration
+     * @return the distance from `P` to the closest point of `seg`
+     */
+    double distance(const Point &P, const Segment &seg);
+
     ///@}
 
+
+
+
+    //-------- BATCH PREDICATES --------//
+
+    //! @name Batch predicates
+    //! Vectorized versions of the orientation predicates, for arrays of points. They
+    //! give exactly the same results as isClockwiseTurn() and isCounterClockwiseTurn()
+    //! (same arithmetic, same numeric::EPSILON tolerance), using the widest SIMD
+    //! instruction set supported by the CPU (see simd::level()).
+    ///@{
+
+    /// Instruction sets for the batch predicates, selected at run time
+    namespace simd {
+
+        /// Instruction sets, from narrowest to widest
+        enum class Level {
+            scalar,  ///< plain scalar code (no SIMD)
+            sse2,  ///< 2 points at a time
+            avx2,  ///< 4 points at a time
+            avx512,  ///< 8 points at a time (AVX-512F)
+        };
+
+        /**
+         * Detects the widest instruction set supported by the CPU (and by the compiler).
+         * @return  the detected level
+         */
+        Level detect();
+
+        /**
+         * Instruction set used by the batch predicates. Defaults to detect(); can be
+         * lowered (e.g. to compare the results of different levels).
+         * @return a reference to the global level
+         * @pre the level is not higher than detect()
+         */
+        Level &level();
+
+        /// @return the name of a level (as in `"avx2"`)
+        const char *name(Level level);
+
+    }
+
+
+    /**
+     * Batch version of isClockwiseTurn(), for a fixed segment and many points.
+     * @param A,B  first two points of every turn
+     * @param C  array of third points
+     * @param n  number of points in `C`
+     * @param[out] result  array of `n` booleans: `result[i]` is `isClockwiseTurn(A, B, C[i])`
+     * @complexity linear
+     */
+    void clockwiseTurns(const Point &A, const Point &B, const Point *C, unsigned long n, bool *result);
+
+    /**
+     * Batch version of isCounterClockwiseTurn(), for a fixed segment and many points.
+     * @param A,B  first two points of every turn
+     * @param C  array of third points
+     * @param n  number of points in `C`
+     * @param[out] result  array of `n` booleans: `result[i]` is `isCounterClockwiseTurn(A, B, C[i])`
+     * @complexity linear
+     */
+    void counterClockwiseTurns(const Point &A, const Point &B, const Point *C, unsigned long n, bool *result);
+
+    /**
+     * Batch predicate for many points against every edge of a chain (e.g. a convex polygon,
+     * to find the points strictly inside it).
+     * @param chain  array of `edges + 1` points; edge `j` goes from `chain[j]` to `chain[j + 1]`
+     * @param edges  number of edges in the chain
+     * @param C  array of points
+     * @param n  number of points in `C`
+     * @param[out] result  array of `n` booleans: `result[i]` is whether
+     * `isClockwiseTurn(chain[j], chain[j + 1], C[i])` for every `j < edges`
+     * @complexity \f$ O(n\cdot e) \f$, where \f$ e \f$ is the number of edges
+     */
+    void clockwiseTurnsAlong(const Point *chain, unsigned long edges, const Point *C, unsigned long n, bool *result);
+
+    /**
+     * Whether every three consecutive points of a chain form a clockwise turn.
+     * @param points  array of points
+     * @param n  number of points
+     * @return  whether `isClockwiseTurn(points[i], points[i + 1], points[i + 2])` for every
+     * `i < n - 2` (`true` if there are less than three points)
+     * @complexity linear, with early exit
+     */
+    bool allClockwiseTurns(const Point *points, unsigned long n);
+
+    ///@}
+
+
+
+
+    //-------- BATCH METRICS --------//
+
+    //! @name Batch metrics
+    //! Vectorized reductions over points stored as a structure of arrays (one array of
+    //! `x` coordinates and one of `y` coordinates, see ConvexPolygon::getVertexArrays()).
+    //! Like the batch predicates, they use the instruction set given by simd::level().
+    //! The sums are split into several partial sums, so they may differ from a sequential
+    //! sum in the last bits.
+    ///@{
+
+    /**
+     * Shoelace sum of a chain: \f$ \sum_{i<n} (x_{i+1} - x_i)(y_{i+1} + y_i) \f$. For a closed
+     * chain, this is twice the area that it encloses (positive if it goes clockwise).
+     * @param x,y  coordinates of the `n + 1` points of the chain
+     * @param n  number of edges
+     * @return  the shoelace sum
+     * @complexity linear
+     */
+    double shoelaceSum(const double *x, const double *y, unsigned long n);
+
+    /**
+     * Length of a chain: the sum of the lengths of its edges.
+     * @param x,y  coordinates of the `n + 1` points of the chain
+     * @param n  number of edges
+     * @return  the length of the chain
+     * @complexity linear
+     */
+    double chainLength(const double *x, const double *y, unsigned long n);
+
+    /**
+     * Sum of the coordinates of a set of points.
+     * @param x,y  coordinates of the points
+     * @param n  number of points
+     * @return  the point whose coordinates are the sums of the points' coordinates
+     * @complexity linear
+     */
+    Point coordinateSum(const double *x, const double *y, unsigned long n);
+
+    /**
+     * Minimum and maximum coordinates of a set of points.
+     * @param x,y  coordinates of the points
+     * @param n  number of points
+     * @param[out] min  the minimum `x` and `y` coordinates
+     * @param[out] max  the maximum `x` and `y` coordinates
+     * @pre `n > 0`
+     * @complexity linear
+     */
+    void coordinateBounds(const double *x, const double *y, unsigned long n, Point &min, Point &max);
+
+    ///@}
+
+
+
+
+    //-------- BATCH POINT LOCATION --------//
+
+    /**
+     * Batch version of hull::contains(const Point &, const Point *, unsigned long), for many
+     * points and the same convex polygon, given as a structure of arrays. Gives exactly the
+     * same results. With AVX2 or AVX-512 (see simd::level()), the binary searches of 4 or 8
+     * points run in lockstep, gathering the vertices that each one needs; with narrower
+     * instruction sets, the points are located one by one.
+     * @param x,y  coordinates of the polygon's vertices, clockwise (at least `n` of them)
+     * @param n  number of vertices
+     * @param P  array of points
+     * @param k  number of points in `P`
+     * @param[out] result  array of `k` booleans: `result[i]` is whether `P[i]` is inside the
+     * polygon (or on its boundary)
+     * @complexity \f$ O(k\log(n)) \f$
+     */
+    void insideConvexPolygon(const double *x, const double *y, unsigned long n, const Point *P, unsigned long k,
+                             bool *result);
+
 }
 
 
@@ -0,0 +1,383 @@
+/// @file
+/// Convex hull algorithms for sets of points.
+
+#ifndef CONVEXPOLYGONS_HULL_H
+#define CONVEXPOLYGONS_HULL_H
+
+#include <atomic>
+#include "class/Point.h"
+#include "consts.h"
+
+
+/**
+ * Namespace for convex hull algorithms. Every algorithm in here follows the
+ * same output convention as ConvexPolygon::getVertices(): the hull vertices in
+ * clockwise order, starting with the one with lowest `x` coordinate (and lowest
+ * `y` coordinate in case of equality), with the first vertex repeated at the end.
+ * Collinear and duplicate points are discarded. An empty input yields an empty hull.
+ */
+namespace hull {
+
+    /**
+     * Calculates the convex hull of a set of points with Andrew's monotone chain
+     * algorithm. The points are sorted lexicographically (see geom::comp::xCoord) and
+     * both the upper and lower chains of the hull are built in a single pass.
+     *
+     * @param points  points to take the convex hull of
+     * @return  the vertices of the convex hull (see the namespace docs for the format)
+     *
+     * @complexity quasilinear in the number of points, \f$ O(n\log(n)) \f$
+     */
+    Points monotoneChain(Points points);
+
+    /**
+     * Same as monotoneChain(Points), but over an array of points owned by the caller
+     * (e.g. a temporary buffer), which is sorted in place.
+     *
+     * @param points  array of points to take the convex hull of (reordered)
+     * @param n  number of points in `points`
+     * @return  the vertices of the convex hull (see the namespace docs for the format)
+     */
+    Points monotoneChain(Point *points, unsigned long n);
+
+    /**
+     * Parallel version of monotoneChain(). The points are sorted in chunks on
+     * ThreadPool::shared() and merged, duplicates are removed from each chunk in
+     * parallel, and then both chains are built in a single serial scan over all of
+     * the sorted points. Gives exactly the same result as monotoneChain().
+     *
+     * @param points  points to take the convex hull of
+     * @param chunks  number of chunks to split the points into; if 0, uses one
+     * chunk per thread in the shared pool
+     * @return  the vertices of the convex hull (see the namespace docs for the format)
+     *
+     * @complexity quasilinear in the number of points, \f$ O(n\log(n)) \f$, divided
+     * among the threads of the pool (except for the final linear scan)
+     */
+    Points parallelMonotoneChain(Points points, unsigned chunks = 0);
+
+    /**
+     * Calculates the convex hull of a set of points with Chan's output-sensitive
+     * algorithm. For increasing guesses \f$ m \f$ of the number of hull vertices, the
+     * points are split into groups of \f$ m \f$, the hull of each group is built with
+     * the monotone chain algorithm, and the groups are gift-wrapped by finding the
+     * tangents from the current vertex to each group's hull with a binary search.
+     *
+     * The first guess is twice the number of hull vertices of
+     * a sample of CHAN_SAMPLE_SIZE points, times the cube root of the ratio of the number
+     * of points to the sample size if it's bigger (and at least 16); after every round that
+     * fails (because the hull has more than \f$ m \f$ vertices), the guess is squared.
+     * Once it reaches the number of points, the hull is built with monotoneChain().
+     * The wrapped vertices are scanned again with monotoneChain(), so the result is always
+     * a hull in the format of this namespace (see isHull()), the same one as monotoneChain()'s
+     * except where some points are within numeric::EPSILON of being collinear: since the
+     * turn tests use a tolerance, which of those points are kept as vertices depends on
+     * the order in which they're tested.
+     *
+     * Faster than monotoneChain() when the hull has few vertices (e.g. points
+     * uniformly distributed in a disk or a square), slower when most points
+     * are hull vertices.
+     *
+     * @param points  points to take the convex hull of
+     * @return  the vertices of the convex hull (see the namespace docs for the format)
+     *
+     * @complexity \f$ O(n\log(h)) \f$, where \f$ n \f$ is the number of points
+     * and \f$ h \f$ the number of hull vertices
+     */
+    Points chan(Points points);
+
+    /**
+     * Calculates the convex hull of a set of points with the Graham scan algorithm,
+     * sorting the points by the angle they form with the lowest-leftmost point
+     * (see geom::comp::yAngle). Kept as a reference implementation.
+     *
+     * @param points  points to take the convex hull of
+     * @return  the vertices of the convex hull (see the namespace docs for the format)
+     *
+     * @complexity quasilinear in the number of points, \f$ O(n\log(n)) \f$
+     */
+    Points grahamScan(Points points);
+
+    /**
+     * Whether a sequence of points already follows the output convention of this
+     * namespace, i.e., whether it is its own convex hull as returned by the algorithms
+     * above: strictly convex (every three consecutive vertices form a clockwise turn),
+     * clockwise, starting with the lowest vertex in the geom::comp::xCoord order,
+     * winding around only once, and with the first vertex repeated at the end.
+     *
+     * @param vertices  array of points to be checked
+     * @param size  number of points in `vertices`
+     * @return  whether `vertices` is a convex hull in the format of this namespace
+     *
+     * @complexity linear in the number of points
+     */
+    bool isHull(const Point *vertices, unsigned long size);
+
+    /// Overload of isHull(const Point *, unsigned long) for a vector of points
+    inline
+    bool isHull(const Points &vertices) { return isHull(vertices.data(), vertices.size()); }
+
+
+
+    //-------- TANGENTS --------//
+
+    /**
+     * Finds a tangent from a point to a convex polygon: the vertex \f$ V \f$ such that
+     * every vertex of the polygon lies to the right of (or on) the ray \f$ PV \f$,
+     * the farthest one from \f$ P \f$ in case of ties. In other words, the vertex that
+     * follows \f$ P \f$ in the (clockwise) convex hull of the polygon and \f$ P \f$.
+     * If `clockwise`, the mirror image: the vertex that precedes \f$ P \f$ in that hull.
+     *
+     * @param P  point outside of the polygon (or a vertex of it)
+     * @param vertices  the polygon's vertices, in the format of this namespace (there are
+     * `n + 1` of them, the first one is repeated at the end)
+     * @param n  number of vertices in the polygon
+     * @param clockwise  whether to search for the tangent in the opposite direction
+     * @return  index of the tangent vertex in `vertices`
+     *
+     * @pre `n > 0`
+     * @complexity logarithmic in the number of vertices (linear in degenerate cases,
+     * such as when `P` is on the polygon's boundary)
+     */
+    unsigned long tangent(const Point &P, const Point *vertices, unsigned long n, bool clockwise = false);
+
+
+    /**
+     * Finds the extreme vertex of a convex polygon in a given direction (its support
+     * point): the one that maximizes \f$ \vec{d}\cdot\overrightarrow{OV} \f$.
+     * The rightmost vertex is found first by binary search, and then the extreme one
+     * is searched for in the upper or the lower chain, depending on the direction.
+     *
+     * @param d  the direction
+     * @param vertices  the polygon's vertices, in the format of this namespace (there are
+     * `n + 1` of them, the first one is repeated at the end)
+     * @param n  number of vertices in the polygon
+     * @return  index of the extreme vertex in `vertices` (any of them in case of ties)
+     *
+     * @pre `n > 0`
+     * @complexity logarithmic in the number of vertices
+     */
+    unsigned long extreme(const Vector2D &d, const Point *vertices, unsigned long n);
+
+
+    /**
+     * Determines whether a point is inside a convex polygon (or on its boundary).
+     *
+     * @param P  point whose position (inside/outside) is to be determined
+     * @param vertices  the polygon's vertices in clockwise order, starting with any of them
+     * (only the first `n` are used, so the first one needn't be repeated at the end)
+     * @param n  number of vertices in the polygon
+     * @return  whether `P` is inside the polygon; always `false` if `n == 0`
+     *
+     * @complexity logarithmic in the number of vertices (linear if `P` is on the boundary,
+     * within numeric::EPSILON, since then every edge is checked)
+     */
+    bool contains(const Point &P, const Point *vertices, unsigned long n);
+
+    /**
+     * Determines whether a convex polygon W is inside another one V (or on its boundary).
+     * The upper and lower chains of both polygons are sorted by x, so every chain of W
+     * is walked along each chain of V at the same time, checking that its vertices are
+     * under V's upper chain and over its lower one. If V has far more vertices than W (see
+     * CONTAINS_SEARCH_RATIO), or if it's degenerate, each vertex of W is located by
+     * binary search instead (see contains(const Point &, const Point *, unsigned long)).
+     *
+     * @param V,W  the polygons' vertices, in the format of this namespace (there are
+     * `n + 1` and `m + 1` of them, the first one is repeated at the end)
+     * @param n,m  number of vertices in each polygon
+     * @return  whether every vertex of W is inside V; always `true` if `m == 0`
+     *
+     * @complexity \f$ O(n + m) \f$, or \f$ O(m\log(n)) \f$ if \f$ n \f$ is much bigger than \f$ m \f$
+     */
+    bool contains(const Point *V, unsigned long n, const Point *W, unsigned long m);
+
+
+
+    /**
+     * Determines whether two convex polygons intersect (or touch each other) with the
+     * GJK algorithm, without constructing their intersection: the closest point to the
+     * origin of their Minkowski difference is approximated with simplices whose vertices
+     * are found by extreme(), until a separating line is found or the origin is reached.
+     * Polygons within numeric::EPSILON of each other count as intersecting.
+     *
+     * @param V,W  the polygons' vertices, in the format of this namespace (there are
+     * `n + 1` and `m + 1` of them, the first one is repeated at the end)
+     * @param n,m  number of vertices in each polygon
+     * @return  whether V and W have any point in common; always `false` if either is empty
+     *
+     * @complexity \f$ O(k(\log(n) + \log(m))) \f$, where \f$ k \f$ is the number of
+     * iterations (usually a handful, at most \f$ n + m \f$); allocates no memory
+     */
+    bool intersects(const Point *V, unsigned long n, const Point *W, unsigned long m);
+
+
+
+    /**
+     * Distance between two convex polygons (between their closest points), found with the
+     * GJK algorithm as in intersects(), but carried on until the closest point of the
+     * Minkowski difference is found.
+     *
+     * @param V,W  the polygons' vertices, in the format of this namespace (there are
+     * `n + 1` and `m + 1` of them, the first one is repeated at the end)
+     * @param n,m  number of vertices in each polygon
+     * @return  the distance between V and W; 0 if they intersect (or are within numeric::EPSILON)
+     *
+     * @pre `n > 0` and `m > 0`
+     * @throws error::ValueError if either polygon is empty
+     * @complexity \f$ O(k(\log(n) + \log(m))) \f$, where \f$ k \f$ is the number of
+     * iterations (usually a handful, at most \f$ n + m \f$)
+     */
+    double distance(const Point *V, unsigned long n, const Point *W, unsigned long m);
+
+    /**
+     * Distance from a point to a convex polygon. If the point is outside, the closest
+     * edge is searched for by bisection along the part of the boundary that's visible from
+     * the point, between the tangents from it (see tangent()).
+     *
+     * @param P  the point under consideration
+     * @param vertices  the polygon's vertices, in the format of this namespace (there are
+     * `n + 1` of them, the first one is repeated at the end)
+     * @param n  number of vertices in the polygon
+     * @return  the distance from `P` to the closest point of the polygon; 0 if it's inside
+     *
+     * @pre `n > 0`
+     * @throws error::ValueError if the polygon is empty
+     * @complexity logarithmic in the number of vertices
+     */
+    double distance(const Point &P, const Point *vertices, unsigned long n);
+
+
+
+    //-------- MERGING --------//
+
+    /**
+     * Convex hull of the union of two convex polygons. Since the upper and lower chains of
+     * each polygon are already sorted, they are merged and the hull is built with a single
+     * linear scan, as in monotoneChain() (but without sorting). If one polygon has far more
+     * vertices than the other (see MERGE_TANGENT_RATIO), the tangents from each vertex of
+     * the small one to the big one are found instead (see tangent()), and the big one's
+     * vertices between the tangents are replaced by the small one's outer chains.
+     *
+     * @param V,W  the polygons' vertices, in the format of this namespace (there are
+     * `n + 1` and `m + 1` of them, the first one is repeated at the end)
+     * @param n,m  number of vertices in each polygon
+     * @return  the vertices of the convex hull of both polygons (see the namespace docs for the format)
+     *
+     * @complexity \f$ O(n + m) \f$; \f$ O(m\log(n) + m\log(m)) \f$ plus copying the vertices of
+     * the result if \f$ n \f$ is much bigger than \f$ m \f$ (or vice versa)
+     */
+    Points merge(const Point *V, unsigned long n, const Point *W, unsigned long m);
+
+
+
+    //-------- MINKOWSKI SUM --------//
+
+    /**
+     * Minkowski sum of two convex polygons: the set of sums \f$ P + Q \f$ of a point
+     * \f$ P \f$ of V and a point \f$ Q \f$ of W. Both polygons start at their lowest vertex
+     * (in the geom::comp::xCoord order) and go clockwise, so their edges are merged by angle,
+     * as in the merge step of merge sort, and the vertices of the sum are found along the way.
+     *
+     * @param V,W  the polygons' vertices, in the format of this namespace (there are
+     * `n + 1` and `m + 1` of them, the first one is repeated at the end)
+     * @param n,m  number of vertices in each polygon
+     * @return  the vertices of the Minkowski sum (see the namespace docs for the format);
+     * empty if either polygon is empty
+     *
+     * @complexity linear in the total number of vertices, \f$ O(n + m) \f$
+     */
+    Points minkowskiSum(const Point *V, unsigned long n, const Point *W, unsigned long m);
+
+
+
+    //-------- PRE-FILTERING --------//
+
+    /**
+     * Akl–Toussaint heuristic. Finds the extreme points in eight directions (the
+     * minimum and maximum of \f$ x \f$, \f$ y \f$, \f$ x + y \f$ and \f$ x - y \f$)
+     * and discards every point that lies strictly inside the octagon they span, since
+     * those can't be vertices of the convex hull. The relative order of the remaining
+     * points is preserved. Updates the counters in filterStats().
+     *
+     * The hull of the remaining points is still a valid hull (see isHull()) with the same
+     * first vertex, but it's not always the same as the hull of all the points: where
+     * some points are within numeric::EPSILON of being collinear, which of them are kept
+     * as vertices depends on the other points that the turn tests have seen (e.g., an
+     * interior point that's nearly aligned with a short edge can make monotoneChain()
+     * drop one of its vertices).
+     *
+     * @param[in, out] points  points to be filtered
+     * @return the number of discarded points
+     *
+     * @complexity linear in the number of points (two passes)
+     */
+    unsigned long aklToussaintFilter(Points &points);
+
+    /// Counters for the points processed by aklToussaintFilter() (since the last reset)
+    struct FilterStats {
+        std::atomic<unsigned long> calls{0};  ///< number of filtered point sets
+        std::atomic<unsigned long> examined{0};  ///< total number of points examined
+        std::atomic<unsigned long> discarded{0};  ///< total number of points discarded
+
+        /// Sets all counters back to zero
+        void reset() { calls = 0; examined = 0; discarded = 0; }
+    };
+
+    /**
+     * Global counters for aklToussaintFilter().
+     * @return a reference to the global counters
+     */
+    FilterStats &filterStats();
+
+
+
+    //-------- CONFIGURATION --------//
+
+    /// Hull algorithms that ConvexPolygon can use
+    enum class Algorithm {
+        automatic,  ///< chooses between the others with the heuristic in choose()
+        monotoneChain,  ///< monotoneChain() (or parallelMonotoneChain() for large inputs)
+        chan,  ///< chan()
+    };
+
+    /// Run-time configuration of the hull algorithms used by ConvexPolygon
+    struct Config {
+        /// algorithm used by ConvexPolygon to build its hull
+        Algorithm algorithm = Algorithm::automatic;
+
+        /// number of points from which ConvexPolygon builds its hull in parallel
+        unsigned long parallelThreshold = PARALLEL_THRESHOLD;
+
+        /// number of points from which ConvexPolygon culls interior points with
+        /// aklToussaintFilter() before building its hull
+        unsigned long filterThreshold = FILTER_THRESHOLD;
+
+        /// number of points from which Algorithm::automatic considers chan()
+        unsigned long chanThreshold = CHAN_THRESHOLD;
+    };
+
+    /**
+     * Global hull configuration. Modifiable; changes apply to every
+     * ConvexPolygon constructed afterwards.
+     * @return a reference to the global configuration
+     */
+    Config &config();
+
+    /**
+     * Heuristic behind Algorithm::automatic. Inputs below Config::chanThreshold
+     * use the monotone chain. Otherwise, the hull of an evenly spaced sample of
+     * CHAN_SAMPLE_SIZE points is computed: if only a few of them are hull vertices
+     * (at most one in CHAN_SAMPLE_RATIO), the whole hull is expected to be small,
+     * and chan() is chosen.
+     *
+     * @param points  points whose hull is going to be built
+     * @return  Algorithm::chan or Algorithm::monotoneChain
+     *
+     * @complexity constant (independent of the number of points)
+     */
+    Algorithm choose(const Points &points);
+
+}
+
+
+#endif //CONVEXPOLYGONS_HULL_H
@@ -5,7 +5,7 @@
 #define CONVEXPOLYGONS_COMMANDS_H
 
 #include <iostream>
-#include "details/polygonmap.h"
+#include "class/PolygonMap.h"
 #include "details/range.h"
 
 
@@ -56,6 +56,22 @@ void prettyPrint(const std::string &id, const ConvexPolygon &pol, std::ostream &
 void list(const PolygonMap &polygonMap);
 
 
+/**
+ * Prints a sequence of identifiers in a single line, separated by spaces.
+ * @param[in] ids  identifiers to be printed
+ * @param[out] os  output stream to which the identifiers have to be written
+ */
+void printIDs(const std::vector<std::string> &ids, std::ostream &os = std::cout);
+
+
+/**
+ * Prints the values of the program's performance counters (e.g., how many points
+ * were culled by hull::aklToussaintFilter()), one group of counters per line.
+ * @param[out] os  output stream to which the counters have to be written
+ */
+void printStats(std::ostream &os = std::cout);
+
+
 /**
  * Save a list of polygons in a text file. Uses the format described by printPolygon().
  *
@@ -71,6 +87,9 @@ void save(const std::string &file, const std::vector<std::string> &polygonIDs, c
 
 /**
  * Loads polygons from a text file into a map. Reads the format produced by save().
+ * Lines that already list the vertices of a convex hull (as written by save()) are
+ * loaded in linear time, without recomputing the hull (see ConvexPolygon::fromHull()).
+ * In compact mode, each polygon is encoded as soon as it's read (see PolygonMap::setCompact()).
  * @param[in] file  file path from which the polygons are to be read
  * @param[out] polygons  polygon map into which polygons are to be loaded
  *
@@ -80,6 +99,28 @@ void save(const std::string &file, const std::vector<std::string> &polygonIDs, c
 void load(const std::string &file, PolygonMap &polygons);
 
 
+/**
+ * Reads points from a text file, as pairs of coordinates separated by whitespace
+ * (e.g. one `x y` pair per line).
+ * @param[in] file  file path from which the points are to be read
+ * @return  the points, in the same order as in the file
+ *
+ * @throws error::IOError if the file couldn't be opened for reading as text
+ * @throws error::SyntaxError if the file contains anything else (or an unpaired coordinate)
+ */
+Points loadPoints(const std::string &file);
+
+/**
+ * Prints which points are inside a polygon (see isInside(const Point *, unsigned long,
+ * const ConvexPolygon &, bool *)), as a line with one character per point: `1` if it's
+ * inside the polygon (or on its boundary), and `0` if it isn't.
+ *
+ * @param[in] pol  the polygon under consideration
+ * @param[in] points  points to be classified
+ * @param[out] os  output stream to which the classification has to be written
+ */
+void printClassification(const ConvexPolygon &pol, const Points &points, std::ostream &os = std::cout);
+
 /**
  * Parses commands from a file as if it were standard input.
  *
@@ -104,12 +145,33 @@ void include(const std::string &file, PolygonMap &polygonMap, bool silent = fals
  */
 const ConvexPolygon &getPolygon(const std::string &id, const PolygonMap &polygonMap);
 
-/// Non-const version of getPolygon(const std::string &, const PolygonMap &)
-ConvexPolygon &getPolygon(const std::string &id, PolygonMap &polygons);
+/**
+ * Gets the handle of each ID in a vector of strings (see PolygonMap::handle()), so that
+ * the polygons can be retrieved without looking their IDs up again.
+ *
+ * @param polygonIDs  IDs to look up
+ * @param polygonMap  map in which to look them up
+ * @return  the handle of each of the IDs (in the same order)
+ * @throws error::UndefinedID if some ID isn't in the map
+ */
+std::vector<PolygonMap::Handle> getHandles(const std::vector<std::string> &polygonIDs, const PolygonMap &polygonMap);
 
+/**
+ * Lazily gets the polygon with each handle in a vector (see getHandles()).
+ *
+ * @param handles  handles of the polygons to retrieve (which must outlive the range)
+ * @param polygonMap  map from which to retrieve them
+ * @return a (non-evaluated) range of polygons corresponding to each of the handles
+ * (in the same order)
+ *
+ * @complexity constant (and then constant per polygon)
+ */
+ConstRange<ConvexPolygon> getPolygons(const std::vector<PolygonMap::Handle> &handles, const PolygonMap &polygonMap);
 
 /**
  * Lazily gets the polygon with ID `id` for each `id` in a vector of strings.
+ * Each traversal of the range looks the IDs up again; to look them up just once, see
+ * getHandles().
  *
  * @param polygonIDs  IDs to retrieve
  * @param polygons
@@ -0,0 +1,137 @@
+#include "calipers.h"
+
+#include <algorithm>  // std::max
+#include <cmath>  // INFINITY
+#include "errors.h"
+#include "hull.h"  // hull::monotoneChain
+
+using namespace geom;
+
+
+namespace calipers {
+
+    //-------- INTERNAL UTILITIES --------//
+
+    /*
+     * Tracks the vertices of a convex polygon that are extreme with respect to each edge,
+     * as the edges are visited in order: the farthest one along the edge (`front`), the
+     * farthest one from the edge's line (`top`), and the farthest one backwards (`back`).
+     * They come in this order after the edge, and only move forward as it rotates, so the
+     * indices increase monotonically (they're wrapped around only to access the vertices).
+     */
+    class _Calipers {
+    public:
+        Vector2D edge;  // direction of the current edge
+        unsigned long origin = 0, front = 0, top = 0, back = 0;
+
+        _Calipers(const Point *vertices, unsigned long n) : vertices(vertices), n(n) {}
+
+        // Lays the calipers against the edge from vertex `i` to vertex `i + 1`
+        void rotateTo(unsigned long i) {
+            origin = i;
+            edge = at(i + 1) - at(i);
+            front = std::max(front, i + 1);
+            while (along(front + 1) > along(front)) ++front;
+            top = std::max(top, front);
+            while (height(top + 1) > height(top)) ++top;
+            back = std::max(back, top);
+            while (along(back + 1) < along(back)) ++back;
+        }
+
+        // (the indices stay below 2n, so they're wrapped without a division)
+        const Point &at(unsigned long k) const { return vertices[k < n ? k : k - n]; }
+
+        // Projection of a vertex onto the edge's direction, and its distance to the edge's line
+        // (positive inside the polygon, since it's clockwise), both times the edge's length:
+        double along(unsigned long k) const { return dotProd(at(k) - at(origin), edge); }
+        double height(unsigned long k) const { return crossProd(at(k) - at(origin), edge); }
+
+        // Inner normal of the current edge (as long as the edge)
+        Vector2D normal() const { return {edge.y, -edge.x}; }
+
+    private:
+        const Point *vertices;
+        unsigned long n;
+    };
+
+
+    void _checkNonEmpty(unsigned long n) {
+        if (n == 0) throw error::ValueError("rotating calipers undefined for 0-gon");
+    }
+
+
+
+    //-------- MEASURES --------//
+
+    Segment diameter(const Point *V, unsigned long n) {
+        _checkNonEmpty(n);
+        if (n < 3) return {V[0], V[n - 1]};
+
+        // Every antipodal pair is made of an endpoint of some edge and the vertex farthest
+        // from it (or the next one, if there's a parallel edge on the other side):
+        _Calipers calipers(V, n);
+        Segment result = {V[0], V[0]};
+        double maxDist = 0;
+        for (unsigned long i = 0; i < n; ++i) {
+            calipers.rotateTo(i);
+            for (unsigned long a : {i, i + 1})
+                for (unsigned long b : {calipers.top, calipers.top + 1}) {
+                    const double dist = (calipers.at(b) - calipers.at(a)).squaredNorm();
+                    if (dist > maxDist) {
+                        maxDist = dist;
+                        result = {calipers.at(a), calipers.at(b)};
+                    }
+                }
+        }
+        return result;
+    }
+
+
+    Segment width(const Point *V, unsigned long n) {
+        _checkNonEmpty(n);
+        if (n < 3) return {V[0], V[0]};
+
+        _Calipers calipers(V, n), best = calipers;
+        double minWidth = INFINITY;
+        for (unsigned long i = 0; i < n; ++i) {
+            calipers.rotateTo(i);
+            const double width = calipers.height(calipers.top)/calipers.edge.norm();
+            if (width < minWidth) {
+                minWidth = width;
+                best = calipers;
+            }
+        }
+
+        // From the farthest vertex to its projection onto the best edge's line:
+        const double t = best.along(best.top)/best.edge.squaredNorm();
+        return {best.at(best.top), best.at(best.origin) + t*best.edge};
+    }
+
+
+    Points minAreaRectangle(const Point *V, unsigned long n) {
+        _checkNonEmpty(n);
+        if (n < 3) return Points(V, V + n + 1);
+
+        _Calipers calipers(V, n), best = calipers;
+        double minArea = INFINITY;
+        for (unsigned long i = 0; i < n; ++i) {
+            calipers.rotateTo(i);
+            const double area = (calipers.along(calipers.front) - calipers.along(calipers.back))
+                                * calipers.height(calipers.top)/calipers.edge.squaredNorm();
+            if (area < minArea) {
+                minArea = area;
+                best = calipers;
+            }
+        }
+
+        // The sides lie on the best edge's line, on the parallel line through the farthest
+        // vertex, and on the perpendicular lines through the extreme vertices along it:
+        const double length2 = best.edge.squaredNorm();
+        const Point &O = best.at(best.origin);
+        const Vector2D front = best.along(best.front)/length2*best.edge,
+                back = best.along(best.back)/length2*best.edge,
+                up = best.height(best.top)/length2*best.normal();
+        return hull::monotoneChain({O + back, O + front, O + front + up, O + back + up});
+    }
+
+}
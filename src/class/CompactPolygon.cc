@@ -0,0 +1,127 @@
+#include "class/CompactPolygon.h"
+
+#include <algorithm>  // std::min, std::max, std::minmax_element
+#include <cmath>  // std::lround, std::sqrt
+#include <limits>
+#include "errors.h"
+#include "details/numeric.h"
+#include "geom.h"  // turn predicates
+
+using namespace geom;
+
+
+//-------- MEMBER FUNCTIONS --------//
+
+CompactPolygon::CompactPolygon(const ConvexPolygon &pol) : color(pol.getColor().pack()) {
+    if (pol.empty()) return;
+    const Vertices &vertices = pol.getVertices();
+    const unsigned long n = pol.vertexCount();
+
+    // Offsets from the center of the bounding box, which span [-(2^31 - 1), 2^31 - 1] in each axis:
+    // (not with pol.boundingBox(), which would memoize a copy of the vertices that we're compacting)
+    Point SW = vertices[0], NE = vertices[0];
+    for (unsigned long i = 1; i < n; ++i) {
+        SW = {std::min(SW.x, vertices[i].x), std::min(SW.y, vertices[i].y)};
+        NE = {std::max(NE.x, vertices[i].x), std::max(NE.y, vertices[i].y)};
+    }
+    origin = {(SW.x + NE.x)/2, (SW.y + NE.y)/2};
+    const double limit = std::numeric_limits<std::int32_t>::max();
+    _step = {(NE.x - SW.x)/(2*limit), (NE.y - SW.y)/(2*limit)};
+
+    auto quantize = [limit](double delta, double step) {
+        if (step == 0) return std::int32_t(0);
+        return std::int32_t(std::lround(std::min(limit, std::max(-limit, delta/step))));
+    };
+
+    offsets.reserve(n);
+    for (unsigned long i = 0; i < n; ++i) {
+        const Offset offset = {quantize(vertices[i].x - origin.x, _step.x), quantize(vertices[i].y - origin.y, _step.y)};
+        // (vertices that are too close together end up being the same, so we keep only one)
+        if (offsets.empty() or offset.x != offsets.back().x or offset.y != offsets.back().y)
+            offsets.push_back(offset);
+    }
+    while (offsets.size() > 1 and offsets.back().x == offsets[0].x and offsets.back().y == offsets[0].y)
+        offsets.pop_back();
+    offsets.shrink_to_fit();
+}
+
+
+ConvexPolygon CompactPolygon::decode() const {
+    Points vertices(vertexCount());
+    for (unsigned long i = 0; i < vertexCount(); ++i) vertices[i] = vertex(i);
+    ConvexPolygon pol = ConvexPolygon::fromHull(move(vertices));  // (checked, in case rounding broke convexity)
+    pol.setColor(getColor());
+    return pol;
+}
+
+
+//---- Queries ----//
+
+double CompactPolygon::area() const {
+    // Shoelace formula over the offsets: each term is exact in 64 bits (both products are
+    // less than 2^62 in absolute value), and only the sum is rounded.
+    const unsigned long n = vertexCount();
+    double sum = 0;
+    for (unsigned long i = 0; i < n; ++i) {
+        const Offset &A = offsets[i], &B = offsets[i + 1 == n ? 0 : i + 1];
+        sum += double(std::int64_t(A.x)*B.y - std::int64_t(B.x)*A.y);
+    }
+    return std::abs(sum)/2*_step.x*_step.y;
+}
+
+double CompactPolygon::perimeter() const {
+    const unsigned long n = vertexCount();
+    double sum = 0;
+    for (unsigned long i = 0; i < n; ++i) {
+        const Offset &A = offsets[i], &B = offsets[i + 1 == n ? 0 : i + 1];
+        const double dx = (double(B.x) - A.x)*_step.x, dy = (double(B.y) - A.y)*_step.y;
+        sum += std::sqrt(dx*dx + dy*dy);
+    }
+    // avoid adding the same edge twice if the polygon is a segment:
+    if (n == 2) sum /= 2;
+    return sum;
+}
+
+Box CompactPolygon::boundingBox() const {
+    if (empty()) throw error::ValueError("bounding box undefined for 0-gon");
+
+    auto byX = [](const Offset &A, const Offset &B) { return A.x < B.x; };
+    auto byY = [](const Offset &A, const Offset &B) { return A.y < B.y; };
+    const auto xBounds = std::minmax_element(offsets.begin(), offsets.end(), byX);
+    const auto yBounds = std::minmax_element(offsets.begin(), offsets.end(), byY);
+    return Box({origin.x + xBounds.first->x*_step.x, origin.y + yBounds.first->y*_step.y},
+               {origin.x + xBounds.second->x*_step.x, origin.y + yBounds.second->y*_step.y});
+}
+
+bool CompactPolygon::contains(const Point &P) const {
+    // Same binary search as hull::contains(), decoding only the vertices it visits:
+    const unsigned long n = vertexCount();
+    if (n == 0) return false;
+    const Point O = vertex(0);
+
+    // Special cases:
+    if (n == 1) return P == O;
+    if (n == 2) return isInSegment(P, {O, vertex(1)});
+
+    unsigned long left = 1, right = n - 1;
+    while (right - left > 1) {
+        const unsigned long mid = (left + right)/2;
+        const Point M = vertex(mid);
+        if      (isClockwiseTurn(O, M, P))          left = mid;
+        else if (isCounterClockwiseTurn(O, M, P))   right = mid;
+        else return isInSegment(P, {O, M});
+    }
+
+    const Point leftVertex = vertex(left), rightVertex = vertex(right);
+    if (isCounterClockwiseTurn(O, leftVertex, P) or isCounterClockwiseTurn(leftVertex, rightVertex, P) or
+        isCounterClockwiseTurn(rightVertex, O, P)) return false;
+    if (isClockwiseTurn(O, leftVertex, P) and isClockwiseTurn(leftVertex, rightVertex, P) and
+        isClockwiseTurn(rightVertex, O, P)) return true;
+
+    // On the triangle's boundary: every edge and the bounding box are checked (see hull::contains())
+    for (unsigned long i = 0; i < n; ++i)
+        if (isCounterClockwiseTurn(vertex(i), vertex((i + 1)%n), P)) return false;
+    const Box box = boundingBox();
+    return numeric::leq(box.SW().x, P.x) and numeric::leq(P.x, box.NE().x) and
+           numeric::leq(box.SW().y, P.y) and numeric::leq(P.y, box.NE().y);
+}
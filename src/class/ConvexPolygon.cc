@@ -1,31 +1,114 @@
 #include "class/ConvexPolygon.h"
 
-#include <algorithm>  // std::sort
-#include <numeric>  // std::accumulate
+#include <algorithm>  // std::min_element, std::rotate, std::find, std::max
 #include <iterator>
-#include <boost/range/adaptors.hpp> // boost::adaptors::filter, ::sliced, ::uniqued
+#include <atomic>
+#include <cmath>  // std::abs
+#include <mutex>  // std::once_flag, std::call_once
+#include <boost/range/adaptors.hpp> // boost::adaptors::filter
 #include "geom.h"  // segment intersection
+#include "hull.h"  // hull algorithms and configuration
+#include "calipers.h"  // diameter, width and rectangle
+#include "class/ScratchArena.h"  // temporary buffers
+#include "class/ThreadPool.h"  // n-ary operations
 #include "details/utils.h"  // extend
+#include "details/numeric.h"
 
 using namespace geom;
 
 
+//-------- MEMOIZATION --------//
+
+// A value computed (only once) the first time it's needed:
+template<typename T>
+struct _Memo {
+    std::once_flag flag;
+    T value;
+
+    explicit _Memo(const T &initial = T()) : value(initial) {}
+
+    // Returns the value, computing it with `compute` if needed (and then sets `*computed`):
+    template<typename Compute>
+    const T &get(const Compute &compute, bool *computed = nullptr) {
+        std::call_once(flag, [&]{
+            value = compute();
+            if (computed) *computed = true;
+        });
+        return value;
+    }
+};
+
+/*
+ * The memoized derived properties of a polygon. It's shared between copies, and it's
+ * never modified other than by filling in its values (once each): a modified polygon
+ * drops its cache and starts a new one.
+ */
+struct ConvexPolygon::Cache {
+    _Memo<VertexArrays> arrays;
+    _Memo<double> area, perimeter;
+    _Memo<Point> centroid;
+    _Memo<Box> boundingBox{Box({0, 0}, {0, 0})};
+};
+
+static std::atomic<unsigned long> _cacheHits{0}, _cacheMisses{0};
+static std::atomic<unsigned long> _buffers{0}, _shares{0}, _copies{0};  // (see ConvexPolygon::StorageStats)
+
+// Gets a memoized metric, and counts the hit or miss:
+template<typename T, typename Compute>
+const T &_memoized(_Memo<T> &memo, const Compute &compute) {
+    bool computed = false;
+    const T &value = memo.get(compute, &computed);
+    (computed ? _cacheMisses : _cacheHits).fetch_add(1, std::memory_order_relaxed);
+    return value;
+}
+
+
+
 //-------- MEMBER FUNCTIONS --------//
 
 //---- Constructors ----//
 
-ConvexPolygon::ConvexPolygon(const Points &points) : vertices(ConvexHull(points)) {}
+ConvexPolygon::ConvexPolygon(const Points &points) { setVertices(Vertices(ConvexHull(points))); }
+
+ConvexPolygon::ConvexPolygon(Points &&points) { setVertices(Vertices(ConvexHull(move(points)))); }
 
-ConvexPolygon::ConvexPolygon(Points &&points) : vertices(ConvexHull(move(points))) {}
+ConvexPolygon ConvexPolygon::fromHull(Points vertices, bool trusted) {
+    Vertices hullVertices(move(vertices));  // (copied inline if small enough)
+    ConvexPolygon pol;
+    if (hullVertices.empty()) return pol;
+    hullVertices.push_back(hullVertices.front());  // complete the cycle
+
+    if (not trusted and not hull::isHull(hullVertices.data(), hullVertices.size()))
+        hullVertices = Vertices(ConvexHull(Points(std::move(hullVertices))));
+    pol.setVertices(std::move(hullVertices));
+    return pol;
+}
 
 ConvexPolygon::ConvexPolygon(const Box &box) {
     vertices = {box.SW(), box.NW(), box.NE(), box.SE(), box.SW()};
 }
 
+// Copies share the vertex buffer, if any, and the cache (read atomically, since another
+// thread might be creating it for `other`):
+ConvexPolygon::ConvexPolygon(const ConvexPolygon &other) :
+        vertices(other.vertices), shared(other.shared), color(other.color), cache(std::atomic_load(&other.cache)) {
+    if (shared) _shares.fetch_add(1, std::memory_order_relaxed);
+}
+
+ConvexPolygon &ConvexPolygon::operator=(const ConvexPolygon &other) {
+    vertices = other.vertices;
+    shared = other.shared;
+    color = other.color;
+    cache = std::atomic_load(&other.cache);
+    if (shared) _shares.fetch_add(1, std::memory_order_relaxed);
+    return *this;
+}
+
 
 //---- Info functions ----//
 
 unsigned long ConvexPolygon::vertexCount() const {
+    const Vertices &vertices = getVertices();
     if (vertices.empty()) return 0;
     return vertices.size() - 1;
     // we subtract 1 because of the repeated element at the end
@@ -34,75 +117,239 @@ unsigned long ConvexPolygon::vertexCount() const {
 double ConvexPolygon::area() const {
     if (empty()) return 0;
 
-    // We use the shoelace formula for calculating the area
-    double sum = 0;
-    const auto end = vertices.end() - 1;
-    for (auto it = vertices.begin(); it < end; ++it)
-        sum += (it[1].x - it[0].x)*(it[1].y + it[0].y);  // shoelace formula
-    return std::abs(sum/2);
+    return _memoized(getCache().area, [this]{
+        // We use the shoelace formula for calculating the area
+        const VertexArrays &soa = getVertexArrays();
+        return std::abs(shoelaceSum(soa.x.data(), soa.y.data(), vertexCount())/2);
+    });
 }
 
 double ConvexPolygon::perimeter() const {
     if (empty()) return 0;
     // avoid adding the same edge twice if the polygon is a segment:
-    if (vertexCount() == 2) return (vertices[1] - vertices[0]).norm();
+    if (vertexCount() == 2) return (getVertices()[1] - getVertices()[0]).norm();
 
-    double sum = 0;
-    const auto end = vertices.end() - 1;
-    for (auto it = vertices.begin(); it < end; ++it)
-        sum += distance(it[0], it[1]);
-    return sum;
+    return _memoized(getCache().perimeter, [this]{
+        const VertexArrays &soa = getVertexArrays();
+        return chainLength(soa.x.data(), soa.y.data(), vertexCount());
+    });
 }
 
 Point ConvexPolygon::centroid() const {
-    // return the barycenter of first through last points (without the duplicate):
-    return barycenter(vertices | boost::adaptors::sliced(0, vertexCount()));
+    if (empty()) throw error::ValueError("centroid undefined for 0-gon");
+
+    return _memoized(getCache().centroid, [this]{
+        // the barycenter of first through last points (without the duplicate):
+        const VertexArrays &soa = getVertexArrays();
+        const Point sum = coordinateSum(soa.x.data(), soa.y.data(), vertexCount());
+        return Point{sum.x/vertexCount(), sum.y/vertexCount()};
+    });
 }
 
 Box ConvexPolygon::boundingBox() const {
-    if (vertices.empty()) throw error::ValueError("bounding box undefined for 0-gon");
+    if (empty()) throw error::ValueError("bounding box undefined for 0-gon");
+
+    return _memoized(getCache().boundingBox, [this]{
+        // SW: south-west; NE: north-east; etc.
+        const VertexArrays &soa = getVertexArrays();
+        Point SW, NE;
+        coordinateBounds(soa.x.data(), soa.y.data(), vertexCount(), SW, NE);
+        return Box(SW, NE);
+    });
+}
 
-    // SW: south-west; NE: north-east; etc.
-    Point SW = accumulate(vertices.begin(), vertices.end(), vertices.front(), bottomLeft);
-    Point NE = accumulate(vertices.begin(), vertices.end(), vertices.front(), upperRight);
 
-    return Box(SW, NE);
+//---- Getters ----//
+
+const VertexArrays &ConvexPolygon::getVertexArrays() const {
+    return getCache().arrays.get([this]{
+        const Vertices &vertices = getVertices();
+        VertexArrays soa;
+        soa.x.resize(vertices.size());
+        soa.y.resize(vertices.size());
+        for (unsigned long i = 0; i < vertices.size(); ++i) soa.x[i] = vertices[i].x, soa.y[i] = vertices[i].y;
+        return soa;
+    });
 }
 
 
+//---- Memoization ----//
+
+ConvexPolygon::Cache &ConvexPolygon::getCache() const {
+    std::shared_ptr<Cache> current = std::atomic_load(&cache);
+    if (current) return *current;
+
+    // If another thread got there first, keep its cache (ours is discarded):
+    auto created = std::make_shared<Cache>();
+    if (std::atomic_compare_exchange_strong(&cache, &current, created)) return *created;
+    return *current;
+}
+
+ConvexPolygon::CacheStats ConvexPolygon::cacheStats() {
+    return {_cacheHits.load(), _cacheMisses.load()};
+}
+
+void ConvexPolygon::resetCacheStats() {
+    _cacheHits = 0;
+    _cacheMisses = 0;
+}
+
+
+//---- Vertex storage ----//
+
+// Takes the vertices out, to be modified and then put back with setVertices(): they're
+// moved out if no other polygon shares them, and copied otherwise
+Vertices ConvexPolygon::takeVertices() {
+    if (not shared) return std::move(vertices);
+    if (shared.use_count() == 1) return std::move(*shared);  // (the empty buffer is reused by setVertices())
+
+    _copies.fetch_add(1, std::memory_order_relaxed);
+    Vertices copy = *shared;
+    shared.reset();
+    return copy;
+}
+
+// Stores new vertices: inline if they fit, and in a buffer of their own otherwise
+void ConvexPolygon::setVertices(Vertices &&newVertices) {
+    if (newVertices.isInline()) {
+        vertices = std::move(newVertices);
+        shared.reset();
+        return;
+    }
+    vertices.clear();
+    if (shared and shared.use_count() == 1) *shared = std::move(newVertices);
+    else {
+        shared = std::make_shared<Vertices>(std::move(newVertices));
+        _buffers.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+ConvexPolygon::StorageStats ConvexPolygon::storageStats() {
+    return {_buffers.load(), _shares.load(), _copies.load()};
+}
+
+void ConvexPolygon::resetStorageStats() {
+    _buffers = 0;
+    _shares = 0;
+    _copies = 0;
+}
+
+
+
+//---- Modifiers ----//
+
+bool ConvexPolygon::insert(const Point &P) {
+    if (isInside(P, *this)) return false;
+    cache.reset();  // the memoized properties are out of date
+
+    const unsigned long n = vertexCount();
+    Vertices vertices = takeVertices();  // (copied if they're shared)
+    const unsigned long after = n < 3 ? 0 : hull::tangent(P, vertices.data(), n);
+    const unsigned long before = n < 3 ? 0 : hull::tangent(P, vertices.data(), n, true);
+    if (before == after) {  // degenerate polygon (or numerically ill-conditioned case): just rebuild it
+        vertices.push_back(P);
+        setVertices(Vertices(ConvexHull(Points(std::move(vertices)))));
+        return true;
+    }
+
+    /*
+     * P is outside, so it sees a chain of edges from its outside; the new hull goes
+     * from the start of that chain (`before`) to P and then to its end (`after`),
+     * and the vertices in between are removed. The new first vertex (the lowest one
+     * in comp::xCoord order) is either the old one or P. If the old one is removed,
+     * it can only be because P is the new first vertex.
+     */
+    const auto begin = vertices.begin();
+    vertices.pop_back();  // open the cycle (we close it again at the end)
+
+    if (before < after) {
+        if (after - before >= 2) {
+            begin[before + 1] = P;
+            vertices.erase(begin + before + 2, begin + after);
+        }
+        else vertices.insert(begin + after, P);
+
+        if (comp::xCoord(P, vertices.front()))
+            std::rotate(vertices.begin(), vertices.begin() + before + 1, vertices.end());
+    }
+    else {
+        // The chain wraps around the end of the array:
+        vertices.erase(begin + before + 1, vertices.end());
+        if (after > 0) {  // the first vertex is removed: P takes its place
+            begin[after - 1] = P;
+            vertices.erase(begin, begin + after - 1);
+        }
+        else {
+            vertices.push_back(P);
+            if (comp::xCoord(P, vertices.front()))
+                std::rotate(vertices.begin(), vertices.end() - 1, vertices.end());
+        }
+    }
+
+    // With nearly collinear vertices, the tolerance of the turn tests can leave a vertex at either
+    // joint where the new hull doesn't turn clockwise (which the monotone chain would have dropped):
+    unsigned long p = std::find(vertices.begin(), vertices.end(), P) - vertices.begin();
+    bool pruned = false;
+    while (vertices.size() > 3) {
+        const unsigned long m = vertices.size(), prev = (p + m - 1)%m, next = (p + 1)%m;
+        unsigned long removed;
+        if (not isClockwiseTurn(vertices[(prev + m - 1)%m], vertices[prev], P)) removed = prev;
+        else if (not isClockwiseTurn(P, vertices[next], vertices[(next + 1)%m])) removed = next;
+        else break;
+        vertices.erase(vertices.begin() + removed);
+        if (removed < p) --p;
+        pruned = true;
+    }
+    if (pruned)  // (the first vertex may have been removed)
+        std::rotate(vertices.begin(), std::min_element(vertices.begin(), vertices.end(), comp::xCoord), vertices.end());
+
+    vertices.push_back(vertices.front());  // complete the cycle
+    setVertices(std::move(vertices));
+    return true;
+}
+
 
 //-------- STATIC FUNCTIONS --------//
 
 /*
- * Calculates the convex hull of a sequence of points with the
- * Graham scan algorithm. Complexity is O(n*log(n)). Returns an empty
- * vector if the input vector is empty.
+ * Calculates the convex hull of a sequence of points, after culling interior
+ * points with the Akl-Toussaint heuristic. The algorithm is the one set in
+ * hull::Config: either Andrew's monotone chain (in parallel for large inputs)
+ * or Chan's output-sensitive algorithm, or one of them chosen by hull::choose().
+ * Complexity is O(n*log(n)). Returns an empty vector if the input vector is empty.
  */
 Points ConvexPolygon::ConvexHull(Points points) {
-    if (points.empty()) return {};
+    const hull::Config &config = hull::config();
+    if (points.size() >= config.filterThreshold) hull::aklToussaintFilter(points);
 
-    const auto begin = points.begin(), end = points.end();  // aliases
-    // Get point with lowest y coordinate:
-    const Point P0 = *min_element(begin, end, comp::xCoord);
-    // Sort the points in decreasing order of the angle they form with x-axis (relative to P0):
-    sort(begin, end, comp::yAngle{P0});
-
-    // Graham scan:
-    Points hull;
-    for (const Point &P : points | boost::adaptors::uniqued) {  // the uniqued adaptor skips duplicates
-        while (hull.size() >= 2 and not isClockwiseTurn(hull.end()[-2], hull.end()[-1], P))
-            hull.pop_back();
-        hull.push_back(P);
-    }
+    hull::Algorithm algorithm = config.algorithm;
+    if (algorithm == hull::Algorithm::automatic) algorithm = hull::choose(points);
 
-    hull.push_back(hull.front());  // complete the cycle
-    return hull;
+    if (algorithm == hull::Algorithm::chan)
+        return hull::chan(move(points));
+    if (points.size() >= config.parallelThreshold)
+        return hull::parallelMonotoneChain(move(points));
+    return hull::monotoneChain(move(points));
 }
 
 
 
 //-------- ASSOCIATED NONMEMBER FUNCTIONS --------//
 
+/*
+ * Polygon with the vertices returned by one of the hull algorithms (hull::merge(),
+ * hull::minkowskiSum(), calipers::minAreaRectangle(), etc.), which end by repeating the
+ * first vertex: it's dropped, since fromHull() repeats it again (so there's room for it).
+ * If not `trusted`, the vertices are checked by fromHull() (e.g. in case rounding broke
+ * their convexity).
+ */
+inline
+ConvexPolygon _fromClosedChain(Points &&vertices, bool trusted = true) {
+    if (not vertices.empty()) vertices.pop_back();
+    return ConvexPolygon::fromHull(move(vertices), trusted);
+}
+
+
 Box boundingBox(ConstRange<ConvexPolygon> polygons) {
     // skip empty polygons, and if after filtering, polygons is empty, throw an error
     polygons = boost::adaptors::filter(polygons, [](const ConvexPolygon &pol){ return not pol.empty(); });
@@ -123,56 +370,145 @@ Box boundingBox(ConstRange<ConvexPolygon> polygons) {
 //---- isInside ----//
 
 bool isInside(const Point &P, const ConvexPolygon &pol) {
-    if (pol.empty()) return false;
+    return hull::contains(P, pol.getVertices().data(), pol.vertexCount());
+}
 
-    const Points &vertices = pol.getVertices();
-    const Point &O = vertices[0];
 
-    // Special cases:
-    if (pol.vertexCount() == 1) return P == O;
-    if (pol.vertexCount() == 2) return isInSegment(P, {O, vertices[1]});
+bool isInside(const ConvexPolygon &pol1, const ConvexPolygon &pol2) {
+    const unsigned long m = pol1.vertexCount(), n = pol2.vertexCount();
+    const Point *W = pol1.getVertices().data(), *V = pol2.getVertices().data();
+    if (m == 0) return true;
+    if (n == 0) return false;
+
+    // Quick rejection by extents (unless the vertices of pol1 are to be located one by one
+    // anyway, see hull::contains, since pol2's bounding box might not be memoized yet):
+    if (n >= 3 and m*hull::CONTAINS_SEARCH_RATIO > n) {
+        const Box box1 = pol1.boundingBox(), box2 = pol2.boundingBox();
+        if (numeric::less(box1.SW().x, box2.SW().x) or numeric::less(box1.SW().y, box2.SW().y)
+            or numeric::greater(box1.NE().x, box2.NE().x) or numeric::greater(box1.NE().y, box2.NE().y))
+            return false;
+    }
+    return hull::contains(V, n, W, m);
+}
 
 
-    /*
-     * Here we begin a binary search: given a fixed vertex O (in this case the
-     * first vertex), and starting with the two vertices that are adjacent to O,
-     * at every iteration we bisect the polygon by tracing a segment between O and the
-     * median of the left and right vertices; then, we test whether `P` is to the
-     * left or to the right of the bisector segment, and we update the indices
-     * accordingly. We end up with a triangle, one of whose edges lies on the polygon.
-     */
+// Margin around the edges within which _sweepByAngle() defers to hull::contains(), in units of the tolerance
+constexpr double _NEAR_EDGE = 4;
+
+/*
+ * Classifies points sorted clockwise by angle around an interior point C of a polygon, by
+ * walking the wedges with apex C (between the rays from C through consecutive vertices)
+ * along with the points. Gives up as soon as a point is counter-clockwise from the previous
+ * one, or if the walk goes around the polygon more than twice (a cost of O(n) at most).
+ * Returns the number of points that were classified (the first ones).
+ *
+ * Points near the edge of their wedge (closer than _NEAR_EDGE times the tolerance of the turn
+ * tests, be it as a cross product or as a distance) are located by hull::contains() instead,
+ * whose answer there depends on the path of its binary search: that way, a point gets the same
+ * result as with isInside(const Point &, const ConvexPolygon &), whatever the rest of the batch.
+ */
+inline
+unsigned long _sweepByAngle(const Point *V, unsigned long n, const Point &C,
+                            const Point *points, unsigned long k, bool *result) {
+    auto cross = [&C](const Point &A, const Point &B) { return crossProd(A - C, B - C); };
+    auto inWedge = [&](unsigned long i, const Point &P) {
+        return cross(V[i], P) <= 0 and cross(V[i + 1], P) >= 0;
+    };
+
+    unsigned long wedge = 0, steps = 0;
+    for (unsigned long j = 0; j < k; ++j) {
+        const Point &P = points[j];
+        if (j > 0 and cross(points[j - 1], P) > 0) return j;  // not sorted
+        while (not inWedge(wedge, P)) {
+            if (++steps > 2*n) return j;
+            wedge = (wedge + 1)%n;
+        }
+        const Vector2D edge = V[wedge + 1] - V[wedge];
+        const double turn = crossProd(edge, P - V[wedge]);
+        if (std::abs(turn) <= _NEAR_EDGE*numeric::EPSILON*std::max(1.0, edge.norm()))
+            result[j] = hull::contains(P, V, n);
+        else result[j] = turn < 0;
+    }
+    return k;
+}
 
-    unsigned long left = 1, right = pol.vertexCount() - 1;
-    while (right - left > 1) {
-        unsigned long mid = (left + right)/2;
-        if      (isClockwiseTurn(O, vertices[mid], P))          left = mid;
-        else if (isCounterClockwiseTurn(O, vertices[mid], P))   right = mid;
-        else return isInSegment(P, {O, vertices[mid]});
+
+void isInside(const Point *points, unsigned long k, const ConvexPolygon &pol, bool *result) {
+    const unsigned long n = pol.vertexCount();
+    const Point *V = pol.getVertices().data();
+
+    // A few points are located one by one (pol's vertex arrays might not be memoized yet):
+    if (n < 3 or k*hull::CONTAINS_SEARCH_RATIO <= n) {
+        for (unsigned long i = 0; i < k; ++i) result[i] = hull::contains(points[i], V, n);
+        return;
     }
 
-    // Return whether P is in the final triangle, by testing if P is on the right side of each edge:
-    const Point &leftVertex = vertices[left], &rightVertex = vertices[right];
-    return not isCounterClockwiseTurn(O, leftVertex, P) and
-           not isCounterClockwiseTurn(leftVertex, rightVertex, P) and
-           not isCounterClockwiseTurn(rightVertex, O, P);
+    // Points sorted by angle around the centroid are swept (as long as they are):
+    unsigned long swept = 0;
+    if (k >= n) swept = _sweepByAngle(V, n, pol.centroid(), points, k, result);
+
+    const VertexArrays &arrays = pol.getVertexArrays();
+    insideConvexPolygon(arrays.x.data(), arrays.y.data(), n, points + swept, k - swept, result + swept);
 }
 
 
-bool isInside(const ConvexPolygon &pol1, const ConvexPolygon &pol2) {
-    const Points &vertices1 = pol1.getVertices();
-    for (const Point &P : vertices1)
-        if (not isInside(P, pol2)) return false;
-    return true;
+//---- Intersection test ----//
+
+bool intersects(const ConvexPolygon &pol1, const ConvexPolygon &pol2) {
+    return hull::intersects(pol1.getVertices().data(), pol1.vertexCount(),
+                            pol2.getVertices().data(), pol2.vertexCount());
+}
+
+
+//---- Distance ----//
+
+double distance(const Point &P, const ConvexPolygon &pol) {
+    return hull::distance(P, pol.getVertices().data(), pol.vertexCount());
+}
+
+void distance(const Point *points, unsigned long k, const ConvexPolygon &pol, double *result) {
+    if (pol.empty()) throw error::ValueError("distance undefined for 0-gon");
+    std::unique_ptr<bool[]> inside(new bool[k]);
+    isInside(points, k, pol, inside.get());
+    for (unsigned long i = 0; i < k; ++i)
+        result[i] = inside[i] ? 0 : hull::distance(points[i], pol.getVertices().data(), pol.vertexCount());
+}
+
+double distance(const ConvexPolygon &pol1, const ConvexPolygon &pol2) {
+    return hull::distance(pol1.getVertices().data(), pol1.vertexCount(),
+                          pol2.getVertices().data(), pol2.vertexCount());
+}
+
+
+//---- Minkowski sum ----//
+
+ConvexPolygon minkowskiSum(const ConvexPolygon &pol1, const ConvexPolygon &pol2) {
+    const Vertices &v1 = pol1.getVertices(), &v2 = pol2.getVertices();
+    return _fromClosedChain(hull::minkowskiSum(v1.data(), pol1.vertexCount(), v2.data(), pol2.vertexCount()), false);
+}
+
+
+//---- Rotating calipers ----//
+
+Segment diameter(const ConvexPolygon &pol) {
+    return calipers::diameter(pol.getVertices().data(), pol.vertexCount());
+}
+
+Segment width(const ConvexPolygon &pol) {
+    return calipers::width(pol.getVertices().data(), pol.vertexCount());
+}
+
+ConvexPolygon minAreaRectangle(const ConvexPolygon &pol) {
+    return _fromClosedChain(calipers::minAreaRectangle(pol.getVertices().data(), pol.vertexCount()));
 }
 
 
 //---- Convex union ----//
 
 ConvexPolygon convexUnion(const ConvexPolygon &pol1, const ConvexPolygon &pol2) {
-    // We simply merge the vertices and calculate the convex hull:
-    Points points;
-    extend(points, pol1.getVertices(), pol2.getVertices());
-    return ConvexPolygon(move(points));
+    // Both vertex sequences are already hulls, so we merge them (see hull::merge):
+    const Vertices &v1 = pol1.getVertices(), &v2 = pol2.getVertices();
+    return _fromClosedChain(hull::merge(v1.data(), pol1.vertexCount(), v2.data(), pol2.vertexCount()));
 }
 
 
@@ -191,10 +527,10 @@ ConvexPolygon operator|(const ConvexPolygon &polA, const ConvexPolygon &polB) {
  */
 inline
 void _intersectionSweepLine(const ConvexPolygon &pol1, const ConvexPolygon &pol2,
-                            Points &intersectionPoints) {
+                            ScratchVector<Point> &intersectionPoints) {
 
     // aliases:
-    const Points &v1 = pol1.getVertices(), &v2 = pol2.getVertices();
+    const Vertices &v1 = pol1.getVertices(), &v2 = pol2.getVertices();
 
     /*
      * Throughout the algorithm, we keep track of two edges on each polygon:
@@ -231,14 +567,28 @@ void _intersectionSweepLine(const ConvexPolygon &pol1, const ConvexPolygon &pol2
      * between the four pairs of segments, and then we increment the edge (represented
      * by an iterator to its start-point) which has the end-point with the lowest `x`
      * coordinate (hence the "sweepline"; it's like advancing a vertical line from left to
-     * right). We stop when we reach either polygon's rightmost vertex --- which happens
-     * when both iterators (one from the top and one from the bottom) coincide.
+     * right). An edge can't advance past its polygon's rightmost vertex (where the
+     * top and bottom chains meet), so we stop as soon as the edge with the lowest
+     * end-point is already the last one of its chain: by then the sweepline has reached
+     * that polygon's rightmost vertex and there are no intersections left to find.
      */
 
-    while (not (it1Top == it1Bottom.base() or it2Top == it2Bottom.base())) {
-        // Fond out the edge whose end point has the lowest x coordinate:
-        double xCoords[4] = {it1Top[1].x, it1Bottom[1].x, it2Top[1].x, it2Bottom[1].x};
-        unsigned minIndex = std::min_element(std::begin(xCoords), std::end(xCoords)) - std::begin(xCoords);
+    // Rightmost vertices, where the top and bottom chains of each polygon end:
+    const Point *last1 = &*std::max_element(v1.begin(), v1.end() - 1, comp::xCoord);
+    const Point *last2 = &*std::max_element(v2.begin(), v2.end() - 1, comp::xCoord);
+
+    while (true) {
+        // Find out the edge whose end point has the lowest x coordinate:
+        const Point *endPoints[4] = {&it1Top[1], &it1Bottom[1], &it2Top[1], &it2Bottom[1]};
+        const bool exhausted[4] = {endPoints[0] == last1, endPoints[1] == last1,
+                                   endPoints[2] == last2, endPoints[3] == last2};
+        unsigned minIndex = 0;
+        for (unsigned i = 1; i < 4; ++i) {
+            double x = endPoints[i]->x, minX = endPoints[minIndex]->x;
+            // in case of a tie, prefer an edge that can still advance
+            if (x < minX or (x == minX and exhausted[minIndex] and not exhausted[i])) minIndex = i;
+        }
+        if (exhausted[minIndex]) break;
 
         // Increment the corresponding iterator and calculate new intersections:
         IntersectResult ints[2];  // potential new intersection points
@@ -254,11 +604,16 @@ void _intersectionSweepLine(const ConvexPolygon &pol1, const ConvexPolygon &pol2
 }
 
 
-ConvexPolygon intersection(const ConvexPolygon &pol1, const ConvexPolygon &pol2) {
-    if (pol1.empty() or pol2.empty()) return {};
-
-    Points intersectionPoints;
-    const Points &v1 = pol1.getVertices(), &v2 = pol2.getVertices();
+/*
+ * General (but quasilinear) method for `intersection`: the convex hull of the vertices
+ * of each polygon that are inside the other one and of the intersection points between
+ * their edges. Used for degenerate cases, where the boundary walk below doesn't apply.
+ */
+inline
+ConvexPolygon _intersectionByHull(const ConvexPolygon &pol1, const ConvexPolygon &pol2) {
+    ScratchArena::Scope scratch;
+    ScratchVector<Point> intersectionPoints(scratch.resource());
+    const Vertices &v1 = pol1.getVertices(), &v2 = pol2.getVertices();
 
     // Find the vertices of one polygon that are inside the other, in O(m·log(n)) each:
     for (const Point &P : v1)
@@ -271,7 +626,175 @@ ConvexPolygon intersection(const ConvexPolygon &pol1, const ConvexPolygon &pol2)
         _intersectionSweepLine(pol1, pol2, intersectionPoints);
 
     // Return the convex hull of all the intersection points:
-    return ConvexPolygon(move(intersectionPoints));
+    return _fromClosedChain(hull::monotoneChain(intersectionPoints.data(), intersectionPoints.size()));
+}
+
+
+// Orientation of a turn: 1 if clockwise, -1 if counter-clockwise, 0 if neither (see geom::isClockwiseTurn)
+inline
+int _turn(const Vector2D &u, const Vector2D &v) {
+    const double cross = crossProd(u, v);
+    if (numeric::less(cross, 0)) return 1;
+    if (numeric::greater(cross, 0)) return -1;
+    return 0;
+}
+
+inline
+int _turn(const Point &A, const Point &B, const Point &C) { return _turn(B - A, C - A); }
+
+
+/*
+ * Intersection of the segments AB and CD (for the boundary walk below). Returns
+ * '1' if they cross at a single point interior to both, 'v' if they meet at a single
+ * point that is an endpoint of one of them, 'e' if they are collinear and overlap,
+ * and '0' if they don't intersect. In the first two cases, sets `X` to the point.
+ */
+inline
+char _segmentIntersection(const Point &A, const Point &B, const Point &C, const Point &D, Point &X) {
+    const Vector2D r = B - A, q = D - C, w = C - A;
+    const double denominator = crossProd(r, q);
+    if (denominator == 0) {  // parallel
+        if (_turn(A, B, C) != 0) return '0';
+        // Collinear: check whether the projections on AB overlap
+        const double length = dotProd(r, r), c = dotProd(w, r), d = dotProd(D - A, r);
+        return std::max(c, d) < 0 or std::min(c, d) > length ? '0' : 'e';
+    }
+
+    // A + s·r = C + t·q, with 0 <= s, t <= 1
+    const double sNumerator = crossProd(w, q), tNumerator = crossProd(w, r);
+    const double s = sNumerator/denominator, t = tNumerator/denominator;
+    if (s < 0 or s > 1 or t < 0 or t > 1) return '0';
+
+    X = {A.x + s*r.x, A.y + s*r.y};
+    const bool atEndpoint = sNumerator == 0 or sNumerator == denominator
+                            or tNumerator == 0 or tNumerator == denominator;
+    return atEndpoint ? 'v' : '1';
+}
+
+
+/*
+ * Internal subroutine for `intersection`: walks the boundaries of both polygons at the
+ * same time, advancing one edge or the other, as in the algorithm by O'Rourke, Chien,
+ * Olson and Naddor (1982). Each edge "chases" the other one, and the inner chain between
+ * two consecutive crossings of the boundaries is written out as they are found, so the
+ * vertices of the intersection come out in order (clockwise, as the input), in O(n + m).
+ *
+ * Returns false (leaving `result` in an unspecified state) if the boundaries don't cross:
+ * the polygons are then disjoint, or one of them contains the other, or they only touch.
+ * Both polygons must have at least three vertices.
+ */
+inline
+bool _intersectionWalk(const ConvexPolygon &pol1, const ConvexPolygon &pol2, ScratchVector<Point> &result) {
+    const Point *P = pol1.getVertices().data(), *Q = pol2.getVertices().data();
+    const unsigned long n = pol1.vertexCount(), m = pol2.vertexCount();
+
+    /*
+     * The current edges end at P[a] and Q[b]. The orientation tests are the mirror image
+     * of those in the original (counter-clockwise) algorithm: the inside of each edge is
+     * to its right.
+     */
+    enum { unknown, firstInside, secondInside } inside = unknown;
+    unsigned long a = 0, b = 0, aAdvances = 0, bAdvances = 0;
+    auto advanceA = [&]{
+        if (inside == firstInside) result.push_back(P[a]);
+        a = (a + 1)%n, ++aAdvances;
+    };
+    auto advanceB = [&]{
+        if (inside == secondInside) result.push_back(Q[b]);
+        b = (b + 1)%m, ++bAdvances;
+    };
+
+    do {
+        const Point &A0 = P[(a + n - 1)%n], &A1 = P[a], &B0 = Q[(b + m - 1)%m], &B1 = Q[b];
+        const Vector2D A = A1 - A0, B = B1 - B0;
+        const int cross = _turn(A, B);  // > 0 if B turns clockwise from A
+        const int aInB = _turn(B0, B1, A1), bInA = _turn(A0, A1, B1);  // > 0 if inside
+
+        Point X;
+        const char code = _segmentIntersection(A0, A1, B0, B1, X);
+        if (code == '1' or code == 'v') {
+            if (inside == unknown) aAdvances = bAdvances = 0;  // go around once more from here
+            result.push_back(X);
+            if (aInB > 0) inside = firstInside;
+            else if (bInA > 0) inside = secondInside;
+        }
+
+        if (code == 'e' and dotProd(A, B) < 0) return false;  // touching along opposite edges
+        if (cross == 0 and aInB < 0 and bInA < 0) {  // opposite edges, with nothing in between
+            result.clear();
+            return true;
+        }
+
+        if (cross == 0 and aInB == 0 and bInA == 0) {  // collinear edges: advance the outer one
+            if (inside == firstInside) advanceB();
+            else advanceA();
+        }
+        else if (cross >= 0) {
+            if (bInA > 0) advanceA();
+            else advanceB();
+        }
+        else {
+            if (aInB > 0) advanceB();
+            else advanceA();
+        }
+    } while ((aAdvances < n or bAdvances < m) and aAdvances < 2*n and bAdvances < 2*m);
+
+    return inside != unknown;
+}
+
+
+/*
+ * Turns the output of `_intersectionWalk` into the vertices of a polygon in the format
+ * of ConvexPolygon::fromHull(): starting with the lowest vertex in comp::xCoord order, and
+ * without the duplicate and collinear points left at the crossings. Linear time.
+ */
+inline
+Points _hullOrder(ScratchVector<Point> &points) {
+    if (points.empty()) return {};
+    std::rotate(points.begin(), std::min_element(points.begin(), points.end(), comp::xCoord), points.end());
+
+    ScratchVector<Point> vertices(points.get_allocator());
+    vertices.reserve(points.size());
+    for (const Point &P : points) {
+        while (vertices.size() >= 2 and not isClockwiseTurn(vertices.end()[-2], vertices.back(), P))
+            vertices.pop_back();
+        if (vertices.empty() or vertices.back() != P) vertices.push_back(P);
+    }
+    // Close the cycle:
+    while (vertices.size() >= 3 and not isClockwiseTurn(vertices.end()[-2], vertices.back(), vertices.front()))
+        vertices.pop_back();
+
+    Points result;
+    result.reserve(vertices.size() + 1);  // (with room for the first vertex, which fromHull() repeats)
+    result.assign(vertices.begin(), vertices.end());
+    return result;
+}
+
+
+ConvexPolygon intersection(const ConvexPolygon &pol1, const ConvexPolygon &pol2) {
+    if (pol1.empty() or pol2.empty()) return {};
+    if (pol1.vertexCount() < 3 or pol2.vertexCount() < 3) return _intersectionByHull(pol1, pol2);
+
+    // Disjoint bounding boxes:
+    const Box box1 = pol1.boundingBox(), box2 = pol2.boundingBox();
+    if (box1.NE().x < box2.SW().x or box2.NE().x < box1.SW().x
+        or box1.NE().y < box2.SW().y or box2.NE().y < box1.SW().y) return {};
+
+    ScratchArena::Scope scratch;
+    ScratchVector<Point> walk(scratch.resource());
+    if (_intersectionWalk(pol1, pol2, walk)) {
+        // (fromHull() checks the result, and takes its convex hull in the rare case it's off)
+        return ConvexPolygon::fromHull(_hullOrder(walk));
+    }
+
+    // The boundaries don't cross, so one polygon might be inside the other:
+    for (const ConvexPolygon *inner : {&pol1, &pol2}) {
+        if (not isInside(*inner, inner == &pol1 ? pol2 : pol1)) continue;
+        ConvexPolygon result = *inner;
+        result.setColor(RGBColor());
+        return result;
+    }
+    return _intersectionByHull(pol1, pol2);  // disjoint, or touching
 }
 
 
@@ -281,9 +804,98 @@ ConvexPolygon operator&(const ConvexPolygon &pol1, const ConvexPolygon &pol2) {
 
 
 
+//---- N-ary operations ----//
+
+typedef ConvexPolygon (*_BinaryOperation)(const ConvexPolygon &, const ConvexPolygon &);
+
+// Waits for a task submitted to a pool when it goes out of scope, unless it's been waited for
+// already (i.e., if an exception is thrown in the meantime, since the task might still be
+// using the variables of the frame that's being unwound). The task's exception is ignored.
+template<typename T>
+struct _TaskGuard {
+    ThreadPool &pool;
+    std::future<T> &future;
+
+    ~_TaskGuard() {
+        if (not future.valid()) return;
+        try { pool.get(future); }
+        catch (...) {}
+    }
+};
+
+
+/*
+ * Reduces the polygons in [first, last) with a binary operation, as a balanced tree.
+ * `vertexSums[i]` is the total number of vertices of the first `i` polygons: the left
+ * half of big subtrees is reduced in a worker thread. If `empty` is given, subtrees
+ * are skipped once any partial result is empty (which is then the final result).
+ */
+inline
+ConvexPolygon _reduce(const ScratchVector<const ConvexPolygon *> &polygons, unsigned long first, unsigned long last,
+                      _BinaryOperation operation, const ScratchVector<unsigned long> &vertexSums,
+                      std::atomic<bool> *empty) {
+    if (empty and *empty) return {};
+    if (last - first == 1) {
+        ConvexPolygon result = *polygons[first];
+        result.setColor(RGBColor());  // (just as the results of binary operations)
+        return result;
+    }
+
+    ConvexPolygon result;
+    if (last - first == 2) result = operation(*polygons[first], *polygons[first + 1]);
+    else {
+        const unsigned long middle = first + (last - first)/2;
+        auto reduceLeft = [&]{ return _reduce(polygons, first, middle, operation, vertexSums, empty); };
+        if (vertexSums[last] - vertexSums[first] < ops::PARALLEL_THRESHOLD) {
+            ConvexPolygon left = reduceLeft();
+            result = operation(left, _reduce(polygons, middle, last, operation, vertexSums, empty));
+        }
+        else {
+            ThreadPool &pool = ThreadPool::shared();
+            auto left = pool.submit(reduceLeft);
+            _TaskGuard<ConvexPolygon> guard{pool, left};  // (reduceLeft refers to this frame's arguments)
+            ConvexPolygon right = _reduce(polygons, middle, last, operation, vertexSums, empty);
+            result = operation(pool.get(left), right);
+        }
+    }
+    if (empty and result.empty()) *empty = true;
+    return result;
+}
+
+
+// Prepares the operands of _reduce() and runs it over the whole range
+// (the operands are only read by the worker threads, so they can come from this thread's arena)
+inline
+ConvexPolygon _reduce(ConstRange<ConvexPolygon> polygons, _BinaryOperation operation, std::atomic<bool> *empty) {
+    ScratchArena::Scope scratch;
+    ScratchVector<const ConvexPolygon *> operands(scratch.resource());
+    ScratchVector<unsigned long> vertexSums(1, 0, scratch.resource());
+    for (const ConvexPolygon &pol : polygons) {
+        operands.push_back(&pol);
+        vertexSums.push_back(vertexSums.back() + pol.vertexCount());
+    }
+    if (operands.empty()) return {};
+    return _reduce(operands, 0, operands.size(), operation, vertexSums, empty);
+}
+
+
+ConvexPolygon convexUnion(ConstRange<ConvexPolygon> polygons) {
+    return _reduce(polygons, convexUnion, nullptr);
+}
+
+
+ConvexPolygon intersection(ConstRange<ConvexPolygon> polygons) {
+    if (polygons.empty()) throw error::ValueError("intersection undefined for empty set");
+    std::atomic<bool> empty(false);
+    return _reduce(polygons, intersection, &empty);
+}
+
+
+
 //---- Equality operators ----//
 
 bool operator==(const ConvexPolygon &lhs, const ConvexPolygon &rhs) {
+    if (&lhs.getVertices() == &rhs.getVertices()) return true;  // (copies that share their vertices)
     return lhs.getVertices() == rhs.getVertices();
 }
 
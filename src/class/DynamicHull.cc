@@ -0,0 +1,309 @@
+#include "class/DynamicHull.h"
+
+#include <algorithm>  // std::sort, std::max
+#include "geom.h"
+#include "details/numeric.h"
+
+using namespace geom;
+
+
+//-------- INTERNAL UTILITIES --------//
+
+// Whether A, B, C turns towards the inside of the upper hull (clockwise), or the inside of
+// the lower hull (counter-clockwise) if `lower`. Same as geom::isClockwiseTurn() and
+// geom::isCounterClockwiseTurn(), but inlined (this is the innermost operation of every update).
+inline
+bool _turnsInwards(const Point &A, const Point &B, const Point &C, bool lower) {
+    const double cross = (B.x - A.x)*(C.y - A.y) - (B.y - A.y)*(C.x - A.x);
+    return lower ? numeric::greater(cross, 0) : numeric::less(cross, 0);
+}
+
+// Whether A, B, C turns towards the outside of the upper/lower hull
+inline
+bool _turnsOutwards(const Point &A, const Point &B, const Point &C, bool lower) {
+    return _turnsInwards(A, B, C, not lower);
+}
+
+// Rescans a chain (sorted by x) as the monotone chain algorithm does, dropping the vertices
+// where it doesn't turn inwards: the tolerance of the turn tests can let the tree keep some
+// (nearly collinear ones) that a scan of the whole chain would have dropped
+inline
+void _prune(Points &chain, bool lower) {
+    unsigned long size = 0;
+    for (const Point &P : chain) {
+        while (size >= 2 and not _turnsInwards(chain[size - 2], chain[size - 1], P, lower)) --size;
+        chain[size++] = P;
+    }
+    chain.resize(size);
+}
+
+// A subtree is rebuilt when one of its children has more than this fraction of its leaves
+constexpr double _BALANCE = 0.75;
+
+
+
+//-------- MEMBER FUNCTIONS --------//
+
+DynamicHull::DynamicHull(Points points) : pointCount(points.size()) {
+    if (points.empty()) return;
+
+    std::sort(points.begin(), points.end(), comp::xCoord);
+    std::vector<unsigned long> leaves;
+    for (unsigned long i = 0; i < points.size(); ++i) {
+        if (i > 0 and not comp::xCoord(points[i - 1], points[i])) ++nodes[leaves.back()].count;  // duplicate
+        else {
+            Node leaf;
+            leaf.point = points[i];
+            leaves.push_back(newNode(leaf));
+        }
+    }
+    root = build(leaves, 0, leaves.size());
+}
+
+
+void DynamicHull::insert(const Point &P) {
+    ++pointCount;
+    Node leaf;
+    leaf.point = P;
+    if (root == NIL) {
+        root = newNode(leaf);
+        return;
+    }
+
+    std::vector<unsigned long> path;
+    unsigned long v = root;
+    while (not isLeaf(v)) {
+        path.push_back(v);
+        v = comp::xCoord(nodes[v].point, P) ? nodes[v].right : nodes[v].left;
+    }
+    if (not comp::xCoord(P, nodes[v].point) and not comp::xCoord(nodes[v].point, P)) {
+        ++nodes[v].count;  // already there; the hull doesn't change
+        return;
+    }
+
+    // Replace the leaf with an internal node whose children are the old leaf and the new one:
+    const unsigned long newLeaf = newNode(leaf);
+    Node parent;
+    const bool before = comp::xCoord(P, nodes[v].point);
+    parent.left = before ? newLeaf : v;
+    parent.right = before ? v : newLeaf;
+    parent.point = nodes[parent.left].point;
+    const unsigned long u = newNode(parent);
+
+    if (path.empty()) root = u;
+    else (nodes[path.back()].left == v ? nodes[path.back()].left : nodes[path.back()].right) = u;
+    path.push_back(u);
+
+    updatePath(path, P);
+    rebalance(path);
+}
+
+
+bool DynamicHull::erase(const Point &P) {
+    if (root == NIL) return false;
+
+    std::vector<unsigned long> path;
+    unsigned long v = root;
+    while (not isLeaf(v)) {
+        path.push_back(v);
+        v = comp::xCoord(nodes[v].point, P) ? nodes[v].right : nodes[v].left;
+    }
+    if (comp::xCoord(P, nodes[v].point) or comp::xCoord(nodes[v].point, P)) return false;
+
+    --pointCount;
+    if (--nodes[v].count > 0) return true;  // other copies are left; the hull doesn't change
+
+    // Remove the leaf, and replace its parent with its sibling:
+    freeNodes.push_back(v);
+    if (path.empty()) {
+        root = NIL;
+        return true;
+    }
+    const unsigned long parent = path.back();
+    const unsigned long sibling = nodes[parent].left == v ? nodes[parent].right : nodes[parent].left;
+    freeNodes.push_back(parent);
+    path.pop_back();
+
+    if (path.empty()) root = sibling;
+    else (nodes[path.back()].left == parent ? nodes[path.back()].left : nodes[path.back()].right) = sibling;
+
+    updatePath(path, P);
+    rebalance(path);
+    return true;
+}
+
+
+ConvexPolygon DynamicHull::polygon() const {
+    if (root == NIL) return {};
+
+    Points upper, lower;
+    chain(root, nullptr, nullptr, false, upper);
+    chain(root, nullptr, nullptr, true, lower);
+    _prune(upper, false);
+    _prune(lower, true);
+
+    // Both chains go from the leftmost point to the rightmost one:
+    Points &vertices = upper;
+    vertices.reserve(upper.size() + lower.size());  // (with room for the first vertex, which fromHull() repeats)
+    if (lower.size() > 2) vertices.insert(vertices.end(), lower.rbegin() + 1, lower.rend() - 1);
+    if (vertices.size() == 2 and vertices[0] == vertices[1]) vertices.pop_back();
+    return ConvexPolygon::fromHull(move(vertices), true);
+}
+
+
+
+//---- Tree maintenance ----//
+
+unsigned long DynamicHull::newNode(const Node &node) {
+    if (freeNodes.empty()) {
+        nodes.push_back(node);
+        return nodes.size() - 1;
+    }
+    const unsigned long v = freeNodes.back();
+    freeNodes.pop_back();
+    nodes[v] = node;
+    return v;
+}
+
+
+// Recomputes the size and the bridges of an internal node from its children
+void DynamicHull::update(unsigned long v) {
+    Node &node = nodes[v];
+    node.size = nodes[node.left].size + nodes[node.right].size;
+    node.upper = bridge(node.left, node.right, false);
+    node.lower = bridge(node.left, node.right, true);
+}
+
+
+/*
+ * Updates the nodes in a root-to-leaf path after inserting or removing P, bottom-up. If P
+ * is strictly inside the hull of a node's subtree (after the update), that hull is the same
+ * as before, and so are the bridges of every node above it: only their sizes change.
+ */
+void DynamicHull::updatePath(const std::vector<unsigned long> &path, const Point &P) {
+    auto it = path.rbegin();
+    for (; it != path.rend(); ++it) {
+        update(*it);
+        if (isInterior(P, *it, false) and isInterior(P, *it, true)) break;
+    }
+    for (; it != path.rend(); ++it) nodes[*it].size = nodes[nodes[*it].left].size + nodes[nodes[*it].right].size;
+}
+
+
+// Builds a perfectly balanced subtree over a sorted range of leaves, and returns its root
+unsigned long DynamicHull::build(const std::vector<unsigned long> &leaves, unsigned long first, unsigned long last) {
+    if (last - first == 1) return leaves[first];
+
+    const unsigned long middle = (first + last)/2;
+    Node node;
+    node.left = build(leaves, first, middle);
+    node.right = build(leaves, middle, last);
+    node.point = nodes[leaves[middle - 1]].point;
+    const unsigned long v = newNode(node);
+    update(v);
+    return v;
+}
+
+
+// Appends the leaves of a subtree in order, and frees its internal nodes
+void DynamicHull::collectLeaves(unsigned long v, std::vector<unsigned long> &leaves) {
+    if (isLeaf(v)) {
+        leaves.push_back(v);
+        return;
+    }
+    collectLeaves(nodes[v].left, leaves);
+    collectLeaves(nodes[v].right, leaves);
+    freeNodes.push_back(v);
+}
+
+
+// Rebuilds the highest node in a root-to-leaf path whose subtree is too unbalanced
+void DynamicHull::rebalance(const std::vector<unsigned long> &path) {
+    for (unsigned long i = 0; i < path.size(); ++i) {
+        const Node &node = nodes[path[i]];
+        const unsigned long heavier = std::max(nodes[node.left].size, nodes[node.right].size);
+        if (node.size < 4 or heavier <= _BALANCE*node.size) continue;
+
+        // The rebuilt subtree has the same points, so the ancestors' bridges don't change:
+        std::vector<unsigned long> leaves;
+        collectLeaves(path[i], leaves);
+        const unsigned long subtree = build(leaves, 0, leaves.size());
+        if (i == 0) root = subtree;
+        else (nodes[path[i - 1]].left == path[i] ? nodes[path[i - 1]].left : nodes[path[i - 1]].right) = subtree;
+        return;
+    }
+}
+
+
+
+//---- Hull queries ----//
+
+/*
+ * Finds the vertex of the upper (or lower) hull of a subtree where the tangent from A touches
+ * it, where A is to the left of every point in the subtree (in comp::xCoord order). In case
+ * of ties, the farthest one from A. Seen from A, the vertices of the hull first turn outwards
+ * and then inwards, so at each node the bridge tells which side the tangent is on.
+ */
+const Point &DynamicHull::tangentFrom(const Point &A, unsigned long v, bool lower) const {
+    while (not isLeaf(v)) {
+        const Bridge &bridge = lower ? nodes[v].lower : nodes[v].upper;
+        v = _turnsInwards(A, bridge.left, bridge.right, lower) ? nodes[v].left : nodes[v].right;
+    }
+    return nodes[v].point;
+}
+
+
+/*
+ * Finds the bridge between the upper (or lower) hulls of two subtrees, where every point
+ * in `left` precedes every point in `right`. We descend the left subtree looking for the
+ * bridge's left endpoint p: at every node, its bridge (a, b) is an edge of the hull of the
+ * node's subtree, which contains p. Let T be the tangent point from a to the right subtree's
+ * hull. If a is to the left of p, then b lies strictly outside of the line aT; otherwise,
+ * it doesn't. Finally, the right endpoint is the tangent point from p.
+ */
+DynamicHull::Bridge DynamicHull::bridge(unsigned long left, unsigned long right, bool lower) const {
+    unsigned long v = left;
+    while (not isLeaf(v)) {
+        const Bridge &candidate = lower ? nodes[v].lower : nodes[v].upper;
+        const Point &T = tangentFrom(candidate.left, right, lower);
+        v = _turnsOutwards(candidate.left, T, candidate.right, lower) ? nodes[v].right : nodes[v].left;
+    }
+    const Point &p = nodes[v].point;
+    return {p, tangentFrom(p, right, lower)};
+}
+
+
+// Whether P is strictly below the upper (or above the lower) hull of a subtree
+bool DynamicHull::isInterior(const Point &P, unsigned long v, bool lower) const {
+    while (not isLeaf(v)) {
+        const Bridge &bridge = lower ? nodes[v].lower : nodes[v].upper;
+        if (comp::xCoord(P, bridge.left)) v = nodes[v].left;
+        else if (comp::xCoord(bridge.right, P)) v = nodes[v].right;
+        else return _turnsInwards(bridge.left, bridge.right, P, lower);
+    }
+    return false;  // P is outside of the subtree's range
+}
+
+
+/*
+ * Appends the vertices of the upper (or lower) hull of a subtree in increasing order,
+ * restricted to those between two of them (`from` and `to`, inclusive; null for no bound).
+ * The hull of a node is the hull of its left child up to the bridge, followed by the hull
+ * of its right child from the bridge onwards.
+ */
+void DynamicHull::chain(unsigned long v, const Point *from, const Point *to, bool lower, Points &out) const {
+    if (isLeaf(v)) {
+        out.push_back(nodes[v].point);
+        return;
+    }
+
+    const Bridge &bridge = lower ? nodes[v].lower : nodes[v].upper;
+    if (from == nullptr or not comp::xCoord(bridge.left, *from)) {
+        const bool bounded = to != nullptr and not comp::xCoord(bridge.left, *to);
+        chain(nodes[v].left, from, bounded ? to : &bridge.left, lower, out);
+    }
+    if (to == nullptr or not comp::xCoord(*to, bridge.right)) {
+        const bool bounded = from != nullptr and not comp::xCoord(*from, bridge.right);
+        chain(nodes[v].right, bounded ? from : &bridge.right, to, lower, out);
+    }
+}
@@ -0,0 +1,358 @@
+#include "class/PolygonMap.h"
+
+#include <algorithm>  // std::sort, std::remove_if
+#include <functional>  // std::hash
+#include "consts.h"  // numeric::EPSILON
+#include "errors.h"
+#include "hull.h"  // hull::extreme
+
+
+//-------- INTERNAL UTILITIES --------//
+
+// Bounding box of a (non-empty) polygon, from its extreme vertices in each direction
+inline
+Box _boundingBox(const ConvexPolygon &pol) {
+    const Point *V = pol.getVertices().data();
+    const unsigned long n = pol.vertexCount();
+    return Box({V[0].x, V[hull::extreme({0, -1}, V, n)].y},  // (the first vertex is the leftmost one)
+               {V[hull::extreme({1, 0}, V, n)].x, V[hull::extreme({0, 1}, V, n)].y});
+}
+
+// Same, grown by the numerical tolerance on every side (so that touching boxes overlap)
+inline
+Box _expanded(const Box &box) {
+    const Point &SW = box.SW(), &NE = box.NE();
+    return Box({SW.x - numeric::EPSILON, SW.y - numeric::EPSILON}, {NE.x + numeric::EPSILON, NE.y + numeric::EPSILON});
+}
+
+// The index is bulk-loaded again if more than this fraction of its polygons have changed
+constexpr unsigned long _REBUILD_RATIO = 4;
+
+// Initial size of the hash table (which is kept at most half full)
+constexpr unsigned long _MIN_BUCKETS = 16;
+
+
+
+//-------- MEMBER FUNCTIONS --------//
+
+//---- Access ----//
+
+PolygonMap::Handle PolygonMap::find(const std::string &id) const {
+    if (table.empty()) return NONE;
+    return table[bucketOf(id, std::hash<std::string>()(id))].handle;
+}
+
+
+PolygonMap::Handle PolygonMap::handle(const std::string &id) const {
+    const Handle h = find(id);
+    if (h == NONE) throw error::UndefinedID(id);
+    return h;
+}
+
+
+PolygonMap::Handle PolygonMap::insert(const std::string &id) {
+    const std::size_t hash = std::hash<std::string>()(id);
+    if (not table.empty()) {
+        const Handle h = table[bucketOf(id, hash)].handle;
+        if (h != NONE) return h;
+    }
+
+    Handle h;
+    if (freeHandles.empty()) {
+        h = slots.size();
+        slots.emplace_back();
+        if (compactMode) compactPolygons.emplace_back();
+        else polygons.emplace_back();
+    }
+    else {
+        h = freeHandles.back();
+        freeHandles.pop_back();
+    }
+    slots[h].id = id;
+    slots[h].used = true;
+    ++polygonCount;
+    place(hash, h);
+    return h;
+}
+
+
+const ConvexPolygon &PolygonMap::get(Handle h) const {
+    return compactMode ? decode(h) : polygons[h];
+}
+
+
+PolygonMap::Handle PolygonMap::assign(const std::string &id, ConvexPolygon pol) {
+    const Handle h = insert(id);
+    touch(h) = std::move(pol);
+    return h;
+}
+
+
+bool PolygonMap::erase(const std::string &id) {
+    if (table.empty()) return false;
+    const unsigned long i = bucketOf(id, std::hash<std::string>()(id));
+    const Handle h = table[i].handle;
+    if (h == NONE) return false;
+
+    removeBucket(i);
+    index.erase(h);
+    slots[h] = Slot();  // (frees the ID)
+    if (compactMode) {
+        compactPolygons[h] = CompactPolygon();
+        decoded.erase(h);
+    }
+    else polygons[h] = ConvexPolygon();
+    freeHandles.push_back(h);
+    --polygonCount;
+    return true;
+}
+
+
+std::vector<std::string> PolygonMap::ids() const {
+    std::vector<std::string> result;
+    result.reserve(polygonCount);
+    for (const Slot &slot : slots)
+        if (slot.used) result.push_back(slot.id);
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+
+std::vector<std::string> PolygonMap::ids(const std::vector<Handle> &handles) const {
+    std::vector<std::string> result;
+    result.reserve(handles.size());
+    for (Handle h : handles) result.push_back(slots[h].id);
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+
+//---- Queries by handle ----//
+
+// (the decoded polygon, if any, may have changed since it was decoded)
+
+double PolygonMap::area(Handle h) const {
+    if (not compactMode) return polygons[h].area();
+    const auto it = decoded.find(h);
+    return it != decoded.end() ? it->second.area() : compactPolygons[h].area();
+}
+
+double PolygonMap::perimeter(Handle h) const {
+    if (not compactMode) return polygons[h].perimeter();
+    const auto it = decoded.find(h);
+    return it != decoded.end() ? it->second.perimeter() : compactPolygons[h].perimeter();
+}
+
+Box PolygonMap::boundingBox(Handle h) const {
+    if (not compactMode) return polygons[h].boundingBox();
+    const auto it = decoded.find(h);
+    return it != decoded.end() ? it->second.boundingBox() : compactPolygons[h].boundingBox();
+}
+
+bool PolygonMap::contains(Handle h, const Point &P) const {
+    if (not compactMode) return isInside(P, polygons[h]);
+    const auto it = decoded.find(h);
+    return it != decoded.end() ? isInside(P, it->second) : compactPolygons[h].contains(P);
+}
+
+
+Box PolygonMap::boundingBox(const std::vector<Handle> &handles) const {
+    auto first = handles.begin();
+    while (first != handles.end() and isEmpty(*first)) ++first;
+    if (first == handles.end()) throw error::ValueError("bounding box undefined for empty set");
+
+    const Box box = boundingBox(*first);
+    Point SW = box.SW(), NE = box.NE();
+    for (auto it = first + 1; it != handles.end(); ++it) {
+        if (isEmpty(*it)) continue;
+        const Box other = boundingBox(*it);
+        SW = bottomLeft(SW, other.SW());
+        NE = upperRight(NE, other.NE());
+    }
+    return Box(SW, NE);
+}
+
+
+//---- Compact mode ----//
+
+void PolygonMap::setCompact(bool on) {
+    if (on == compactMode) return;
+    release();
+
+    // (each polygon is freed as soon as it's converted, so that there aren't two copies of all of them)
+    if (on) {
+        for (ConvexPolygon &pol : polygons) {
+            compactPolygons.emplace_back(pol);
+            pol = ConvexPolygon();
+        }
+        std::deque<ConvexPolygon>().swap(polygons);
+    }
+    else {
+        for (CompactPolygon &pol : compactPolygons) {
+            polygons.push_back(pol.decode());
+            pol = CompactPolygon();
+        }
+        std::deque<CompactPolygon>().swap(compactPolygons);
+    }
+    compactMode = on;
+
+    // The vertices have been rounded (or they may have been), so everything is reindexed:
+    for (Handle h = 0; h < slots.size(); ++h) {
+        if (slots[h].used and not slots[h].changed) {
+            slots[h].changed = true;
+            changed.push_back(h);
+        }
+    }
+}
+
+
+void PolygonMap::release() {
+    for (const auto &entry : decoded)
+        if (slots[entry.first].changed) compactPolygons[entry.first] = CompactPolygon(entry.second);
+    decoded.clear();
+}
+
+
+//---- Spatial queries ----//
+
+std::vector<PolygonMap::Handle> PolygonMap::containing(const Point &P) {
+    updateIndex();
+    std::vector<Handle> result;
+    index.search(_expanded(Box(P, P)), result);
+    result.erase(std::remove_if(result.begin(), result.end(), [this, &P](Handle h) {
+        return not contains(h, P);
+    }), result.end());
+    return result;
+}
+
+
+std::vector<PolygonMap::Handle> PolygonMap::overlapping(const ConvexPolygon &pol) {
+    if (pol.empty()) return {};
+    updateIndex();
+    std::vector<Handle> result;
+    index.search(_expanded(_boundingBox(pol)), result);
+    result.erase(std::remove_if(result.begin(), result.end(), [this, &pol](Handle h) {
+        return not intersects(pol, get(h));
+    }), result.end());
+    return result;
+}
+
+
+//---- Internal ----//
+
+// Bucket that holds an ID, or the empty one where it would be placed
+unsigned long PolygonMap::bucketOf(const std::string &id, std::size_t hash) const {
+    const unsigned long mask = table.size() - 1;
+    unsigned long i = hash & mask;
+    while (table[i].handle != NONE and (table[i].hash != hash or slots[table[i].handle].id != id))
+        i = (i + 1) & mask;
+    return i;
+}
+
+
+// Adds a handle to the hash table (which doubles in size if it's half full)
+void PolygonMap::place(std::size_t hash, Handle h) {
+    if (2*polygonCount > table.size()) {
+        std::vector<Bucket> old(std::max(_MIN_BUCKETS, 2*table.size()));
+        old.swap(table);
+        for (const Bucket &bucket : old)
+            if (bucket.handle != NONE) place(bucket.hash, bucket.handle);
+    }
+    const unsigned long mask = table.size() - 1;
+    unsigned long i = hash & mask;
+    while (table[i].handle != NONE) i = (i + 1) & mask;
+    table[i].hash = hash;
+    table[i].handle = h;
+}
+
+
+// Empties a bucket, and moves back the ones after it in the same run that may now be
+// misplaced (those that can't be reached from their home bucket without crossing the gap)
+void PolygonMap::removeBucket(unsigned long i) {
+    const unsigned long mask = table.size() - 1;
+    for (unsigned long j = (i + 1) & mask; table[j].handle != NONE; j = (j + 1) & mask) {
+        const unsigned long home = table[j].hash & mask;
+        if (((j - home) & mask) >= ((j - i) & mask)) {
+            table[i] = table[j];
+            i = j;
+        }
+    }
+    table[i].handle = NONE;
+}
+
+
+// The decoded polygon with a given handle (decoding it if it isn't yet), in compact mode
+ConvexPolygon &PolygonMap::decode(Handle h) const {
+    auto it = decoded.find(h);
+    if (it == decoded.end()) it = decoded.emplace(h, compactPolygons[h].decode()).first;
+    return it->second;
+}
+
+
+// The polygon with a given handle, which is about to be modified (so it's noted down to be reindexed)
+ConvexPolygon &PolygonMap::touch(Handle h) {
+    Slot &slot = slots[h];
+    if (not slot.changed) {
+        slot.changed = true;
+        changed.push_back(h);
+    }
+    return compactMode ? decode(h) : polygons[h];
+}
+
+
+// Whether the polygon with a given handle is empty (without decoding it)
+bool PolygonMap::isEmpty(Handle h) const {
+    if (not compactMode) return polygons[h].empty();
+    const auto it = decoded.find(h);
+    return it != decoded.end() ? it->second.empty() : compactPolygons[h].empty();
+}
+
+
+// Reindexes the polygons that have changed since the last query (encoding them first, in compact mode)
+void PolygonMap::updateIndex() {
+    if (changed.empty()) return;
+
+    if (compactMode) {
+        for (Handle h : changed) {
+            const auto it = decoded.find(h);
+            if (slots[h].changed and it != decoded.end()) compactPolygons[h] = CompactPolygon(it->second);
+        }
+    }
+    // (from now on, the bounding boxes of the compact polygons are the ones that count)
+    auto box = [this](Handle h) { return compactMode ? compactPolygons[h].boundingBox() : _boundingBox(polygons[h]); };
+
+    if (changed.size() > index.size()/_REBUILD_RATIO) {
+        std::vector<RTree::Entry> entries;
+        entries.reserve(polygonCount);
+        for (Handle h = 0; h < slots.size(); ++h) {
+            if (slots[h].used and not isEmpty(h))
+                entries.push_back({box(h), h});
+        }
+        index = RTree(move(entries));
+        for (Handle h : changed) slots[h].changed = false;
+    }
+    else {
+        for (Handle h : changed) {
+            Slot &slot = slots[h];
+            if (not slot.changed) continue;  // erased, or seen already
+            slot.changed = false;
+            if (isEmpty(h)) index.erase(h);
+            else index.insert(h, box(h));
+        }
+    }
+    changed.clear();
+}
+
+
+
+//-------- ASSOCIATED NONMEMBER FUNCTIONS --------//
+
+bool operator==(const PolygonMap &lhs, const PolygonMap &rhs) {
+    if (lhs.size() != rhs.size()) return false;
+    for (PolygonMap::Handle h = 0; h < lhs.slots.size(); ++h) {
+        if (not lhs.slots[h].used) continue;
+        const PolygonMap::Handle other = rhs.find(lhs.slots[h].id);
+        if (other == PolygonMap::NONE or rhs.get(other) != lhs.get(h)) return false;
+    }
+    return true;
+}
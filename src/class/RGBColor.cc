@@ -1,5 +1,6 @@
 #include "class/RGBColor.h"
 
+#include <cmath>  // std::lround
 #include "errors.h"
 #include "details/numeric.h"
 
@@ -41,6 +42,15 @@ void RGBColor::setB(double blue) {
 
 
 
+//---- Packing ----//
+
+std::uint32_t RGBColor::pack() const {
+    auto level = [](double value) { return std::uint32_t(std::lround(value*255)); };
+    return level(r) << 16 | level(g) << 8 | level(b);
+}
+
+
+
 
 //-------- STATIC FUNCTIONS --------//
 
@@ -48,6 +58,10 @@ void RGBColor::checkRange(double val) {
     if (val < 0 or val > 1) throw error::ValueError("color values should be in [0, 1]");
 }
 
+RGBColor RGBColor::unpack(std::uint32_t packed) {
+    return RGBColor((packed >> 16 & 0xFF)/255.0, (packed >> 8 & 0xFF)/255.0, (packed & 0xFF)/255.0);
+}
+
 
 
 //-------- ASSOCIATED NONMEMBER FUNCTIONS --------//
@@ -0,0 +1,316 @@
+#include "class/RTree.h"
+
+#include <algorithm>  // std::sort, std::min, std::max
+#include <cmath>  // std::sqrt, std::ceil, INFINITY
+
+
+//-------- INTERNAL UTILITIES --------//
+
+// (templates, since RTree::Rect is private)
+
+template<typename Rect>
+inline double _area(const Rect &r) {
+    return (r.NE.x - r.SW.x)*(r.NE.y - r.SW.y);
+}
+
+template<typename Rect>
+inline double _perimeter(const Rect &r) {
+    return (r.NE.x - r.SW.x) + (r.NE.y - r.SW.y);
+}
+
+// Smallest rectangle that contains both
+template<typename Rect>
+inline Rect _join(const Rect &r, const Rect &s) {
+    return {{std::min(r.SW.x, s.SW.x), std::min(r.SW.y, s.SW.y)},
+            {std::max(r.NE.x, s.NE.x), std::max(r.NE.y, s.NE.y)}};
+}
+
+// Area of the intersection
+template<typename Rect>
+inline double _overlap(const Rect &r, const Rect &s) {
+    const double dx = std::min(r.NE.x, s.NE.x) - std::max(r.SW.x, s.SW.x),
+            dy = std::min(r.NE.y, s.NE.y) - std::max(r.SW.y, s.SW.y);
+    return dx > 0 and dy > 0 ? dx*dy : 0;
+}
+
+template<typename Rect>
+inline double _center(const Rect &r, bool yAxis) {
+    return yAxis ? r.SW.y + r.NE.y : r.SW.x + r.NE.x;  // (times two)
+}
+
+template<typename Rect>
+inline bool _same(const Rect &r, const Rect &s) {
+    return r.SW.x == s.SW.x and r.SW.y == s.SW.y and r.NE.x == s.NE.x and r.NE.y == s.NE.y;
+}
+
+
+
+//-------- MEMBER FUNCTIONS --------//
+
+//---- Construction ----//
+
+RTree::RTree(std::vector<Entry> entries) : entryCount(entries.size()) {
+    if (entries.empty()) return;
+
+    // Sort-Tile-Recursive: the entries of each level are sorted by x, cut into vertical
+    // slices of about sqrt(#nodes) nodes each, and then sorted by y within each slice and
+    // packed into full nodes, which become the entries of the next level.
+    std::vector<std::pair<Rect, unsigned long>> level;
+    unsigned long maxValue = 0;
+    for (const Entry &entry : entries) {
+        level.push_back({{entry.box.SW(), entry.box.NE()}, entry.value});
+        maxValue = std::max(maxValue, entry.value);
+    }
+    leafOf.assign(maxValue + 1, NIL);
+
+    for (unsigned height = 0; ; ++height) {
+        const unsigned long n = level.size(), nodeCount = (n + MAX_ENTRIES - 1)/MAX_ENTRIES;
+        const unsigned long sliceSize = MAX_ENTRIES*(unsigned long) std::ceil(std::sqrt(nodeCount));
+        auto byCenter = [](bool yAxis) {
+            return [yAxis](const std::pair<Rect, unsigned long> &a, const std::pair<Rect, unsigned long> &b) {
+                return _center(a.first, yAxis) < _center(b.first, yAxis);
+            };
+        };
+        std::sort(level.begin(), level.end(), byCenter(false));
+
+        std::vector<std::pair<Rect, unsigned long>> parents;
+        for (unsigned long slice = 0; slice < n; slice += sliceSize) {
+            const unsigned long sliceEnd = std::min(n, slice + sliceSize);
+            std::sort(level.begin() + slice, level.begin() + sliceEnd, byCenter(true));
+            for (unsigned long first = slice; first < sliceEnd; first += MAX_ENTRIES) {
+                const unsigned long v = newNode(height);
+                for (unsigned long i = first; i < std::min(sliceEnd, first + MAX_ENTRIES); ++i)
+                    append(v, level[i].first, level[i].second);
+                parents.push_back({cover(v), v});
+            }
+        }
+
+        if (parents.size() == 1) {
+            root = parents.front().second;
+            return;
+        }
+        level = move(parents);
+    }
+}
+
+
+//---- Updates ----//
+
+void RTree::insert(unsigned long value, const Box &box) {
+    erase(value);
+    if (value >= leafOf.size()) leafOf.resize(value + 1, NIL);
+    if (root == NIL) root = newNode(0);
+    insert({box.SW(), box.NE()}, value, 0);
+    ++entryCount;
+}
+
+
+bool RTree::erase(unsigned long value) {
+    if (not contains(value)) return false;
+    unsigned long v = leafOf[value];
+    removeEntry(v, position(v, value));
+    leafOf[value] = NIL;
+    --entryCount;
+
+    // Go up to the root, detaching the nodes that have become too small:
+    std::vector<unsigned long> orphans;
+    while (v != root) {
+        const unsigned long parent = nodes[v].parent;
+        const unsigned i = position(parent, v);
+        if (nodes[v].count < MIN_ENTRIES) {
+            removeEntry(parent, i);
+            orphans.push_back(v);
+        }
+        else nodes[parent].rects[i] = cover(v);
+        v = parent;
+    }
+
+    // ...and put their entries back at the same level:
+    for (unsigned long orphan : orphans) {
+        const Node node = nodes[orphan];  // (a copy, since the pool may be reallocated)
+        freeNodes.push_back(orphan);
+        for (unsigned i = 0; i < node.count; ++i) insert(node.rects[i], node.children[i], node.level);
+    }
+
+    // The root is dropped while it has a single child (or nothing at all):
+    while (nodes[root].level > 0 and nodes[root].count == 1) {
+        freeNodes.push_back(root);
+        root = nodes[root].children[0];
+        nodes[root].parent = NIL;
+    }
+    if (nodes[root].count == 0) {
+        freeNodes.push_back(root);
+        root = NIL;
+    }
+    return true;
+}
+
+
+//---- Queries ----//
+
+template<typename Overlaps>
+void RTree::search(const Overlaps &overlaps, std::vector<unsigned long> &result) const {
+    if (root == NIL) return;
+    std::vector<unsigned long> stack = {root};
+    while (not stack.empty()) {
+        const Node &node = nodes[stack.back()];
+        stack.pop_back();
+        for (unsigned i = 0; i < node.count; ++i)
+            if (overlaps(node.rects[i])) (node.level == 0 ? result : stack).push_back(node.children[i]);
+    }
+}
+
+
+void RTree::search(const Point &P, std::vector<unsigned long> &result) const {
+    search([&P](const Rect &r) {
+        return r.SW.x <= P.x and P.x <= r.NE.x and r.SW.y <= P.y and P.y <= r.NE.y;
+    }, result);
+}
+
+
+void RTree::search(const Box &box, std::vector<unsigned long> &result) const {
+    const Point &SW = box.SW(), &NE = box.NE();
+    search([&SW, &NE](const Rect &r) {
+        return r.SW.x <= NE.x and SW.x <= r.NE.x and r.SW.y <= NE.y and SW.y <= r.NE.y;
+    }, result);
+}
+
+
+//---- Internal ----//
+
+unsigned long RTree::newNode(unsigned level) {
+    Node node;
+    node.level = level;
+    if (freeNodes.empty()) {
+        nodes.push_back(node);
+        return nodes.size() - 1;
+    }
+    const unsigned long v = freeNodes.back();
+    freeNodes.pop_back();
+    nodes[v] = node;
+    return v;
+}
+
+
+void RTree::append(unsigned long v, const Rect &rect, unsigned long child) {
+    Node &node = nodes[v];
+    node.rects[node.count] = rect;
+    node.children[node.count] = child;
+    ++node.count;
+    if (node.level == 0) leafOf[child] = v;
+    else nodes[child].parent = v;
+}
+
+
+void RTree::removeEntry(unsigned long v, unsigned i) {
+    Node &node = nodes[v];
+    --node.count;
+    node.rects[i] = node.rects[node.count];
+    node.children[i] = node.children[node.count];
+}
+
+
+unsigned RTree::position(unsigned long v, unsigned long child) const {
+    const Node &node = nodes[v];
+    return std::find(node.children, node.children + node.count, child) - node.children;
+}
+
+
+RTree::Rect RTree::cover(unsigned long v) const {
+    const Node &node = nodes[v];
+    Rect result = node.rects[0];
+    for (unsigned i = 1; i < node.count; ++i) result = _join(result, node.rects[i]);
+    return result;
+}
+
+
+// Adds an entry to a node at the given level, chosen by going down from the root through
+// the child whose rectangle would grow the least (the smallest one, in case of ties)
+void RTree::insert(const Rect &rect, unsigned long child, unsigned level) {
+    unsigned long v = root;
+    while (nodes[v].level > level) {
+        const Node &node = nodes[v];
+        unsigned best = 0;
+        double minGrowth = INFINITY, minArea = INFINITY;
+        for (unsigned i = 0; i < node.count; ++i) {
+            const double area = _area(node.rects[i]), growth = _area(_join(node.rects[i], rect)) - area;
+            if (growth < minGrowth or (growth == minGrowth and area < minArea)) {
+                best = i;
+                minGrowth = growth;
+                minArea = area;
+            }
+        }
+        v = node.children[best];
+    }
+    append(v, rect, child);
+    adjust(v);
+}
+
+
+// Splits a node if it has too many entries, and updates the rectangles of its ancestors
+// (splitting them in turn, if needed), up to the first one that doesn't change
+void RTree::adjust(unsigned long v) {
+    while (true) {
+        const unsigned long sibling = nodes[v].count > MAX_ENTRIES ? split(v) : NIL;
+        const unsigned long parent = nodes[v].parent;
+        if (parent == NIL) {
+            if (sibling != NIL) {  // the tree grows by one level
+                root = newNode(nodes[v].level + 1);
+                append(root, cover(v), v);
+                append(root, cover(sibling), sibling);
+            }
+            return;
+        }
+
+        const unsigned i = position(parent, v);
+        const Rect rect = cover(v);
+        const bool changed = not _same(rect, nodes[parent].rects[i]);
+        nodes[parent].rects[i] = rect;
+        if (sibling != NIL) append(parent, cover(sibling), sibling);
+        else if (not changed) return;
+        v = parent;
+    }
+}
+
+
+// Moves some of the entries of an overfull node to a new sibling (which is returned). The
+// entries are sorted by the center of their rectangles, either horizontally or vertically,
+// and cut where the two halves overlap the least (and then cover the least area).
+unsigned long RTree::split(unsigned long v) {
+    const Node node = nodes[v];
+    const unsigned n = node.count;
+
+    unsigned order[MAX_ENTRIES + 1], bestOrder[MAX_ENTRIES + 1], bestCut = 0;
+    double best[3] = {INFINITY, INFINITY, INFINITY};  // overlap, area, perimeter
+    for (bool yAxis : {false, true}) {
+        for (unsigned i = 0; i < n; ++i) order[i] = i;
+        std::sort(order, order + n, [&node, yAxis](unsigned a, unsigned b) {
+            return _center(node.rects[a], yAxis) < _center(node.rects[b], yAxis);
+        });
+
+        Rect prefix[MAX_ENTRIES + 1], suffix[MAX_ENTRIES + 1];  // covers of the first/last i + 1
+        prefix[0] = node.rects[order[0]];
+        suffix[0] = node.rects[order[n - 1]];
+        for (unsigned i = 1; i < n; ++i) {
+            prefix[i] = _join(prefix[i - 1], node.rects[order[i]]);
+            suffix[i] = _join(suffix[i - 1], node.rects[order[n - 1 - i]]);
+        }
+
+        for (unsigned cut = MIN_ENTRIES; cut + MIN_ENTRIES <= n; ++cut) {
+            const Rect &first = prefix[cut - 1], &second = suffix[n - cut - 1];
+            const double cost[3] = {_overlap(first, second), _area(first) + _area(second),
+                                    _perimeter(first) + _perimeter(second)};
+            if (std::lexicographical_compare(cost, cost + 3, best, best + 3)) {
+                std::copy(cost, cost + 3, best);
+                std::copy(order, order + n, bestOrder);
+                bestCut = cut;
+            }
+        }
+    }
+
+    const unsigned long sibling = newNode(node.level);
+    nodes[v].count = 0;
+    for (unsigned i = 0; i < n; ++i)
+        append(i < bestCut ? v : sibling, node.rects[bestOrder[i]], node.children[bestOrder[i]]);
+    return sibling;
+}
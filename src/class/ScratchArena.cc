@@ -0,0 +1,53 @@
+#include "class/ScratchArena.h"
+
+#include <algorithm>  // std::min, std::max
+#include <cstdint>  // std::uintptr_t
+#include "consts.h"  // scratch::MAX_CAPACITY
+
+
+//-------- MEMBER FUNCTIONS --------//
+
+ScratchArena::ScratchArena(std::size_t capacity) :
+        buffer(capacity ? new char[capacity] : nullptr), bufferSize(capacity) {}
+
+
+ScratchArena &ScratchArena::local() {
+    thread_local ScratchArena arena;
+    return arena;
+}
+
+
+void ScratchArena::reset() {
+    if (overflowed > 0) {
+        overflow.release();
+        const std::size_t peak = offset + overflowed;
+        if (bufferSize < scratch::MAX_CAPACITY) {
+            bufferSize = std::min<std::size_t>(scratch::MAX_CAPACITY, std::max(2*bufferSize, peak));
+            buffer.reset(new char[bufferSize]);
+        }
+    }
+    offset = overflowed = 0;
+}
+
+
+void *ScratchArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    const auto base = reinterpret_cast<std::uintptr_t>(buffer.get());
+    const std::size_t start = ((base + offset + alignment - 1) & ~(alignment - 1)) - base;
+    if (buffer and start + bytes <= bufferSize) {
+        offset = start + bytes;
+        return buffer.get() + start;
+    }
+    overflowed += bytes;
+    return overflow.allocate(bytes, alignment);
+}
+
+
+//---- Scopes ----//
+
+ScratchArena::Scope::Scope(ScratchArena &arena) : arena(arena) {
+    ++arena.scopes;
+}
+
+ScratchArena::Scope::~Scope() {
+    if (--arena.scopes == 0) arena.reset();
+}
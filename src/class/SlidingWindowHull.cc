@@ -0,0 +1,122 @@
+#include "class/SlidingWindowHull.h"
+
+#include "geom.h"  // geom::isClockwiseTurn, geom::isCounterClockwiseTurn
+#include "hull.h"  // hull::contains, hull::tangent, hull::monotoneChain
+#include "errors.h"
+
+
+//-------- MEMBER FUNCTIONS --------//
+
+void SlidingWindowHull::push(const Point &P) {
+    back.push(P);
+}
+
+
+void SlidingWindowHull::pop() {
+    if (empty()) throw error::ValueError("the window is empty");
+
+    if (front.points.empty()) {
+        // Transfer the back stack, so that its oldest point is on top:
+        for (auto it = back.points.rbegin(); it != back.points.rend(); ++it) front.push(*it);
+        back.clear();
+    }
+    front.pop();
+}
+
+
+ConvexPolygon SlidingWindowHull::polygon() const {
+    Points vertices = front.ring;
+    vertices.insert(vertices.end(), back.ring.begin(), back.ring.end());
+    return ConvexPolygon(move(vertices));
+}
+
+
+
+//---- Stacks ----//
+
+void SlidingWindowHull::Stack::push(const Point &P) {
+    points.push_back(P);
+    const unsigned long n = ring.size();
+    if (hull::contains(P, ring.data(), n)) {
+        changes.push_back({NIL, 0, 0});
+        return;
+    }
+
+    unsigned long before = 0, after = 0;
+    if (n >= 3) {
+        ring.push_back(ring.front());  // hull::tangent expects a closed cycle
+        after = hull::tangent(P, ring.data(), n);
+        before = hull::tangent(P, ring.data(), n, true);
+        ring.pop_back();
+
+        // With nearly collinear vertices, the tolerance of the turn tests can mislead the tangent search,
+        // so the result is checked: the ring must turn clockwise at P and at both tangents, and the
+        // vertices between them (which are removed) must be inside the new edges.
+        const Point &first = ring[(before + n - 1)%n], &last = ring[(after + 1)%n];
+        bool valid = geom::isClockwiseTurn(first, ring[before], P) and geom::isClockwiseTurn(ring[before], P, ring[after])
+                     and geom::isClockwiseTurn(P, ring[after], last);
+        for (unsigned long i = (before + 1)%n; valid and i != after; i = (i + 1)%n) {
+            valid = not geom::isCounterClockwiseTurn(ring[before], P, ring[i])
+                    and not geom::isCounterClockwiseTurn(P, ring[after], ring[i]);
+        }
+        if (not valid) after = before;
+    }
+    if (before == after) {  // degenerate hull (or numerically ill-conditioned case): just rebuild it
+        removedLog.insert(removedLog.end(), ring.begin(), ring.end());
+        changes.push_back({0, n, NIL});
+        ring.push_back(P);
+        ring = hull::monotoneChain(move(ring));
+        ring.pop_back();
+        return;
+    }
+
+    // Same as in ConvexPolygon::insert(), but the ring can start at any vertex:
+    if (before < after) {
+        removedLog.insert(removedLog.end(), ring.begin() + before + 1, ring.begin() + after);
+        changes.push_back({before + 1, after - before - 1, 0});
+        if (after - before >= 2) {
+            ring[before + 1] = P;
+            ring.erase(ring.begin() + before + 2, ring.begin() + after);
+        }
+        else ring.insert(ring.begin() + after, P);
+    }
+    else {
+        // The chain wraps around the end of the array:
+        removedLog.insert(removedLog.end(), ring.begin(), ring.begin() + after);
+        removedLog.insert(removedLog.end(), ring.begin() + before + 1, ring.end());
+        changes.push_back({before + 1 - after, n - 1 - before, after});
+        ring.erase(ring.begin() + before + 1, ring.end());
+        ring.erase(ring.begin(), ring.begin() + after);
+        ring.push_back(P);
+    }
+}
+
+
+void SlidingWindowHull::Stack::pop() {
+    points.pop_back();
+    const Change change = changes.back();
+    changes.pop_back();
+    if (change.position == NIL) return;
+
+    const auto removed = removedLog.end() - change.removed;
+    if (change.head == NIL) ring.assign(removed, removedLog.end());
+    else {
+        ring.erase(ring.begin() + change.position);
+        ring.insert(ring.begin() + change.position, removed, removedLog.end());
+    }
+    removedLog.erase(removed, removedLog.end());
+
+    if (change.head != NIL and change.head > 0) {
+        const auto head = removedLog.end() - change.head;
+        ring.insert(ring.begin(), head, removedLog.end());
+        removedLog.erase(head, removedLog.end());
+    }
+}
+
+
+void SlidingWindowHull::Stack::clear() {
+    points.clear();
+    ring.clear();
+    changes.clear();
+    removedLog.clear();
+}
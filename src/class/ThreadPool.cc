@@ -0,0 +1,75 @@
+#include "class/ThreadPool.h"
+
+#include <algorithm>  // std::max
+
+
+//-------- MEMBER FUNCTIONS --------//
+
+ThreadPool::ThreadPool(unsigned threads) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned i = 0; i < threads; ++i)
+        workers.emplace_back(&ThreadPool::work, this);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    condition.notify_all();
+    for (std::thread &worker : workers) worker.join();
+}
+
+
+void ThreadPool::work() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this]{ return stopping or not tasks.empty(); });
+            if (tasks.empty()) return;  // stopping, and nothing left to do
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+        task();
+    }
+}
+
+
+bool ThreadPool::runPendingTask() {
+    std::function<void()> task;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (tasks.empty()) return false;
+        task = std::move(tasks.front());
+        tasks.pop();
+    }
+    task();
+    return true;
+}
+
+
+void ThreadPool::wait(const std::function<bool()> &ready) {
+    std::unique_lock<std::mutex> lock(mutex);
+    ++waiters;
+    waiting.wait(lock, [this, &ready]{ return not tasks.empty() or ready(); });
+    --waiters;
+}
+
+
+void ThreadPool::finished() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);  // (so that a waiter can't miss the notification)
+        if (waiters == 0) return;
+    }
+    waiting.notify_all();
+}
+
+
+
+//-------- STATIC FUNCTIONS --------//
+
+ThreadPool &ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
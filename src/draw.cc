@@ -68,7 +68,7 @@ void _draw(pngwriter &png, const ConvexPolygon &pol, const _ScaleHelper &scale,
     if (pol.empty()) return;
 
     // Some aliases:
-    const Points &vertices = pol.getVertices();
+    const Vertices &vertices = pol.getVertices();
     const RGBColor &color = pol.getColor();
     const Point &O = vertices.front();  // origin from which to draw triangles
     const int x0 = scale.scaleX(O.x), y0 = scale.scaleY(O.y);  // scaled origin coordinates
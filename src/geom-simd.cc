@@ -0,0 +1,791 @@
+#include "geom.h"
+
+#include "consts.h"  // numeric::EPSILON
+#include "details/numeric.h"
+#include <cstdint>  // uint64_t
+#include <cstring>  // std::memcpy
+#include <cmath>  // std::sqrt
+#include <algorithm>  // std::min, std::max
+
+#if defined(__GNUC__) and (defined(__x86_64__) or defined(__i386__))
+#define CONVEXPOLYGONS_SIMD_X86
+#include <immintrin.h>
+#endif
+
+// The batch predicates must round exactly like the scalar ones, so no fused multiply-adds:
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+
+namespace geom {
+
+    //-------- INSTRUCTION SET SELECTION --------//
+
+    namespace simd {
+
+        Level detect() {
+#ifdef CONVEXPOLYGONS_SIMD_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f")) return Level::avx512;
+            if (__builtin_cpu_supports("avx2")) return Level::avx2;
+            if (__builtin_cpu_supports("sse2")) return Level::sse2;
+#endif
+            return Level::scalar;
+        }
+
+
+        Level &level() {
+            static Level globalLevel = detect();
+            return globalLevel;
+        }
+
+
+        const char *name(Level level) {
+            switch (level) {
+                case Level::sse2: return "sse2";
+                case Level::avx2: return "avx2";
+                case Level::avx512: return "avx512";
+                default: return "scalar";
+            }
+        }
+
+    }
+
+
+
+    //-------- KERNELS --------//
+
+    /*
+     * Every kernel computes the cross product of AB and AC with the same operations as
+     * crossProd(B - A, C - A), and then compares it like numeric::less(cross, 0) (clockwise)
+     * or numeric::greater(cross, 0) (counter-clockwise), i.e. !(0 < cross + EPSILON) and
+     * !(cross < EPSILON) respectively. The negated comparisons are unordered (true for NaN),
+     * like the scalar ones. The leftovers at the end of the arrays go through the scalar kernel.
+     */
+
+    //---- Scalar ----//
+
+    template<bool clockwise>
+    inline
+    bool _turn(const Point &A, const Point &B, const Point &C) {
+        const double cross = (B.x - A.x)*(C.y - A.y) - (B.y - A.y)*(C.x - A.x);
+        return clockwise ? numeric::less(cross, 0) : numeric::greater(cross, 0);
+    }
+
+    template<bool clockwise>
+    void _turnsScalar(const Point *chain, unsigned long edges, const Point *C, unsigned long n, bool *result) {
+        for (unsigned long i = 0; i < n; ++i) {
+            bool turns = true;
+            for (unsigned long e = 0; e < edges; ++e) turns &= _turn<clockwise>(chain[e], chain[e + 1], C[i]);
+            result[i] = turns;
+        }
+    }
+
+    bool _chainScalar(const Point *points, unsigned long n) {
+        for (unsigned long i = 0; i + 2 < n; ++i)
+            if (not _turn<true>(points[i], points[i + 1], points[i + 2])) return false;
+        return true;
+    }
+
+
+#ifdef CONVEXPOLYGONS_SIMD_X86
+
+    // Stores the low `width` bits of a comparison mask as booleans (one byte each)
+    template<unsigned width>
+    inline
+    void _store(unsigned mask, bool *result) {
+        // spread bit k of the mask into the lowest bit of byte k:
+        uint64_t bytes = mask;
+        bytes = (bytes | bytes << 28) & 0x0000000F0000000Full;
+        bytes = (bytes | bytes << 14) & 0x0003000300030003ull;
+        bytes = (bytes | bytes << 7) & 0x0101010101010101ull;
+        std::memcpy(result, &bytes, width);  // x86 is little-endian: byte k goes to result[k]
+    }
+
+
+    //---- SSE2 (2 points per iteration) ----//
+
+    // Loads two consecutive points as a vector of x coordinates and one of y coordinates
+    __attribute__((target("sse2"))) inline
+    void _load2(const Point *P, __m128d &x, __m128d &y) {
+        const __m128d first = _mm_loadu_pd(&P[0].x), second = _mm_loadu_pd(&P[1].x);
+        x = _mm_unpacklo_pd(first, second);
+        y = _mm_unpackhi_pd(first, second);
+    }
+
+    template<bool clockwise>
+    __attribute__((target("sse2"))) inline
+    int _turnMask2(__m128d ax, __m128d ay, __m128d bx, __m128d by, __m128d cx, __m128d cy) {
+        const __m128d cross = _mm_sub_pd(_mm_mul_pd(_mm_sub_pd(bx, ax), _mm_sub_pd(cy, ay)),
+                                         _mm_mul_pd(_mm_sub_pd(by, ay), _mm_sub_pd(cx, ax)));
+        const __m128d epsilon = _mm_set1_pd(numeric::EPSILON);
+        return _mm_movemask_pd(clockwise ? _mm_cmpngt_pd(_mm_add_pd(cross, epsilon), _mm_setzero_pd())
+                                         : _mm_cmpnlt_pd(cross, epsilon));
+    }
+
+    template<bool clockwise, unsigned long fixedEdges>
+    __attribute__((target("sse2")))
+    void _turnsSse2(const Point *chain, unsigned long edges, const Point *C, unsigned long n, bool *result) {
+        if (fixedEdges > 0) edges = fixedEdges;
+        unsigned long i = 0;
+        for (; i + 2 <= n; i += 2) {
+            __m128d cx, cy;
+            _load2(C + i, cx, cy);
+            int mask = 0b11;
+            for (unsigned long e = 0; e < edges; ++e) {
+                const __m128d ax = _mm_set1_pd(chain[e].x), ay = _mm_set1_pd(chain[e].y);
+                const __m128d bx = _mm_set1_pd(chain[e + 1].x), by = _mm_set1_pd(chain[e + 1].y);
+                mask &= _turnMask2<clockwise>(ax, ay, bx, by, cx, cy);
+            }
+            _store<2>(mask, result + i);
+        }
+        _turnsScalar<clockwise>(chain, edges, C + i, n - i, result + i);
+    }
+
+    __attribute__((target("sse2")))
+    bool _chainSse2(const Point *points, unsigned long n) {
+        unsigned long i = 0;
+        for (; i + 4 <= n; i += 2) {
+            __m128d ax, ay, bx, by, cx, cy;
+            _load2(points + i, ax, ay);
+            _load2(points + i + 1, bx, by);
+            _load2(points + i + 2, cx, cy);
+            if (_turnMask2<true>(ax, ay, bx, by, cx, cy) != 0b11) return false;
+        }
+        return _chainScalar(points + i, n - i);
+    }
+
+
+
+    //---- AVX2 (4 points per iteration) ----//
+
+    __attribute__((target("avx2"))) inline
+    void _load4(const Point *P, __m256d &x, __m256d &y) {
+        const __m256d first = _mm256_loadu_pd(&P[0].x), second = _mm256_loadu_pd(&P[2].x);
+        // the unpacks give the points in the order 0, 2, 1, 3:
+        x = _mm256_permute4x64_pd(_mm256_unpacklo_pd(first, second), 0b11011000);
+        y = _mm256_permute4x64_pd(_mm256_unpackhi_pd(first, second), 0b11011000);
+    }
+
+    // (as a vector with all the bits of each lane set or cleared)
+    template<bool clockwise>
+    __attribute__((target("avx2"))) inline
+    __m256d _turnVector4(__m256d ax, __m256d ay, __m256d bx, __m256d by, __m256d cx, __m256d cy) {
+        const __m256d cross = _mm256_sub_pd(_mm256_mul_pd(_mm256_sub_pd(bx, ax), _mm256_sub_pd(cy, ay)),
+                                            _mm256_mul_pd(_mm256_sub_pd(by, ay), _mm256_sub_pd(cx, ax)));
+        const __m256d epsilon = _mm256_set1_pd(numeric::EPSILON);
+        return clockwise ? _mm256_cmp_pd(_mm256_add_pd(cross, epsilon), _mm256_setzero_pd(), _CMP_NGT_UQ)
+                         : _mm256_cmp_pd(cross, epsilon, _CMP_NLT_UQ);
+    }
+
+    template<bool clockwise>
+    __attribute__((target("avx2"))) inline
+    int _turnMask4(__m256d ax, __m256d ay, __m256d bx, __m256d by, __m256d cx, __m256d cy) {
+        return _mm256_movemask_pd(_turnVector4<clockwise>(ax, ay, bx, by, cx, cy));
+    }
+
+    template<bool clockwise, unsigned long fixedEdges>
+    __attribute__((target("avx2")))
+    void _turnsAvx2(const Point *chain, unsigned long edges, const Point *C, unsigned long n, bool *result) {
+        if (fixedEdges > 0) edges = fixedEdges;
+        unsigned long i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m256d cx, cy;
+            _load4(C + i, cx, cy);
+            int mask = 0b1111;
+            for (unsigned long e = 0; e < edges; ++e) {
+                const __m256d ax = _mm256_set1_pd(chain[e].x), ay = _mm256_set1_pd(chain[e].y);
+                const __m256d bx = _mm256_set1_pd(chain[e + 1].x), by = _mm256_set1_pd(chain[e + 1].y);
+                mask &= _turnMask4<clockwise>(ax, ay, bx, by, cx, cy);
+            }
+            _store<4>(mask, result + i);
+        }
+        _turnsScalar<clockwise>(chain, edges, C + i, n - i, result + i);
+    }
+
+    __attribute__((target("avx2")))
+    bool _chainAvx2(const Point *points, unsigned long n) {
+        unsigned long i = 0;
+        for (; i + 6 <= n; i += 4) {
+            __m256d ax, ay, bx, by, cx, cy;
+            _load4(points + i, ax, ay);
+            _load4(points + i + 1, bx, by);
+            _load4(points + i + 2, cx, cy);
+            if (_turnMask4<true>(ax, ay, bx, by, cx, cy) != 0b1111) return false;
+        }
+        return _chainScalar(points + i, n - i);
+    }
+
+
+
+    //---- AVX-512 (8 points per iteration) ----//
+
+    __attribute__((target("avx512f"))) inline
+    void _load8(const Point *P, __m512d &x, __m512d &y) {
+        const __m512d first = _mm512_loadu_pd(&P[0].x), second = _mm512_loadu_pd(&P[4].x);
+        x = _mm512_permutex2var_pd(first, _mm512_set_epi64(14, 12, 10, 8, 6, 4, 2, 0), second);
+        y = _mm512_permutex2var_pd(first, _mm512_set_epi64(15, 13, 11, 9, 7, 5, 3, 1), second);
+    }
+
+    template<bool clockwise>
+    __attribute__((target("avx512f"))) inline
+    __mmask8 _turnMask8(__m512d ax, __m512d ay, __m512d bx, __m512d by, __m512d cx, __m512d cy) {
+        const __m512d cross = _mm512_sub_pd(_mm512_mul_pd(_mm512_sub_pd(bx, ax), _mm512_sub_pd(cy, ay)),
+                                            _mm512_mul_pd(_mm512_sub_pd(by, ay), _mm512_sub_pd(cx, ax)));
+        const __m512d epsilon = _mm512_set1_pd(numeric::EPSILON);
+        return clockwise ? _mm512_cmp_pd_mask(_mm512_add_pd(cross, epsilon), _mm512_setzero_pd(), _CMP_NGT_UQ)
+                         : _mm512_cmp_pd_mask(cross, epsilon, _CMP_NLT_UQ);
+    }
+
+    template<bool clockwise, unsigned long fixedEdges>
+    __attribute__((target("avx512f")))
+    void _turnsAvx512(const Point *chain, unsigned long edges, const Point *C, unsigned long n, bool *result) {
+        if (fixedEdges > 0) edges = fixedEdges;
+        unsigned long i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m512d cx, cy;
+            _load8(C + i, cx, cy);
+            unsigned mask = 0xFF;
+            for (unsigned long e = 0; e < edges; ++e) {
+                const __m512d ax = _mm512_set1_pd(chain[e].x), ay = _mm512_set1_pd(chain[e].y);
+                const __m512d bx = _mm512_set1_pd(chain[e + 1].x), by = _mm512_set1_pd(chain[e + 1].y);
+                mask &= _turnMask8<clockwise>(ax, ay, bx, by, cx, cy);
+            }
+            _store<8>(mask, result + i);
+        }
+        _turnsScalar<clockwise>(chain, edges, C + i, n - i, result + i);
+    }
+
+    __attribute__((target("avx512f")))
+    bool _chainAvx512(const Point *points, unsigned long n) {
+        unsigned long i = 0;
+        for (; i + 10 <= n; i += 8) {
+            __m512d ax, ay, bx, by, cx, cy;
+            _load8(points + i, ax, ay);
+            _load8(points + i + 1, bx, by);
+            _load8(points + i + 2, cx, cy);
+            if (_turnMask8<true>(ax, ay, bx, by, cx, cy) != 0xFF) return false;
+        }
+        return _chainScalar(points + i, n - i);
+    }
+
+#endif
+
+
+
+    //-------- DISPATCH --------//
+
+    // If fixedEdges is not 0, the number of edges is known at compile time (which helps
+    // the compiler hoist the broadcasts of the edges' endpoints out of the loop)
+    template<bool clockwise, unsigned long fixedEdges = 0>
+    void _turns(const Point *chain, unsigned long edges, const Point *C, unsigned long n, bool *result) {
+        switch (simd::level()) {
+#ifdef CONVEXPOLYGONS_SIMD_X86
+            case simd::Level::avx512: return _turnsAvx512<clockwise, fixedEdges>(chain, edges, C, n, result);
+            case simd::Level::avx2: return _turnsAvx2<clockwise, fixedEdges>(chain, edges, C, n, result);
+            case simd::Level::sse2: return _turnsSse2<clockwise, fixedEdges>(chain, edges, C, n, result);
+#endif
+            default: return _turnsScalar<clockwise>(chain, edges, C, n, result);
+        }
+    }
+
+
+    void clockwiseTurns(const Point &A, const Point &B, const Point *C, unsigned long n, bool *result) {
+        const Point segment[2] = {A, B};
+        _turns<true, 1>(segment, 1, C, n, result);
+    }
+
+
+    void counterClockwiseTurns(const Point &A, const Point &B, const Point *C, unsigned long n, bool *result) {
+        const Point segment[2] = {A, B};
+        _turns<false, 1>(segment, 1, C, n, result);
+    }
+
+
+    void clockwiseTurnsAlong(const Point *chain, unsigned long edges, const Point *C, unsigned long n, bool *result) {
+        _turns<true>(chain, edges, C, n, result);
+    }
+
+
+    bool allClockwiseTurns(const Point *points, unsigned long n) {
+        switch (simd::level()) {
+#ifdef CONVEXPOLYGONS_SIMD_X86
+            case simd::Level::avx512: return _chainAvx512(points, n);
+            case simd::Level::avx2: return _chainAvx2(points, n);
+            case simd::Level::sse2: return _chainSse2(points, n);
+#endif
+            default: return _chainScalar(points, n);
+        }
+    }
+
+
+
+    //-------- METRIC KERNELS --------//
+
+    /*
+     * Each kernel keeps one partial result per vector lane, and combines them at the end
+     * (and then adds the leftovers at the end of the arrays, with the scalar kernel).
+     */
+
+    //---- Scalar ----//
+
+    double _shoelaceScalar(const double *x, const double *y, unsigned long n) {
+        double sum = 0;
+        for (unsigned long i = 0; i < n; ++i) sum += (x[i + 1] - x[i])*(y[i + 1] + y[i]);
+        return sum;
+    }
+
+    double _lengthScalar(const double *x, const double *y, unsigned long n) {
+        double sum = 0;
+        for (unsigned long i = 0; i < n; ++i) {
+            const double dx = x[i + 1] - x[i], dy = y[i + 1] - y[i];
+            sum += std::sqrt(dx*dx + dy*dy);
+        }
+        return sum;
+    }
+
+    Point _sumScalar(const double *x, const double *y, unsigned long n) {
+        Point sum = {0, 0};
+        for (unsigned long i = 0; i < n; ++i) sum.x += x[i], sum.y += y[i];
+        return sum;
+    }
+
+    void _boundsScalar(const double *x, const double *y, unsigned long n, Point &min, Point &max) {
+        for (unsigned long i = 0; i < n; ++i) {
+            min.x = std::min(min.x, x[i]), min.y = std::min(min.y, y[i]);
+            max.x = std::max(max.x, x[i]), max.y = std::max(max.y, y[i]);
+        }
+    }
+
+
+#ifdef CONVEXPOLYGONS_SIMD_X86
+
+    //---- SSE2 ----//
+
+    __attribute__((target("sse2"))) inline
+    double _sum2(__m128d v) { return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v))); }
+
+    __attribute__((target("sse2"))) inline
+    double _min2(__m128d v) { return _mm_cvtsd_f64(_mm_min_sd(v, _mm_unpackhi_pd(v, v))); }
+
+    __attribute__((target("sse2"))) inline
+    double _max2(__m128d v) { return _mm_cvtsd_f64(_mm_max_sd(v, _mm_unpackhi_pd(v, v))); }
+
+    __attribute__((target("sse2")))
+    double _shoelaceSse2(const double *x, const double *y, unsigned long n) {
+        __m128d sum = _mm_setzero_pd();
+        unsigned long i = 0;
+        for (; i + 2 <= n; i += 2) {
+            const __m128d dx = _mm_sub_pd(_mm_loadu_pd(x + i + 1), _mm_loadu_pd(x + i));
+            const __m128d sy = _mm_add_pd(_mm_loadu_pd(y + i + 1), _mm_loadu_pd(y + i));
+            sum = _mm_add_pd(sum, _mm_mul_pd(dx, sy));
+        }
+        return _sum2(sum) + _shoelaceScalar(x + i, y + i, n - i);
+    }
+
+    __attribute__((target("sse2")))
+    double _lengthSse2(const double *x, const double *y, unsigned long n) {
+        __m128d sum = _mm_setzero_pd();
+        unsigned long i = 0;
+        for (; i + 2 <= n; i += 2) {
+            const __m128d dx = _mm_sub_pd(_mm_loadu_pd(x + i + 1), _mm_loadu_pd(x + i));
+            const __m128d dy = _mm_sub_pd(_mm_loadu_pd(y + i + 1), _mm_loadu_pd(y + i));
+            sum = _mm_add_pd(sum, _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy))));
+        }
+        return _sum2(sum) + _lengthScalar(x + i, y + i, n - i);
+    }
+
+    __attribute__((target("sse2")))
+    Point _sumSse2(const double *x, const double *y, unsigned long n) {
+        __m128d sumX = _mm_setzero_pd(), sumY = _mm_setzero_pd();
+        unsigned long i = 0;
+        for (; i + 2 <= n; i += 2) {
+            sumX = _mm_add_pd(sumX, _mm_loadu_pd(x + i));
+            sumY = _mm_add_pd(sumY, _mm_loadu_pd(y + i));
+        }
+        const Point rest = _sumScalar(x + i, y + i, n - i);
+        return {_sum2(sumX) + rest.x, _sum2(sumY) + rest.y};
+    }
+
+    __attribute__((target("sse2")))
+    void _boundsSse2(const double *x, const double *y, unsigned long n, Point &min, Point &max) {
+        __m128d minX = _mm_set1_pd(min.x), minY = _mm_set1_pd(min.y);
+        __m128d maxX = _mm_set1_pd(max.x), maxY = _mm_set1_pd(max.y);
+        unsigned long i = 0;
+        for (; i + 2 <= n; i += 2) {
+            const __m128d vx = _mm_loadu_pd(x + i), vy = _mm_loadu_pd(y + i);
+            minX = _mm_min_pd(minX, vx), minY = _mm_min_pd(minY, vy);
+            maxX = _mm_max_pd(maxX, vx), maxY = _mm_max_pd(maxY, vy);
+        }
+        min = {_min2(minX), _min2(minY)}, max = {_max2(maxX), _max2(maxY)};
+        _boundsScalar(x + i, y + i, n - i, min, max);
+    }
+
+
+
+    //---- AVX2 ----//
+
+    __attribute__((target("avx2"))) inline
+    double _sum4(__m256d v) { return _sum2(_mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1))); }
+
+    __attribute__((target("avx2"))) inline
+    double _min4(__m256d v) { return _min2(_mm_min_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1))); }
+
+    __attribute__((target("avx2"))) inline
+    double _max4(__m256d v) { return _max2(_mm_max_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1))); }
+
+    __attribute__((target("avx2")))
+    double _shoelaceAvx2(const double *x, const double *y, unsigned long n) {
+        __m256d sum = _mm256_setzero_pd();
+        unsigned long i = 0;
+        for (; i + 4 <= n; i += 4) {
+            const __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(x + i + 1), _mm256_loadu_pd(x + i));
+            const __m256d sy = _mm256_add_pd(_mm256_loadu_pd(y + i + 1), _mm256_loadu_pd(y + i));
+            sum = _mm256_add_pd(sum, _mm256_mul_pd(dx, sy));
+        }
+        return _sum4(sum) + _shoelaceScalar(x + i, y + i, n - i);
+    }
+
+    __attribute__((target("avx2")))
+    double _lengthAvx2(const double *x, const double *y, unsigned long n) {
+        __m256d sum = _mm256_setzero_pd();
+        unsigned long i = 0;
+        for (; i + 4 <= n; i += 4) {
+            const __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(x + i + 1), _mm256_loadu_pd(x + i));
+            const __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(y + i + 1), _mm256_loadu_pd(y + i));
+            sum = _mm256_add_pd(sum, _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy))));
+        }
+        return _sum4(sum) + _lengthScalar(x + i, y + i, n - i);
+    }
+
+    __attribute__((target("avx2")))
+    Point _sumAvx2(const double *x, const double *y, unsigned long n) {
+        __m256d sumX = _mm256_setzero_pd(), sumY = _mm256_setzero_pd();
+        unsigned long i = 0;
+        for (; i + 4 <= n; i += 4) {
+            sumX = _mm256_add_pd(sumX, _mm256_loadu_pd(x + i));
+            sumY = _mm256_add_pd(sumY, _mm256_loadu_pd(y + i));
+        }
+        const Point rest = _sumScalar(x + i, y + i, n - i);
+        return {_sum4(sumX) + rest.x, _sum4(sumY) + rest.y};
+    }
+
+    __attribute__((target("avx2")))
+    void _boundsAvx2(const double *x, const double *y, unsigned long n, Point &min, Point &max) {
+        __m256d minX = _mm256_set1_pd(min.x), minY = _mm256_set1_pd(min.y);
+        __m256d maxX = _mm256_set1_pd(max.x), maxY = _mm256_set1_pd(max.y);
+        unsigned long i = 0;
+        for (; i + 4 <= n; i += 4) {
+            const __m256d vx = _mm256_loadu_pd(x + i), vy = _mm256_loadu_pd(y + i);
+            minX = _mm256_min_pd(minX, vx), minY = _mm256_min_pd(minY, vy);
+            maxX = _mm256_max_pd(maxX, vx), maxY = _mm256_max_pd(maxY, vy);
+        }
+        min = {_min4(minX), _min4(minY)};
+        max = {_max4(maxX), _max4(maxY)};
+        _boundsScalar(x + i, y + i, n - i, min, max);
+    }
+
+
+
+    //---- AVX-512 ----//
+
+    // (GCC's reductions and unmasked forms of some AVX-512 intrinsics merge into an
+    // uninitialized vector, which -Wall warns about; the zero-masked forms don't.)
+
+    __attribute__((target("avx512f"))) inline
+    __m256d _low4(__m512d v) { return _mm512_maskz_extractf64x4_pd(0xFF, v, 0); }
+
+    __attribute__((target("avx512f"))) inline
+    __m256d _high4(__m512d v) { return _mm512_maskz_extractf64x4_pd(0xFF, v, 1); }
+
+    __attribute__((target("avx512f"))) inline
+    double _sum8(__m512d v) { return _sum4(_mm256_add_pd(_low4(v), _high4(v))); }
+
+    __attribute__((target("avx512f"))) inline
+    double _min8(__m512d v) { return _min4(_mm256_min_pd(_low4(v), _high4(v))); }
+
+    __attribute__((target("avx512f"))) inline
+    double _max8(__m512d v) { return _max4(_mm256_max_pd(_low4(v), _high4(v))); }
+
+    __attribute__((target("avx512f")))
+    double _shoelaceAvx512(const double *x, const double *y, unsigned long n) {
+        __m512d sum = _mm512_setzero_pd();
+        unsigned long i = 0;
+        for (; i + 8 <= n; i += 8) {
+            const __m512d dx = _mm512_sub_pd(_mm512_loadu_pd(x + i + 1), _mm512_loadu_pd(x + i));
+            const __m512d sy = _mm512_add_pd(_mm512_loadu_pd(y + i + 1), _mm512_loadu_pd(y + i));
+            sum = _mm512_add_pd(sum, _mm512_mul_pd(dx, sy));
+        }
+        return _sum8(sum) + _shoelaceScalar(x + i, y + i, n - i);
+    }
+
+    __attribute__((target("avx512f")))
+    double _lengthAvx512(const double *x, const double *y, unsigned long n) {
+        __m512d sum = _mm512_setzero_pd();
+        unsigned long i = 0;
+        for (; i + 8 <= n; i += 8) {
+            const __m512d dx = _mm512_sub_pd(_mm512_loadu_pd(x + i + 1), _mm512_loadu_pd(x + i));
+            const __m512d dy = _mm512_sub_pd(_mm512_loadu_pd(y + i + 1), _mm512_loadu_pd(y + i));
+            sum = _mm512_add_pd(sum, _mm512_maskz_sqrt_pd(0xFF, _mm512_add_pd(_mm512_mul_pd(dx, dx), _mm512_mul_pd(dy, dy))));
+        }
+        return _sum8(sum) + _lengthScalar(x + i, y + i, n - i);
+    }
+
+    __attribute__((target("avx512f")))
+    Point _sumAvx512(const double *x, const double *y, unsigned long n) {
+        __m512d sumX = _mm512_setzero_pd(), sumY = _mm512_setzero_pd();
+        unsigned long i = 0;
+        for (; i + 8 <= n; i += 8) {
+            sumX = _mm512_add_pd(sumX, _mm512_loadu_pd(x + i));
+            sumY = _mm512_add_pd(sumY, _mm512_loadu_pd(y + i));
+        }
+        const Point rest = _sumScalar(x + i, y + i, n - i);
+        return {_sum8(sumX) + rest.x, _sum8(sumY) + rest.y};
+    }
+
+    __attribute__((target("avx512f")))
+    void _boundsAvx512(const double *x, const double *y, unsigned long n, Point &min, Point &max) {
+        __m512d minX = _mm512_set1_pd(min.x), minY = _mm512_set1_pd(min.y);
+        __m512d maxX = _mm512_set1_pd(max.x), maxY = _mm512_set1_pd(max.y);
+        unsigned long i = 0;
+        for (; i + 8 <= n; i += 8) {
+            const __m512d vx = _mm512_loadu_pd(x + i), vy = _mm512_loadu_pd(y + i);
+            minX = _mm512_maskz_min_pd(0xFF, minX, vx), minY = _mm512_maskz_min_pd(0xFF, minY, vy);
+            maxX = _mm512_maskz_max_pd(0xFF, maxX, vx), maxY = _mm512_maskz_max_pd(0xFF, maxY, vy);
+        }
+        min = {_min8(minX), _min8(minY)};
+        max = {_max8(maxX), _max8(maxY)};
+        _boundsScalar(x + i, y + i, n - i, min, max);
+    }
+
+#endif
+
+
+
+    //-------- METRIC DISPATCH --------//
+
+    double shoelaceSum(const double *x, const double *y, unsigned long n) {
+        switch (simd::level()) {
+#ifdef CONVEXPOLYGONS_SIMD_X86
+            case simd::Level::avx512: return _shoelaceAvx512(x, y, n);
+            case simd::Level::avx2: return _shoelaceAvx2(x, y, n);
+            case simd::Level::sse2: return _shoelaceSse2(x, y, n);
+#endif
+            default: return _shoelaceScalar(x, y, n);
+        }
+    }
+
+
+    double chainLength(const double *x, const double *y, unsigned long n) {
+        switch (simd::level()) {
+#ifdef CONVEXPOLYGONS_SIMD_X86
+            case simd::Level::avx512: return _lengthAvx512(x, y, n);
+            case simd::Level::avx2: return _lengthAvx2(x, y, n);
+            case simd::Level::sse2: return _lengthSse2(x, y, n);
+#endif
+            default: return _lengthScalar(x, y, n);
+        }
+    }
+
+
+    Point coordinateSum(const double *x, const double *y, unsigned long n) {
+        switch (simd::level()) {
+#ifdef CONVEXPOLYGONS_SIMD_X86
+            case simd::Level::avx512: return _sumAvx512(x, y, n);
+            case simd::Level::avx2: return _sumAvx2(x, y, n);
+            case simd::Level::sse2: return _sumSse2(x, y, n);
+#endif
+            default: return _sumScalar(x, y, n);
+        }
+    }
+
+
+    void coordinateBounds(const double *x, const double *y, unsigned long n, Point &min, Point &max) {
+        min = max = {x[0], y[0]};
+        switch (simd::level()) {
+#ifdef CONVEXPOLYGONS_SIMD_X86
+            case simd::Level::avx512: return _boundsAvx512(x, y, n, min, max);
+            case simd::Level::avx2: return _boundsAvx2(x, y, n, min, max);
+            case simd::Level::sse2: return _boundsSse2(x, y, n, min, max);
+#endif
+            default: return _boundsScalar(x, y, n, min, max);
+        }
+    }
+
+
+
+    //-------- POINT LOCATION KERNELS --------//
+
+    /*
+     * Every kernel runs the binary search of hull::contains() over the wedges of the polygon
+     * with apex at its first vertex O, with the same predicates. The SIMD ones run the searches
+     * of several points in lockstep (each lane with its own `left` and `right` indices, and
+     * gathering the vertices at its own `mid` index), until every lane is down to a triangle.
+     * Lanes whose point is aligned with O and a `mid` vertex, or on the boundary of the final
+     * triangle, are finished by the scalar kernel (which then checks whether the point is on that
+     * segment, or checks every edge, like hull::contains()).
+     */
+
+    //---- Scalar ----//
+
+    bool _locateScalar(const double *x, const double *y, unsigned long n, const Point &P) {
+        if (n == 0) return false;
+        const Point O = {x[0], y[0]};
+        if (n == 1) return P == O;
+        if (n == 2) return isInSegment(P, {O, {x[1], y[1]}});
+
+        unsigned long left = 1, right = n - 1;
+        while (right - left > 1) {
+            const unsigned long mid = (left + right)/2;
+            const Point M = {x[mid], y[mid]};
+            if      (_turn<true>(O, M, P))  left = mid;
+            else if (_turn<false>(O, M, P)) right = mid;
+            else return isInSegment(P, {O, M});
+        }
+
+        const Point L = {x[left], y[left]}, R = {x[right], y[right]};
+        if (_turn<false>(O, L, P) or _turn<false>(L, R, P) or _turn<false>(R, O, P)) return false;
+        if (_turn<true>(O, L, P) and _turn<true>(L, R, P) and _turn<true>(R, O, P)) return true;
+
+        // On the triangle's boundary: every edge and the bounding box are checked (see hull::contains())
+        Point min = O, max = O;
+        for (unsigned long i = 0; i < n; ++i) {
+            const unsigned long j = i + 1 < n ? i + 1 : 0;
+            if (_turn<false>({x[i], y[i]}, {x[j], y[j]}, P)) return false;
+            min = {std::min(min.x, x[i]), std::min(min.y, y[i])};
+            max = {std::max(max.x, x[i]), std::max(max.y, y[i])};
+        }
+        return numeric::leq(min.x, P.x) and numeric::leq(P.x, max.x) and
+               numeric::leq(min.y, P.y) and numeric::leq(P.y, max.y);
+    }
+
+    void _locateScalar(const double *x, const double *y, unsigned long n, const Point *P, unsigned long k,
+                       bool *result) {
+        for (unsigned long i = 0; i < k; ++i) result[i] = _locateScalar(x, y, n, P[i]);
+    }
+
+
+#ifdef CONVEXPOLYGONS_SIMD_X86
+
+    //---- AVX2 (4 points per iteration) ----//
+
+    __attribute__((target("avx2")))
+    void _locateAvx2(const double *x, const double *y, unsigned long n, const Point *P, unsigned long k,
+                     bool *result) {
+        const __m256d ox = _mm256_set1_pd(x[0]), oy = _mm256_set1_pd(y[0]);
+        const __m256i one = _mm256_set1_epi64x(1), last = _mm256_set1_epi64x(n - 1);
+        unsigned long i = 0;
+        for (; i + 4 <= k; i += 4) {
+            __m256d px, py;
+            _load4(P + i, px, py);
+            __m256i left = one, right = last;
+            __m256d aligned = _mm256_setzero_pd();  // lanes left to the scalar kernel
+
+            while (true) {
+                const __m256d active = _mm256_andnot_pd(aligned, _mm256_castsi256_pd(
+                        _mm256_cmpgt_epi64(_mm256_sub_epi64(right, left), one)));
+                if (_mm256_movemask_pd(active) == 0) break;
+
+                const __m256i mid = _mm256_srli_epi64(_mm256_add_epi64(left, right), 1);
+                const __m256d mx = _mm256_i64gather_pd(x, mid, 8), my = _mm256_i64gather_pd(y, mid, 8);
+                const __m256d cw = _mm256_and_pd(active, _turnVector4<true>(ox, oy, mx, my, px, py));
+                const __m256d ccw = _mm256_andnot_pd(cw, _mm256_and_pd(
+                        active, _turnVector4<false>(ox, oy, mx, my, px, py)));
+                aligned = _mm256_or_pd(aligned, _mm256_andnot_pd(_mm256_or_pd(cw, ccw), active));
+                left = _mm256_castpd_si256(
+                        _mm256_blendv_pd(_mm256_castsi256_pd(left), _mm256_castsi256_pd(mid), cw));
+                right = _mm256_castpd_si256(
+                        _mm256_blendv_pd(_mm256_castsi256_pd(right), _mm256_castsi256_pd(mid), ccw));
+            }
+
+            const __m256d lx = _mm256_i64gather_pd(x, left, 8), ly = _mm256_i64gather_pd(y, left, 8);
+            const __m256d rx = _mm256_i64gather_pd(x, right, 8), ry = _mm256_i64gather_pd(y, right, 8);
+            const int outside = _turnMask4<false>(ox, oy, lx, ly, px, py) | _turnMask4<false>(lx, ly, rx, ry, px, py)
+                                | _turnMask4<false>(rx, ry, ox, oy, px, py);
+            const int inside = _turnMask4<true>(ox, oy, lx, ly, px, py) & _turnMask4<true>(lx, ly, rx, ry, px, py)
+                               & _turnMask4<true>(rx, ry, ox, oy, px, py);
+            _store<4>(inside & ~outside, result + i);
+            const int boundary = _mm256_movemask_pd(aligned) | (~(inside | outside) & 0b1111);
+            for (int lanes = boundary; lanes; lanes &= lanes - 1) {
+                const unsigned long j = i + __builtin_ctz(lanes);
+                result[j] = _locateScalar(x, y, n, P[j]);
+            }
+        }
+        _locateScalar(x, y, n, P + i, k - i, result + i);
+    }
+
+
+
+    //---- AVX-512 (8 points per iteration) ----//
+
+    // `values[indices[i]]` for each lane `i` (see the note on the AVX-512 metrics)
+    __attribute__((target("avx512f"))) inline
+    __m512d _gather8(const double *values, __m512i indices) {
+        return _mm512_mask_i64gather_pd(_mm512_setzero_pd(), 0xFF, indices, values, 8);
+    }
+
+    __attribute__((target("avx512f")))
+    void _locateAvx512(const double *x, const double *y, unsigned long n, const Point *P, unsigned long k,
+                       bool *result) {
+        const __m512d ox = _mm512_set1_pd(x[0]), oy = _mm512_set1_pd(y[0]);
+        const __m512i one = _mm512_set1_epi64(1), last = _mm512_set1_epi64(n - 1);
+        unsigned long i = 0;
+        for (; i + 8 <= k; i += 8) {
+            __m512d px, py;
+            _load8(P + i, px, py);
+            __m512i left = one, right = last;
+            __mmask8 aligned = 0;  // lanes left to the scalar kernel
+
+            while (true) {
+                const __mmask8 active = _mm512_cmpgt_epi64_mask(_mm512_sub_epi64(right, left), one) & ~aligned;
+                if (active == 0) break;
+
+                const __m512i mid = _mm512_maskz_srli_epi64(0xFF, _mm512_add_epi64(left, right), 1);
+                const __m512d mx = _gather8(x, mid), my = _gather8(y, mid);
+                const __mmask8 cw = active & _turnMask8<true>(ox, oy, mx, my, px, py);
+                const __mmask8 ccw = active & ~cw & _turnMask8<false>(ox, oy, mx, my, px, py);
+                aligned |= active & ~(cw | ccw);
+                left = _mm512_mask_mov_epi64(left, cw, mid);
+                right = _mm512_mask_mov_epi64(right, ccw, mid);
+            }
+
+            const __m512d lx = _gather8(x, left), ly = _gather8(y, left);
+            const __m512d rx = _gather8(x, right), ry = _gather8(y, right);
+            const unsigned outside = _turnMask8<false>(ox, oy, lx, ly, px, py)
+                                     | _turnMask8<false>(lx, ly, rx, ry, px, py)
+                                     | _turnMask8<false>(rx, ry, ox, oy, px, py);
+            const unsigned inside = _turnMask8<true>(ox, oy, lx, ly, px, py)
+                                    & _turnMask8<true>(lx, ly, rx, ry, px, py)
+                                    & _turnMask8<true>(rx, ry, ox, oy, px, py);
+            _store<8>(inside & ~outside, result + i);
+            const unsigned boundary = aligned | (~(inside | outside) & 0xFF);
+            for (unsigned lanes = boundary; lanes; lanes &= lanes - 1) {
+                const unsigned long j = i + __builtin_ctz(lanes);
+                result[j] = _locateScalar(x, y, n, P[j]);
+            }
+        }
+        _locateScalar(x, y, n, P + i, k - i, result + i);
+    }
+
+#endif
+
+
+
+    //-------- POINT LOCATION DISPATCH --------//
+
+    void insideConvexPolygon(const double *x, const double *y, unsigned long n, const Point *P, unsigned long k,
+                             bool *result) {
+        if (n < 3) return _locateScalar(x, y, n, P, k, result);
+        switch (simd::level()) {
+#ifdef CONVEXPOLYGONS_SIMD_X86
+            case simd::Level::avx512: return _locateAvx512(x, y, n, P, k, result);
+            case simd::Level::avx2: return _locateAvx2(x, y, n, P, k, result);
+#endif
+            default: return _locateScalar(x, y, n, P, k, result);  // (no gathers before AVX2)
+        }
+    }
+
+}
@@ -1,7 +1,7 @@
 #include "geom.h"
 
 #include <numeric>  // std::accumulate
-#include <cmath>  // std::abs
+#include <cmath>  // std::abs, std::sqrt
 #include "errors.h"
 #include "details/numeric.h"
 
@@ -14,6 +14,10 @@ namespace geom {
         return u.x*v.y - u.y*v.x;
     }
 
+    double dotProd(const Vector2D &u, const Vector2D &v) {
+        return u.x*v.x + u.y*v.y;
+    }
+
     bool colinear(const Vector2D &u, const Vector2D &v) {
         return numeric::equal(u.x*v.y - u.y*v.x, 0);
     }
@@ -176,6 +180,15 @@ namespace geom {
     }
 
 
+
+    double distance(const Point &P, const Segment &seg) {
+        const Vector2D u = seg.direction(), v = P - seg.startPt;
+        const double t = dotProd(u, v), length2 = u.squaredNorm();
+        if (t <= 0 or length2 == 0) return v.norm();
+        if (t >= length2) return (P - seg.endPt).norm();
+        return std::abs(crossProd(u, v))/std::sqrt(length2);
+    }
+
     //---- IntersectResult ----//
 
     IntersectResult::IntersectResult(bool success, const Point &intersection)
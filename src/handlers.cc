@@ -1,10 +1,12 @@
 #include "details/handlers.h"
 
+#include <algorithm>  // std::remove
 #include <cassert>
 #include <iostream>
 #include "io-commands.h"  // save, load, list...
 #include "draw.h"  // draw
 #include "errors.h"
+#include "class/ScratchArena.h"
 #include "details/utils.h"  // getArgs
 
 
@@ -49,20 +51,45 @@ void handleIDManagement(const std::string &keyword, std::istream &argStream, Pol
 void handlePolygonMethod(const std::string &keyword, std::istream &argStream, PolygonMap &polygons) {
     std::string id;
     getArgs(argStream, id);
-    ConvexPolygon &pol = getPolygon(id, polygons);  // throws `UndefinedID` if nonexistent
-
-    if      (keyword == cmd::PRINT) printPolygon(id, pol);
-    else if (keyword == cmd::PRETTYPRINT) prettyPrint(id, pol);
-    else if (keyword == cmd::AREA) std::cout << pol.area() << std::endl;
-    else if (keyword == cmd::PERIMETER) std::cout << pol.perimeter() << std::endl;
-    else if (keyword == cmd::VERTICES) std::cout << pol.vertexCount() << std::endl;
-    else if (keyword == cmd::CENTROID) std::cout << pol.centroid() << std::endl;
+    const PolygonMap::Handle h = polygons.handle(id);  // throws `UndefinedID` if nonexistent
+    // (only some commands need the polygon decoded in compact mode)
+    auto pol = [&polygons, h]() -> const ConvexPolygon & { return polygons.get(h); };
+
+    if      (keyword == cmd::PRINT) printPolygon(id, pol());
+    else if (keyword == cmd::PRETTYPRINT) prettyPrint(id, pol());
+    else if (keyword == cmd::AREA) std::cout << polygons.area(h) << std::endl;
+    else if (keyword == cmd::PERIMETER) std::cout << polygons.perimeter(h) << std::endl;
+    else if (keyword == cmd::VERTICES) std::cout << pol().vertexCount() << std::endl;
+    else if (keyword == cmd::CENTROID) std::cout << pol().centroid() << std::endl;
+    else if (keyword == cmd::DIAMETER or keyword == cmd::WIDTH) {
+        const geom::Segment seg = keyword == cmd::DIAMETER ? diameter(pol()) : width(pol());
+        std::cout << distance(seg.startPt, seg.endPt) << ' ' << seg.startPt << ' ' << seg.endPt << std::endl;
+    }
     else if (keyword == cmd::SETCOL) {
         double r, g, b;
         getArgs(argStream, r, g, b);
-        pol.setColor(RGBColor{r, g, b});
+        polygons.modify(h, [r, g, b](ConvexPolygon &modified) { modified.setColor(RGBColor{r, g, b}); });
+        printOk();
+    }
+    else if (keyword == cmd::INSERT) {
+        const Points points = readVector<Point>(argStream);
+        if (points.empty()) throw error::SyntaxError("no points to insert");
+        polygons.modify(h, [&points](ConvexPolygon &modified) {
+            for (const Point &P : points) modified.insert(P);
+        });
         printOk();
     }
+    else if (keyword == cmd::CLASSIFY) {
+        const Points points = readVector<Point>(argStream);
+        if (points.empty()) throw error::SyntaxError("no points to classify");
+        printClassification(pol(), points);
+    }
+    else if (keyword == cmd::CLASSIFY_FILE) {
+        std::string file;
+        getArgs(argStream, file);
+        prefixPath(file, io::OUT_DIR);
+        printClassification(pol(), loadPoints(file));
+    }
     else assert(false);  // Shouldn't get here
 }
 
@@ -76,15 +103,9 @@ void handleBinaryOperation(const std::string &keyword, std::istream &argStream,
     const ConvexPolygon &p1 = getPolygon(id3.empty() ? id1 : id2, polygons);
     const ConvexPolygon &p2 = getPolygon(id3.empty() ? id2 : id3, polygons);
 
-    if      (keyword == cmd::INSIDE) {
-        std::cout << (isInside(p1, p2) ? "yes" : "no") << std::endl;
-        return;
-    }
-    else if (keyword == cmd::UNION) polygons[id1] = convexUnion(p1, p2);
-    else if (keyword == cmd::INTERSECTION) polygons[id1] = intersection(p1, p2);
+    if (keyword == cmd::INSIDE) std::cout << (isInside(p1, p2) ? "yes" : "no") << std::endl;
+    else if (keyword == cmd::INTERSECTS) std::cout << (intersects(p1, p2) ? "yes" : "no") << std::endl;
     else assert(false);
-
-    printOk();
 }
 
 
@@ -92,15 +113,55 @@ void handleNAryOperation(const std::string &keyword, std::istream &argStream, Po
     std::string id;
     getArgs(argStream, id);
     std::vector<std::string> polIDs = readVector<std::string>(argStream);
+    const bool binary = keyword == cmd::UNION or keyword == cmd::INTERSECTION or keyword == cmd::MINKOWSKI;
+    if (binary and polIDs.empty()) throw error::SyntaxError("expected at least two polygon IDs");
+    if (binary and polIDs.size() == 1) polIDs.insert(polIDs.begin(), id);  // `id` gets updated with the result
+    // (looked up first, so that nothing is assigned if some ID is undefined)
+    const std::vector<PolygonMap::Handle> handles = getHandles(polIDs, polygons);
 
     if (keyword == cmd::BBOX)
-        polygons[id] = boundingBox(getPolygons(polIDs, polygons));
+        polygons.assign(id, polygons.boundingBox(handles));  // (without decoding them in compact mode)
+    else if (keyword == cmd::RECTANGLE)
+        polygons.assign(id, minAreaRectangle(convexUnion(getPolygons(handles, polygons))));
+    else if (keyword == cmd::UNION or keyword == cmd::INTERSECTION) {
+        ConvexPolygon result = keyword == cmd::UNION ? convexUnion(getPolygons(handles, polygons))
+                                                     : intersection(getPolygons(handles, polygons));
+        polygons.assign(id, std::move(result));
+    }
+    else if (keyword == cmd::MINKOWSKI) {
+        ConvexPolygon result;
+        bool first = true;
+        for (const ConvexPolygon &pol : getPolygons(handles, polygons)) {
+            result = first ? pol : minkowskiSum(result, pol);
+            first = false;
+        }
+        result.setColor(RGBColor());
+        polygons.assign(id, std::move(result));
+    }
     else assert(false);
 
     printOk();
 }
 
 
+void handleSpatialQuery(const std::string &keyword, std::istream &argStream, PolygonMap &polygons) {
+    if (keyword == cmd::CONTAINING) {
+        Point P;
+        getArgs(argStream, P);
+        printIDs(polygons.ids(polygons.containing(P)));
+    }
+    else if (keyword == cmd::OVERLAPPING) {
+        std::string id;
+        getArgs(argStream, id);
+        const PolygonMap::Handle h = polygons.handle(id);  // throws `UndefinedID` if nonexistent
+        std::vector<PolygonMap::Handle> handles = polygons.overlapping(polygons.get(h));
+        handles.erase(std::remove(handles.begin(), handles.end(), h), handles.end());  // (not the polygon itself)
+        printIDs(polygons.ids(handles));
+    }
+    else assert(false);  // Shouldn't get here
+}
+
+
 void handleIOCommand(const std::string &keyword, std::istream &argStream, PolygonMap &polygons) {
     std::string file;
     argStream >> file;
@@ -110,8 +171,8 @@ void handleIOCommand(const std::string &keyword, std::istream &argStream, Polygo
 
     if (keyword == cmd::SAVE) save(file, polygonIDs, polygons);
     else if (keyword == cmd::LOAD) load(file, polygons);
-    else if (keyword == cmd::DRAW) draw(file, getPolygons(polygonIDs, polygons));
-    else if (keyword == cmd::PAINT) draw(file, getPolygons(polygonIDs, polygons), true);
+    else if (keyword == cmd::DRAW) draw(file, getPolygons(getHandles(polygonIDs, polygons), polygons));
+    else if (keyword == cmd::PAINT) draw(file, getPolygons(getHandles(polygonIDs, polygons), polygons), true);
     else if (keyword == cmd::INCLUDE) include(file, polygons);
     else assert(false); // Shouldn't get here
 
@@ -121,9 +182,22 @@ void handleIOCommand(const std::string &keyword, std::istream &argStream, Polygo
 
 void handleNullaryCommand(const std::string &keyword, std::istream &argStream, PolygonMap &polygons) {
     if (keyword == cmd::LIST) list(polygons);
+    else if (keyword == cmd::STATS) printStats();
     else assert(false); // Shouldn't get here
 }
 
+
+void handleSessionSetting(const std::string &keyword, std::istream &argStream, PolygonMap &polygons) {
+    std::string value;
+    getArgs(argStream, value);
+    if (value != "on" and value != "off") throw error::SyntaxError("expected `on` or `off`");
+
+    if (keyword == cmd::COMPACT) polygons.setCompact(value == "on");
+    else assert(false); // Shouldn't get here
+
+    printOk();
+}
+
 // -------------------
 
 
@@ -137,6 +211,7 @@ CommandHandler getCommandHandler(const std::string &keyword) {
 // Check whether command is valid and run corresponding handler
 void parseCommand(const std::string &command, PolygonMap &polygonMap) {
     if (command.empty()) return;  // ignore empty lines
+    ScratchArena::Scope scratch;  // (the temporaries of the whole command are freed at once, at the end)
 
     try {
         std::istringstream iss(command);
@@ -154,4 +229,5 @@ void parseCommand(const std::string &command, PolygonMap &polygonMap) {
     } catch (error::Warning &warning) {
         printWarning(warning.what());
     }
+    polygonMap.release();  // (in compact mode, the polygons decoded by the command are encoded again)
 }
@@ -0,0 +1,907 @@
+#include "hull.h"
+
+#include <algorithm>  // std::sort, std::unique, std::inplace_merge, std::merge, std::all_of, std::find, std::min, std::max
+#include <iterator>  // std::begin, std::end
+#include <future>
+#include <cmath>  // std::cbrt, std::sqrt, INFINITY
+#include <boost/range/adaptors.hpp> // boost::adaptors::uniqued
+#include "geom.h"
+#include "class/ScratchArena.h"
+#include "class/ThreadPool.h"
+#include "errors.h"
+#include "details/numeric.h"
+
+using namespace geom;
+
+
+namespace hull {
+
+    //-------- INTERNAL UTILITIES --------//
+
+    // Extends an upper chain with a range of points sorted by comp::xCoord,
+    // keeping only clockwise turns (stack-based monotone chain step)
+    template<typename Chain, typename Iterator>
+    inline
+    void _extendUpper(Chain &chain, Iterator begin, Iterator end) {
+        for (auto it = begin; it != end; ++it) {
+            while (chain.size() >= 2 and not isClockwiseTurn(chain.end()[-2], chain.end()[-1], *it))
+                chain.pop_back();
+            chain.push_back(*it);
+        }
+    }
+
+    // Same as _extendUpper, but for lower chains (keeps counter-clockwise turns)
+    template<typename Chain, typename Iterator>
+    inline
+    void _extendLower(Chain &chain, Iterator begin, Iterator end) {
+        for (auto it = begin; it != end; ++it) {
+            while (chain.size() >= 2 and not isCounterClockwiseTurn(chain.end()[-2], chain.end()[-1], *it))
+                chain.pop_back();
+            chain.push_back(*it);
+        }
+    }
+
+    // Joins an upper and a lower chain (which start and end at the same points) into
+    // a clockwise cycle, in `hull`: the upper chain, and then the lower chain backwards
+    // (which ends with the leftmost point, completing the cycle). Allocates it at once.
+    template<typename Chain, typename Hull>
+    void _join(const Chain &upper, const Chain &lower, Hull &hull) {
+        hull.reserve(upper.size() + lower.size() - 1 + (upper.size() == 1));
+        hull.assign(upper.begin(), upper.end());
+        hull.insert(hull.end(), lower.rbegin() + 1, lower.rend());
+        if (hull.size() == 1) hull.push_back(hull.front());  // single point
+    }
+
+    // Monotone chain algorithm (see monotoneChain()) over an array of points, which is
+    // sorted in place; the chains are built in the thread's arena, and the hull in `hull`
+    template<typename Hull>
+    void _monotoneChain(Point *points, unsigned long n, Hull &hull) {
+        hull.clear();
+        if (n == 0) return;
+
+        // Sort the points lexicographically and skip duplicates:
+        std::sort(points, points + n, comp::xCoord);
+        const Point *last = std::unique(points, points + n);
+
+        /*
+         * Sweep from left to right building both chains at once: the upper chain
+         * only keeps clockwise turns and the lower chain only keeps counter-clockwise
+         * turns. Both chains start at the leftmost point and end at the rightmost one.
+         */
+        ScratchArena::Scope scratch;
+        ScratchVector<Point> upper(scratch.resource()), lower(scratch.resource());
+        for (const Point *it = points; it != last; ++it) {
+            _extendUpper(upper, it, it + 1);
+            _extendLower(lower, it, it + 1);
+        }
+
+        _join(upper, lower, hull);
+    }
+
+    // Sorts a vector of points with comp::xCoord by sorting chunks in parallel
+    // and then merging them pairwise (also in parallel)
+    void _parallelSort(Points &points, unsigned chunks, ThreadPool &pool) {
+        std::vector<Points::iterator> bounds;  // chunk i is [bounds[i], bounds[i + 1])
+        for (unsigned i = 0; i <= chunks; ++i)
+            bounds.push_back(points.begin() + points.size()*i/chunks);
+
+        std::vector<std::future<void>> tasks;
+        for (unsigned i = 0; i < chunks; ++i)
+            tasks.push_back(pool.submit([&bounds, i]{ std::sort(bounds[i], bounds[i + 1], comp::xCoord); }));
+        for (auto &task : tasks) pool.get(task);
+
+        // Merge pairs of adjacent sorted runs until there's a single one left:
+        for (unsigned step = 1; step < chunks; step *= 2) {
+            tasks.clear();
+            for (unsigned i = 0; i + step < chunks; i += 2*step) {
+                auto first = bounds[i], middle = bounds[i + step], last = bounds[std::min(i + 2*step, chunks)];
+                tasks.push_back(pool.submit([=]{ std::inplace_merge(first, middle, last, comp::xCoord); }));
+            }
+            for (auto &task : tasks) pool.get(task);
+        }
+    }
+
+    // Removes duplicates from a vector of points sorted with comp::xCoord (like
+    // std::unique + erase) by removing them from each chunk in parallel and then
+    // compacting the chunks (skipping duplicates across chunk boundaries)
+    void _parallelUnique(Points &points, unsigned chunks, ThreadPool &pool) {
+        std::vector<Points::iterator> bounds, ends(chunks);  // chunk i is [bounds[i], ends[i]) after removal
+        for (unsigned i = 0; i <= chunks; ++i)
+            bounds.push_back(points.begin() + points.size()*i/chunks);
+
+        std::vector<std::future<void>> tasks;
+        for (unsigned i = 0; i < chunks; ++i)
+            tasks.push_back(pool.submit([&bounds, &ends, i]{ ends[i] = std::unique(bounds[i], bounds[i + 1]); }));
+        for (auto &task : tasks) pool.get(task);
+
+        auto out = ends[0];
+        for (unsigned i = 1; i < chunks; ++i) {
+            auto first = bounds[i];
+            while (first != ends[i] and *first == out[-1]) ++first;
+            out = std::move(first, ends[i], out);
+        }
+        points.erase(out, points.end());
+    }
+
+
+    // Cross product of PA and PB, with the same arithmetic as geom::crossProd(A - P, B - P)
+    // (positive iff P, A, B is a counter-clockwise turn), but cheap enough to inline
+    inline
+    double _cross(const Point &P, const Point &A, const Point &B) {
+        return (A.x - P.x)*(B.y - P.y) - (A.y - P.y)*(B.x - P.x);
+    }
+
+    // Whether A is a better gift-wrapping candidate than B for the hull edge starting
+    // at P: A lies strictly counter-clockwise of the ray PB, or on it but farther from P.
+    // If `clockwise`, the same with clockwise instead (for wrapping in the opposite direction).
+    inline
+    bool _wrapsBetter(const Point &P, const Point &A, const Point &B, bool clockwise = false) {
+        if (B == P) return A != P;
+        const double cross = clockwise ? -_cross(P, B, A) : _cross(P, B, A);
+        if (numeric::greater(cross, 0)) return true;
+        if (numeric::less(cross, 0)) return false;
+        return (A - P).squaredNorm() > (B - P).squaredNorm();
+    }
+
+    // Exhaustive search version of tangent()
+    unsigned long _linearTangent(const Point &P, const Point *V, unsigned long n, bool clockwise) {
+        unsigned long best = 0;
+        for (unsigned long i = 1; i < n; ++i)
+            if (_wrapsBetter(P, V[i], V[best], clockwise)) best = i;
+        return best;
+    }
+
+    // Number of vertices of the hull of (at most) CHAN_SAMPLE_SIZE evenly spaced points
+    unsigned long _sampleHullSize(const Points &points) {
+        const unsigned long size = std::min(CHAN_SAMPLE_SIZE, (unsigned long) points.size());
+        if (size == 0) return 0;
+
+        ScratchArena::Scope scratch;
+        ScratchVector<Point> sample(size, scratch.resource());
+        for (unsigned long i = 0; i < size; ++i)
+            sample[i] = points[i*points.size()/size];
+        ScratchVector<Point> hull(scratch.resource());
+        _monotoneChain(sample.data(), size, hull);
+        return hull.size() - 1;
+    }
+
+    /*
+     * A round of Chan's algorithm with groups of (at most) m points. Computes the hull
+     * of each group and then gift-wraps the groups, finding the next vertex among
+     * the tangents from the current one to each group's hull. If the hull has more
+     * than m vertices, returns an empty vector and replaces the points with the
+     * vertices of the groups' hulls (the only candidates left for the next round).
+     */
+    Points _chanRound(Points &points, unsigned long m, std::pmr::memory_resource *scratch) {
+        // Hulls of the groups, one after the other (each one closed, as usual):
+        ScratchVector<Point> groupHulls(scratch), upper(scratch), lower(scratch);
+        ScratchVector<unsigned long> bounds(1, 0, scratch);  // group i's hull is [bounds[i], bounds[i + 1])
+        for (unsigned long i = 0; i < points.size(); i += m) {
+            const auto first = points.begin() + i, last = points.begin() + std::min(i + m, points.size());
+            std::sort(first, last, comp::xCoord);
+            const auto uniqueLast = std::unique(first, last);
+
+            upper.clear(); lower.clear();
+            _extendUpper(upper, first, uniqueLast);
+            _extendLower(lower, first, uniqueLast);
+            groupHulls.insert(groupHulls.end(), upper.begin(), upper.end());
+            groupHulls.insert(groupHulls.end(), lower.rbegin() + 1, lower.rend());
+            if (upper.size() == 1) groupHulls.push_back(upper.front());  // single point
+            bounds.push_back(groupHulls.size());
+        }
+
+        const unsigned long groups = bounds.size() - 1;
+        auto vertex = [&](unsigned long group, unsigned long i) -> const Point & { return groupHulls[bounds[group] + i]; };
+        auto vertexCount = [&](unsigned long group) { return bounds[group + 1] - bounds[group] - 1; };
+
+        // Start at the leftmost point, which is the first vertex of its group's hull:
+        unsigned long group = 0, index = 0;
+        for (unsigned long g = 1; g < groups; ++g)
+            if (comp::xCoord(vertex(g, 0), vertex(group, 0))) group = g;
+
+        ScratchVector<Point> hull({vertex(group, 0)}, scratch);
+        while (true) {
+            const Point &P = hull.back();
+
+            // Within its own group, the best candidate is simply the next vertex:
+            unsigned long bestGroup = group, bestIndex = (index + 1)%vertexCount(group);
+            for (unsigned long g = 0; g < groups; ++g) {
+                if (g == group) continue;
+                const unsigned long i = tangent(P, &vertex(g, 0), vertexCount(g));
+                if (_wrapsBetter(P, vertex(g, i), vertex(bestGroup, bestIndex))) bestGroup = g, bestIndex = i;
+            }
+
+            if (vertex(bestGroup, bestIndex) == hull.front()) break;  // the cycle is complete
+            if (hull.size() == m) {
+                // Too many vertices for this round. Points that aren't vertices of their group's
+                // hull can't be vertices of the whole hull, so only keep the groups' vertices:
+                points.clear();
+                for (unsigned long g = 0; g < groups; ++g)
+                    points.insert(points.end(), &vertex(g, 0), &vertex(g, 0) + vertexCount(g));
+                return {};
+            }
+            hull.push_back(vertex(bestGroup, bestIndex));
+            group = bestGroup, index = bestIndex;
+        }
+
+        hull.push_back(hull.front());  // complete the cycle
+        return Points(hull.begin(), hull.end());
+    }
+
+
+
+    //-------- HULL ALGORITHMS --------//
+
+    Points monotoneChain(Points points) {
+        return monotoneChain(points.data(), points.size());
+    }
+
+
+    Points monotoneChain(Point *points, unsigned long n) {
+        Points hull;
+        _monotoneChain(points, n, hull);
+        return hull;
+    }
+
+
+    Points parallelMonotoneChain(Points points, unsigned chunks) {
+        ThreadPool &pool = ThreadPool::shared();
+        if (chunks == 0) chunks = pool.size();
+        chunks = (unsigned) std::min<unsigned long>(chunks, points.size());
+        if (chunks <= 1) return monotoneChain(move(points));
+
+        _parallelSort(points, chunks, pool);
+        _parallelUnique(points, chunks, pool);
+
+        /*
+         * Only the sort and the removal of duplicates run in parallel: the chains are
+         * built in a single serial pass over all of the sorted points, exactly like in
+         * monotoneChain(). (Building the chains of each chunk separately and then joining
+         * them doesn't give the same vertices, since the turn tests use a tolerance and
+         * so aren't transitive: a point dropped from a chunk's chain might have been kept
+         * by the serial scan, and vice versa.)
+         */
+        ScratchArena::Scope scratch;
+        ScratchVector<Point> upper(scratch.resource()), lower(scratch.resource());
+        _extendUpper(upper, points.cbegin(), points.cend());
+        _extendLower(lower, points.cbegin(), points.cend());
+
+        Points hull;
+        _join(upper, lower, hull);
+        return hull;
+    }
+
+
+    Points chan(Points points) {
+        if (points.empty()) return {};
+
+        /*
+         * Guess the number of hull vertices, squaring the guess after every failed round.
+         * The first guess is extrapolated from the hull of a sample, so that we usually
+         * don't waste rounds on guesses that are too small: for random points, hull sizes
+         * grow at most like the cube root of the number of points (uniformly distributed
+         * in a disk), and we add some headroom.
+         */
+        const double scale = std::cbrt(double(points.size())/CHAN_SAMPLE_SIZE);
+        const auto firstGuess = (unsigned long) (2*_sampleHullSize(points)*std::max(1.0, scale));
+        ScratchArena::Scope scratch;
+        for (unsigned long m = std::max(16ul, firstGuess); m < points.size(); m *= m) {
+            Points hull = _chanRound(points, m, scratch.resource());
+            if (hull.empty()) continue;
+
+            /*
+             * The turn tests use a tolerance, so they aren't transitive: gift-wrapping the
+             * groups' hulls can keep vertices that are within the tolerance of being collinear
+             * with their neighbours (or miss some), which the scan over all of the points would
+             * have dropped. So the wrapped vertices are scanned again, in O(h log(h)).
+             */
+            hull.pop_back();
+            return monotoneChain(move(hull));
+        }
+        return monotoneChain(move(points));  // one group with all of the points
+    }
+
+
+    Points grahamScan(Points points) {
+        if (points.empty()) return {};
+
+        const auto begin = points.begin(), end = points.end();  // aliases
+        // Get point with lowest y coordinate:
+        const Point P0 = *min_element(begin, end, comp::xCoord);
+        // Sort the points in decreasing order of the angle they form with x-axis (relative to P0):
+        sort(begin, end, comp::yAngle{P0});
+
+        // Graham scan:
+        Points hull;
+        for (const Point &P : points | boost::adaptors::uniqued) {  // the uniqued adaptor skips duplicates
+            while (hull.size() >= 2 and not isClockwiseTurn(hull.end()[-2], hull.end()[-1], P))
+                hull.pop_back();
+            hull.push_back(P);
+        }
+
+        hull.push_back(hull.front());  // complete the cycle
+        return hull;
+    }
+
+
+    bool isHull(const Point *vertices, unsigned long size) {
+        if (size == 0) return true;
+        if (size == 1 or vertices[0] != vertices[size - 1]) return false;
+        const unsigned long n = size - 1;  // number of vertices
+        if (n == 1) return true;  // single point
+        if (n == 2) return comp::xCoord(vertices[0], vertices[1]) and vertices[0] != vertices[1];  // segment
+
+        /*
+         * In lexicographical order, the vertices of a convex polygon increase from the first
+         * (leftmost) vertex up to the rightmost one, and then decrease back (upper and
+         * lower chains). Together with strictly clockwise turns at every vertex, this
+         * ensures that the polygon is convex and doesn't wind around more than once.
+         */
+        unsigned long i = 1;
+        while (i < n and comp::xCoord(vertices[i - 1], vertices[i])) ++i;
+        while (i <= n and comp::xCoord(vertices[i], vertices[i - 1])) ++i;
+        if (i <= n) return false;
+
+        // Turns at every vertex (the one at the first vertex wraps around the end):
+        return isClockwiseTurn(vertices[n - 1], vertices[0], vertices[1])
+               and allClockwiseTurns(vertices, n + 1);
+    }
+
+
+
+    //-------- TANGENTS --------//
+
+    /*
+     * Binary search for the vertex where the edges of the polygon stop turning towards the
+     * wrapping direction as seen from P (after D. Sunday's tangent search for convex polygons).
+     * The result is verified against its two neighbours; in degenerate situations where the
+     * search isn't reliable (P on the polygon's boundary, numerical ties) we fall back to
+     * an exhaustive search.
+     */
+    unsigned long tangent(const Point &P, const Point *V, unsigned long n, bool clockwise) {
+        if (n <= 4) return _linearTangent(P, V, n, clockwise);
+
+        // whether A is strictly further in the wrapping direction (above) / strictly less (below) than B:
+        const double sign = clockwise ? -1 : 1;
+        auto above = [&](const Point &A, const Point &B) { return numeric::greater(sign*_cross(P, B, A), 0); };
+        auto below = [&](const Point &A, const Point &B) { return numeric::less(sign*_cross(P, B, A), 0); };
+
+        unsigned long result = 0;
+        if (not (below(V[1], V[0]) and not above(V[n - 1], V[0]))) {
+            for (unsigned long a = 0, b = n; b - a >= 2; ) {
+                const unsigned long c = (a + b)/2;
+                const bool downC = below(V[c + 1], V[c]);
+                if (downC and not above(V[c - 1], V[c])) { result = c; break; }
+
+                // pick the sub-chain [a, c] or [c, b] that contains the maximum:
+                if (above(V[a + 1], V[a])) {
+                    if (downC or above(V[a], V[c])) b = c;
+                    else a = c;
+                }
+                else {
+                    if (downC and below(V[a], V[c])) b = c;
+                    else a = c;
+                }
+            }
+        }
+
+        const Point &prev = V[result == 0 ? n - 1 : result - 1], &next = V[result + 1];
+        if (_wrapsBetter(P, prev, V[result], clockwise) or _wrapsBetter(P, next, V[result], clockwise))
+            return _linearTangent(P, V, n, clockwise);
+        return result;
+    }
+
+
+    // First index i in [a, b) such that `rises(V[i], V[i + 1])` is false (or `b` if there's none),
+    // given that it's true for the indices before it and false for the ones after it
+    template<typename Predicate>
+    unsigned long _firstFall(const Point *V, unsigned long a, unsigned long b, Predicate rises) {
+        while (a < b) {
+            const unsigned long c = a + (b - a)/2;
+            if (rises(V[c], V[c + 1])) a = c + 1;
+            else b = c;
+        }
+        return a;
+    }
+
+
+    unsigned long extreme(const Vector2D &d, const Point *V, unsigned long n) {
+        // The upper chain goes from the first vertex up to the rightmost one, and the lower
+        // chain comes back. Along each of them, the edges turn clockwise by less than pi, so
+        // their projection onto `d` is positive up to the extreme vertex and negative afterwards
+        // (for `d` pointing upwards in the upper chain, and downwards in the lower one).
+        const unsigned long right = _firstFall(V, 0, n - 1, comp::xCoord);
+        auto rises = [&d](const Point &A, const Point &B) { return dotProd(d, B - A) > 0; };
+        if (d.y > 0) return _firstFall(V, 0, right, rises);
+        if (d.y < 0) return _firstFall(V, right, n, rises) % n;
+        return d.x > 0 ? right : 0;
+    }
+
+
+    // Whether P isn't on the left side of any edge of a convex polygon (with at least 3 vertices), nor
+    // outside its bounding box (which rules out the points far along the line of an edge when the polygon
+    // is thin). Points on the boundary count as inside, within the tolerance of the turn tests.
+    inline
+    bool _onRightOfEdges(const Point &P, const Point *vertices, unsigned long n) {
+        Point min = vertices[0], max = vertices[0];
+        for (unsigned long i = 0; i < n; ++i) {
+            if (isCounterClockwiseTurn(vertices[i], vertices[(i + 1)%n], P)) return false;
+            min = {std::min(min.x, vertices[i].x), std::min(min.y, vertices[i].y)};
+            max = {std::max(max.x, vertices[i].x), std::max(max.y, vertices[i].y)};
+        }
+        return numeric::leq(min.x, P.x) and numeric::leq(P.x, max.x) and
+               numeric::leq(min.y, P.y) and numeric::leq(P.y, max.y);
+    }
+
+
+    bool contains(const Point &P, const Point *vertices, unsigned long n) {
+        if (n == 0) return false;
+        const Point &O = vertices[0];
+
+        // Special cases:
+        if (n == 1) return P == O;
+        if (n == 2) return isInSegment(P, {O, vertices[1]});
+
+
+        /*
+         * Here we begin a binary search: given a fixed vertex O (in this case the
+         * first vertex), and starting with the two vertices that are adjacent to O,
+         * at every iteration we bisect the polygon by tracing a segment between O and the
+         * median of the left and right vertices; then, we test whether `P` is to the
+         * left or to the right of the bisector segment, and we update the indices
+         * accordingly. We end up with a triangle, one of whose edges lies on the polygon.
+         */
+
+        unsigned long left = 1, right = n - 1;
+        while (right - left > 1) {
+            unsigned long mid = (left + right)/2;
+            if      (isClockwiseTurn(O, vertices[mid], P))          left = mid;
+            else if (isCounterClockwiseTurn(O, vertices[mid], P))   right = mid;
+            else return isInSegment(P, {O, vertices[mid]});
+        }
+
+        // Return whether P is in the final triangle, by testing if P is on the right side of each edge:
+        const Point &leftVertex = vertices[left], &rightVertex = vertices[right];
+        if (isCounterClockwiseTurn(O, leftVertex, P) or isCounterClockwiseTurn(leftVertex, rightVertex, P) or
+            isCounterClockwiseTurn(rightVertex, O, P)) return false;
+        if (isClockwiseTurn(O, leftVertex, P) and isClockwiseTurn(leftVertex, rightVertex, P) and
+            isClockwiseTurn(rightVertex, O, P)) return true;
+
+        // P is on the triangle's boundary, within the tolerance of the turn tests. If the polygon has
+        // nearly collinear vertices, the triangle can be so thin that this also takes in points along
+        // the line of an edge, past its ends, which only the rest of the polygon rules out:
+        return _onRightOfEdges(P, vertices, n);
+    }
+
+
+    /*
+     * Whether the points in [first, last), sorted by x, are on the inner side of a chain
+     * of a hull, given as [chain, chainEnd) sorted by x (at least two vertices). The inner
+     * side is the right one for the upper chain (clockwise), and the left one for the lower
+     * chain (since it's read backwards). Points on the chain count as inside. The chain is
+     * walked along with the points, with the edge whose x range spans each of them (not a
+     * vertical one, which can only be the first or last edge).
+     */
+    template<typename PointIt, typename ChainIt>
+    bool _insideChain(PointIt first, PointIt last, ChainIt chain, ChainIt chainEnd, bool upper) {
+        for (; first != last; ++first) {
+            const Point &P = *first;
+            while (chainEnd - chain > 2 and (chain[1].x < P.x or chain[0].x == chain[1].x)) ++chain;
+            if (upper ? isCounterClockwiseTurn(chain[0], chain[1], P) : isClockwiseTurn(chain[0], chain[1], P))
+                return false;
+        }
+        return true;
+    }
+
+
+    bool contains(const Point *V, unsigned long n, const Point *W, unsigned long m) {
+        if (n < 3 or m*CONTAINS_SEARCH_RATIO <= n)
+            return std::all_of(W, W + m, [V, n](const Point &P) { return contains(P, V, n); });
+
+        // The upper chain of a hull goes from its first vertex to its rightmost one,
+        // and the lower chain comes back (so it's sorted if read backwards):
+        const Point *rightV = std::max_element(V, V + n, comp::xCoord);
+        const Point *rightW = std::max_element(W, W + m, comp::xCoord);
+        typedef std::reverse_iterator<const Point *> Backwards;
+        if (numeric::less(W[0].x, V[0].x) or numeric::greater(rightW->x, rightV->x)) return false;
+
+        const Backwards lowerV(V + n + 1), lowerVEnd(rightV), lowerW(W + m + 1), lowerWEnd(rightW);
+        return _insideChain(W, rightW + 1, V, rightV + 1, true)
+               and _insideChain(W, rightW + 1, lowerV, lowerVEnd, false)
+               and _insideChain(lowerW, lowerWEnd, V, rightV + 1, true)
+               and _insideChain(lowerW, lowerWEnd, lowerV, lowerVEnd, false);
+    }
+
+
+
+    // Point of the segment AB closest to the origin, and its parameter `t` (0 at A, 1 at B)
+    Point _closestToOrigin(const Point &A, const Point &B, double &t) {
+        const Vector2D AB = B - A;
+        const double length2 = AB.squaredNorm();
+        t = length2 == 0 ? 0 : std::max(0., std::min(1., -dotProd(A - Point{0, 0}, AB)/length2));
+        return A + t*AB;
+    }
+
+
+    /*
+     * Reduces a GJK simplex (a segment or a triangle) to the smallest face that contains
+     * its closest point to the origin, which is stored in `v`. Returns whether the origin
+     * is inside the simplex (a non-degenerate triangle, or on its boundary).
+     */
+    bool _reduceSimplex(Point *simplex, unsigned &size, Point &v) {
+        const Point O{0, 0};
+        if (size == 3) {
+            const Point &A = simplex[0], &B = simplex[1], &C = simplex[2];
+            const double area = crossProd(B - A, C - A);
+            const double sides[3] = {crossProd(B - A, O - A), crossProd(C - B, O - B), crossProd(A - C, O - C)};
+            if (area != 0 and std::all_of(sides, sides + 3, [area](double side) { return side*area >= 0; }))
+                return true;
+
+            // otherwise, the closest point is on one of the edges:
+            double bestDist = INFINITY; unsigned bestEdge = 0;
+            for (unsigned i = 0; i < 3; ++i) {
+                double t;
+                const double dist = (_closestToOrigin(simplex[i], simplex[(i + 1)%3], t) - O).squaredNorm();
+                if (dist < bestDist) { bestDist = dist; bestEdge = i; }
+            }
+            const Point edge[2] = {simplex[bestEdge], simplex[(bestEdge + 1)%3]};
+            simplex[0] = edge[0]; simplex[1] = edge[1];
+            size = 2;
+        }
+
+        double t;
+        v = _closestToOrigin(simplex[0], simplex[1], t);
+        if (t == 0) size = 1;
+        else if (t == 1) { simplex[0] = simplex[1]; size = 1; }
+        return false;
+    }
+
+
+    /*
+     * GJK algorithm (see intersects()): returns the distance between V and W, or 0 if they're
+     * within EPSILON of each other. If `test`, returns as soon as they're known not to intersect,
+     * with a lower bound of the distance instead (still positive).
+     */
+    double _gjk(const Point *V, unsigned long n, const Point *W, unsigned long m, bool test) {
+        /*
+         * V and W intersect iff the origin is in their Minkowski difference V - W, whose
+         * extreme point in any direction is the difference of the extreme points of V and W
+         * in opposite directions (see extreme()). We keep a simplex of up to three points of
+         * V - W and its point `v` closest to the origin. At every step, the extreme point `w`
+         * of V - W in the direction of -v is added to the simplex: if `w` doesn't go past the
+         * origin, the line through it perpendicular to `v` separates V - W from the origin.
+         * The simplex is reduced to its face closest to the origin, until it contains the
+         * origin or stops getting any closer (then `v` is the closest point of V - W).
+         */
+        const Point O{0, 0};
+        auto support = [&](const Vector2D &d) {
+            const Point &P = V[extreme(d, V, n)], &Q = W[extreme(-1*d, W, m)];
+            return Point{P.x - Q.x, P.y - Q.y};
+        };
+
+        Point simplex[3] = {{V[0].x - W[0].x, V[0].y - W[0].y}};
+        unsigned size = 1;
+        Point v = simplex[0];
+        // (every step adds a new vertex of V - W, unless it stops getting closer)
+        for (unsigned long step = 0; step < n + m + 2; ++step) {
+            const Vector2D toV = v - O;
+            if (toV.isNull()) return 0;
+            const Point w = support(-1*toV);
+
+            // `bound` is the signed distance from the origin to the line through `w` perpendicular
+            // to `v`; if `w` is no closer than `v` along `v`, `v` is the closest point of V - W
+            const double squaredDist = toV.squaredNorm(), projection = dotProd(toV, w - O);
+            const double bound = projection/std::sqrt(squaredDist);
+            const bool separated = numeric::greater(bound, 0);
+            if (test and separated) return bound;
+            if (squaredDist - projection <= numeric::EPSILON*squaredDist) return separated ? toV.norm() : 0;
+
+            // (if `w` is already in the simplex, or if it doesn't stay there, rounding
+            // errors keep `v` from getting any closer)
+            if (std::find(simplex, simplex + size, w) != simplex + size) return toV.norm();
+
+            simplex[size++] = w;
+            if (_reduceSimplex(simplex, size, v)) return 0;
+            if (std::find(simplex, simplex + size, w) == simplex + size) break;
+        }
+        return (v - O).isNull() ? 0 : (v - O).norm();
+    }
+
+
+    bool intersects(const Point *V, unsigned long n, const Point *W, unsigned long m) {
+        if (n == 0 or m == 0) return false;
+        return _gjk(V, n, W, m, true) == 0;
+    }
+
+
+    double distance(const Point *V, unsigned long n, const Point *W, unsigned long m) {
+        if (n == 0 or m == 0) throw error::ValueError("distance undefined for 0-gon");
+        return _gjk(V, n, W, m, false);
+    }
+
+
+    double distance(const Point &P, const Point *V, unsigned long n) {
+        if (n == 0) throw error::ValueError("distance undefined for 0-gon");
+        if (n == 1) return ::distance(P, V[0]);
+        if (n == 2) return geom::distance(P, {V[0], V[1]});
+        if (contains(P, V, n)) return 0;
+
+        /*
+         * The closest point is on the part of the boundary that's visible from P, which
+         * goes clockwise from the tangent before P to the one after it (see tangent()).
+         * Along this chain, P projects past the end of the first edges, up to the closest
+         * one; that edge is found by binary search.
+         */
+        const unsigned long first = tangent(P, V, n, true), last = tangent(P, V, n);
+        const unsigned long edges = std::max((last + n - first)%n, 1ul);
+        unsigned long a = 0, b = edges - 1;
+        while (a < b) {
+            const unsigned long c = a + (b - a)/2, k = (first + c)%n;
+            if (dotProd(P - V[k + 1], V[k + 1] - V[k]) > 0) a = c + 1;
+            else b = c;
+        }
+        const unsigned long k = (first + a)%n;
+        return geom::distance(P, {V[k], V[k + 1]});
+    }
+
+
+
+    //-------- MERGING --------//
+
+    // Merges the chains of two hulls (see merge())
+    Points _mergeChains(const Point *V, unsigned long n, const Point *W, unsigned long m) {
+        // The upper chain of a hull goes from its first vertex to its rightmost one,
+        // and the lower chain comes back (so it's sorted if read backwards):
+        const Point *rightV = std::max_element(V, V + n, comp::xCoord);
+        const Point *rightW = std::max_element(W, W + m, comp::xCoord);
+        typedef std::reverse_iterator<const Point *> Backwards;
+
+        ScratchArena::Scope scratch;
+        ScratchVector<Point> merged(n + m + 2, scratch.resource());
+        merged.erase(std::unique(merged.begin(),
+                                 std::merge(V, rightV + 1, W, rightW + 1, merged.begin(), comp::xCoord)),
+                     merged.end());
+        ScratchVector<Point> upper(scratch.resource());
+        _extendUpper(upper, merged.cbegin(), merged.cend());
+
+        merged.resize(n + m + 2);
+        merged.erase(std::unique(merged.begin(),
+                                 std::merge(Backwards(V + n + 1), Backwards(rightV), Backwards(W + m + 1),
+                                            Backwards(rightW), merged.begin(), comp::xCoord)),
+                     merged.end());
+        ScratchVector<Point> lower(scratch.resource());
+        _extendLower(lower, merged.cbegin(), merged.cend());
+
+        Points hull;
+        _join(upper, lower, hull);
+        return hull;
+    }
+
+
+    /*
+     * Merges a hull W into a much bigger one V (see merge()). Every vertex of W outside V
+     * hides the vertices of V strictly between its two tangents. Overlapping hidden ranges
+     * are joined into gaps, and so are ranges that share an endpoint (that vertex might be
+     * hidden by the vertices of W on both sides together). The vertices of V outside every
+     * gap are vertices of the result, and each gap is bridged by the outer chain of the hull
+     * of its endpoints and the points that hide it. Returns false in degenerate cases (if the
+     * whole of V is hidden, or if a tangent is ill-conditioned), where the chains should be
+     * merged instead.
+     */
+    bool _mergeByTangents(const Point *V, unsigned long n, const Point *W, unsigned long m, Points &result) {
+        struct Gap {
+            unsigned long start, end;  // V[start] and V[end % n] are kept, the vertices in between are hidden
+            ScratchVector<Point> hiders;  // vertices of W that hide them (and shared endpoints of joined ranges)
+        };
+        struct Hidden { unsigned long start, end, hider; };
+
+        ScratchArena::Scope scratch;
+        ScratchVector<Hidden> hidden(scratch.resource());
+        for (unsigned long j = 0; j < m; ++j) {
+            if (contains(W[j], V, n)) continue;
+            const unsigned long before = tangent(W[j], V, n, true), after = tangent(W[j], V, n);
+            if (before == after) return false;
+            hidden.push_back({before, after > before ? after : after + n, j});
+        }
+        if (hidden.empty()) {  // W is inside V
+            result.assign(V, V + n + 1);
+            return true;
+        }
+
+        std::sort(hidden.begin(), hidden.end(), [](const Hidden &a, const Hidden &b) { return a.start < b.start; });
+        ScratchVector<Gap> gaps(scratch.resource());
+        for (const Hidden &range : hidden) {
+            if (gaps.empty() or range.start > gaps.back().end)
+                gaps.push_back({range.start, range.end, ScratchVector<Point>(scratch.resource())});
+            else {
+                if (range.start == gaps.back().end) gaps.back().hiders.push_back(V[range.start]);
+                gaps.back().end = std::max(gaps.back().end, range.end);
+            }
+            gaps.back().hiders.push_back(W[range.hider]);
+        }
+        // The last gap might wrap around the end and overlap (or touch) the first ones:
+        unsigned long first = 0;
+        while (first + 1 < gaps.size() and gaps[first].start + n <= gaps.back().end) {
+            if (gaps[first].start + n == gaps.back().end) gaps.back().hiders.push_back(V[gaps[first].start]);
+            gaps.back().end = std::max(gaps.back().end, gaps[first].end + n);
+            gaps.back().hiders.insert(gaps.back().hiders.end(), gaps[first].hiders.begin(), gaps[first].hiders.end());
+            ++first;
+        }
+        if (gaps.back().end - gaps[first].start >= n) return false;  // the whole of V is hidden
+
+        result.clear();
+        result.reserve(n + m + 1);
+        for (unsigned long k = first; k < gaps.size(); ++k) {
+            const Gap &gap = gaps[k];
+            const Point &start = V[gap.start], &end = V[gap.end%n];
+
+            // Outer chain of the hull of the gap's endpoints and its hiders:
+            ScratchVector<Point> points(gap.hiders, scratch.resource()), local(scratch.resource());
+            points.push_back(start);
+            points.push_back(end);
+            _monotoneChain(points.data(), points.size(), local);
+            local.pop_back();
+            const auto from = std::find(local.begin(), local.end(), start);
+            if (from == local.end() or std::find(local.begin(), local.end(), end) == local.end()) return false;
+            std::rotate(local.begin(), from, local.end());
+            result.insert(result.end(), local.begin(), std::find(local.begin(), local.end(), end));
+
+            // Kept vertices of V up to the next gap:
+            const unsigned long next = k + 1 < gaps.size() ? gaps[k + 1].start : gaps[first].start + n;
+            for (unsigned long i = gap.end; i < next; i += n - i%n) {  // (in at most two pieces)
+                const unsigned long pieceEnd = std::min(next, i - i%n + n);
+                result.insert(result.end(), V + i%n, V + i%n + (pieceEnd - i));
+            }
+        }
+
+        std::rotate(result.begin(), std::min_element(result.begin(), result.end(), comp::xCoord), result.end());
+        result.push_back(result.front());
+        return true;
+    }
+
+
+    Points merge(const Point *V, unsigned long n, const Point *W, unsigned long m) {
+        if (n == 0) return Points(W, W + (m ? m + 1 : 0));
+        if (m == 0) return Points(V, V + n + 1);
+        if (n < m) {
+            std::swap(V, W);
+            std::swap(n, m);
+        }
+
+        Points result;
+        if (n >= 3 and m*MERGE_TANGENT_RATIO <= n and _mergeByTangents(V, n, W, m, result)) return result;
+        return _mergeChains(V, n, W, m);
+    }
+
+
+
+    //-------- MINKOWSKI SUM --------//
+
+    // Whether an edge of a hull belongs to its upper chain (it goes rightwards, or straight up)
+    bool _isUpperEdge(const Vector2D &e) {
+        return e.x > 0 or (e.x == 0 and e.y > 0);
+    }
+
+    // Whether the edge `e` comes strictly before `f` in a hull (clockwise from its first vertex)
+    bool _edgeBefore(const Vector2D &e, const Vector2D &f) {
+        if (_isUpperEdge(e) != _isUpperEdge(f)) return _isUpperEdge(e);
+        return crossProd(e, f) < 0;  // (both in the same chain, so they're less than pi apart)
+    }
+
+
+    Points minkowskiSum(const Point *V, unsigned long n, const Point *W, unsigned long m) {
+        if (n == 0 or m == 0) return {};
+
+        /*
+         * Both hulls start at their lowest vertex in the comp::xCoord order, and so does their
+         * sum. Its edges are those of both hulls, sorted by angle (clockwise, starting from
+         * the vertical), so we merge them, adding the vertices of both hulls at each step.
+         * Parallel edges get merged into one, since they come one after the other.
+         */
+        const unsigned long edgesV = n == 1 ? 0 : n, edgesW = m == 1 ? 0 : m;  // (a point has no edges)
+        Points sum;
+        sum.reserve(n + m + 1);
+        sum.push_back({V[0].x + W[0].x, V[0].y + W[0].y});
+        for (unsigned long i = 0, j = 0; i < edgesV or j < edgesW; ) {
+            const bool nextV = i < edgesV and (j == edgesW or not _edgeBefore(W[j + 1] - W[j], V[i + 1] - V[i]));
+            const bool nextW = j < edgesW and (i == edgesV or not _edgeBefore(V[i + 1] - V[i], W[j + 1] - W[j]));
+            i += nextV;
+            j += nextW;
+
+            if (i == edgesV and j == edgesW) break;  // back to the first vertex
+
+            // (edges that are parallel up to rounding errors are merged too)
+            const Point P = {V[i].x + W[j].x, V[i].y + W[j].y};
+            while (sum.size() >= 2 and not isClockwiseTurn(sum.end()[-2], sum.back(), P)) sum.pop_back();
+            sum.push_back(P);
+        }
+        sum.push_back(sum.front());
+        return sum;
+    }
+
+
+
+    //-------- PRE-FILTERING --------//
+
+    unsigned long aklToussaintFilter(Points &points) {
+        FilterStats &stats = filterStats();
+        ++stats.calls;
+        stats.examined += points.size();
+        if (points.size() < 3) return 0;
+
+        // First pass: extreme points in eight directions, in clockwise order starting from
+        // the leftmost one (W, NW, N, NE, E, SE, S, SW):
+        Point extremes[8];
+        std::fill(std::begin(extremes), std::end(extremes), points.front());
+        for (const Point &P : points) {
+            if (P.x < extremes[0].x) extremes[0] = P;
+            if (P.y - P.x > extremes[1].y - extremes[1].x) extremes[1] = P;
+            if (P.y > extremes[2].y) extremes[2] = P;
+            if (P.x + P.y > extremes[3].x + extremes[3].y) extremes[3] = P;
+            if (P.x > extremes[4].x) extremes[4] = P;
+            if (P.x - P.y > extremes[5].x - extremes[5].y) extremes[5] = P;
+            if (P.y < extremes[6].y) extremes[6] = P;
+            if (P.x + P.y < extremes[7].x + extremes[7].y) extremes[7] = P;
+        }
+
+        // The extremes span a convex octagon (possibly with repeated vertices, which we skip):
+        Point octagon[9];
+        unsigned vertices = 0;
+        for (const Point &E : extremes)
+            if (vertices == 0 or E != octagon[vertices - 1]) octagon[vertices++] = E;
+        while (vertices > 1 and octagon[vertices - 1] == octagon[0]) --vertices;
+        if (vertices < 3) return 0;  // degenerate octagon; there's no interior to cull
+
+        octagon[vertices] = octagon[0];  // close the cycle
+
+        /*
+         * Second pass: discard the points that are strictly inside the octagon (strictly to
+         * the right of every edge; see geom::clockwiseTurnsAlong). We work in blocks: each
+         * block is classified with the batch predicate, and then we compact the points that
+         * survive.
+         */
+        constexpr unsigned long BLOCK = 256;
+        bool inside[BLOCK];
+        auto kept = points.begin();
+        for (auto block = points.begin(); block != points.end(); ) {
+            const unsigned long size = std::min<unsigned long>(BLOCK, points.end() - block);
+            clockwiseTurnsAlong(octagon, vertices, &*block, size, inside);
+
+            for (unsigned long j = 0; j < size; ++j) {
+                *kept = block[j];
+                kept += not inside[j];
+            }
+            block += size;
+        }
+
+        const unsigned long discarded = points.end() - kept;
+        points.erase(kept, points.end());
+        stats.discarded += discarded;
+        return discarded;
+    }
+
+
+    FilterStats &filterStats() {
+        static FilterStats globalStats;
+        return globalStats;
+    }
+
+
+
+    //-------- CONFIGURATION --------//
+
+    Config &config() {
+        static Config globalConfig;
+        return globalConfig;
+    }
+
+
+    Algorithm choose(const Points &points) {
+        if (points.size() < config().chanThreshold or points.size() < CHAN_SAMPLE_SIZE)
+            return Algorithm::monotoneChain;
+
+        const unsigned long vertices = _sampleHullSize(points);
+        return vertices*CHAN_SAMPLE_RATIO <= CHAN_SAMPLE_SIZE ? Algorithm::chan : Algorithm::monotoneChain;
+    }
+
+}
@@ -1,9 +1,14 @@
 #include "io-commands.h"
 
+#include <cctype>  // std::isspace
+#include <cstdlib>  // std::strtod
 #include <fstream>
+#include <memory>  // std::unique_ptr
+#include <sstream>
 #include <boost/range/adaptors.hpp>  // boost::adaptors::transform
 #include "details/utils.h"  // readVector
 #include "errors.h"
+#include "hull.h"  // hull::filterStats
 
 
 
@@ -22,6 +27,30 @@ void _open(std::ofstream &stream, const std::string &filename) {
 }
 
 
+// Reads points (pairs of coordinates) from a string, like readVector<Point>() does with a
+// stream (but much faster, for large files). Throws a SyntaxError if anything but whitespace
+// is left after the last point (something that isn't a number, or an odd number of them);
+// `source` is where the string comes from, for the error message.
+inline
+Points _parsePoints(const char *str, const std::string &source) {
+    Points points;
+    char *end;
+    while (true) {
+        Point P;
+        P.x = std::strtod(str, &end);
+        if (end == str) break;
+        const char *y = end;
+        P.y = std::strtod(y, &end);
+        if (end == y) break;
+        points.push_back(P);
+        str = end;
+    }
+    while (std::isspace(*str)) ++str;
+    if (*str != '\0') throw error::SyntaxError("expected pairs of coordinates in " + source);
+    return points;
+}
+
+
 
 
 //-------- EXPOSED FUNCTIONS --------//
@@ -35,14 +64,14 @@ void readPolygon(std::istream &is, PolygonMap &polygonMap) {
 
 void readPolygon(std::istream &is, PolygonMap &polygons, const std::string &id) {
     Points points = readVector<Point>(is);
-    polygons[id] = ConvexPolygon(points);
+    polygons.assign(id, ConvexPolygon(std::move(points)));
 }
 
 
 void printPolygon(const std::string &id, const ConvexPolygon &pol, std::ostream &os) {
     os << id;
 
-    const Points &vertices = pol.getVertices();
+    const Vertices &vertices = pol.getVertices();
     const long end = vertices.size() - 1;
     // we use ints instead of iterators to keep the less-than comparison safe for empty polygons
     for (long i = 0; i < end; ++i)
@@ -55,7 +84,7 @@ void printPolygon(const std::string &id, const ConvexPolygon &pol, std::ostream
 void prettyPrint(const std::string &id, const ConvexPolygon &pol, std::ostream &os) {
     os << id;
 
-    const Points &vertices = pol.getVertices();
+    const Vertices &vertices = pol.getVertices();
     const long end = vertices.size() - 1;
     // we use ints instead of iterators to keep the less-than comparison safe for empty polygons
     for (long i = 0; i < end; ++i)
@@ -65,6 +94,17 @@ void prettyPrint(const std::string &id, const ConvexPolygon &pol, std::ostream &
 }
 
 
+void printStats(std::ostream &os) {
+    const hull::FilterStats &filter = hull::filterStats();
+    const unsigned long examined = filter.examined, discarded = filter.discarded;
+
+    os << "hull filter: " << filter.calls << " point sets, " << examined << " points examined, "
+       << discarded << " discarded";
+    if (examined > 0) os << " (" << 100.0*discarded/examined << "%)";
+    os << std::endl;
+}
+
+
 void save(const std::string &file, const std::vector<std::string> &polygonIDs, const PolygonMap &polygonMap) {
     std::ofstream fileStream;
     _open(fileStream, file);
@@ -85,16 +125,41 @@ void load(const std::string &file, PolygonMap &polygons) {
     std::ifstream fileStream;
     _open(fileStream, file);
 
-    std::string line;
+    // Files written by `save` already contain convex hulls, which don't need to be recomputed:
+    std::string line, id;
     while (getline(fileStream, line)) {
         std::istringstream argStream(line);
-        readPolygon(argStream, polygons);
+        getArgs(argStream, id);
+        const std::size_t rest = argStream.eof() ? line.size() : (std::size_t) argStream.tellg();
+        polygons.assign(id, ConvexPolygon::fromHull(_parsePoints(line.c_str() + rest, file)));
+        polygons.release();  // (in compact mode, so that only one polygon is decoded at a time)
     }
 
     fileStream.close();
 }
 
 
+Points loadPoints(const std::string &file) {
+    std::ifstream fileStream;
+    _open(fileStream, file);
+    std::ostringstream contents;
+    contents << fileStream.rdbuf();
+    fileStream.close();
+
+    return _parsePoints(contents.str().c_str(), file);
+}
+
+
+void printClassification(const ConvexPolygon &pol, const Points &points, std::ostream &os) {
+    std::unique_ptr<bool[]> inside(new bool[points.size()]);
+    isInside(points.data(), points.size(), pol, inside.get());
+
+    std::string bitmap(points.size(), '0');
+    for (std::size_t i = 0; i < points.size(); ++i) bitmap[i] += inside[i];
+    os << bitmap << std::endl;
+}
+
+
 void parseCommand(const std::string &, PolygonMap &);  // forward declaration; defined in `details/handlers.cc`
 
 void include(const std::string &file, PolygonMap &polygonMap, bool silent) {
@@ -113,13 +178,18 @@ void include(const std::string &file, PolygonMap &polygonMap, bool silent) {
 
 
 void list(const PolygonMap &polygonMap) {
-    if (not polygonMap.empty()) {
-        auto it = polygonMap.begin();
-        std::cout << it->first;
-        for (++it; it != polygonMap.end(); ++it)
-            std::cout << ' ' << it->first;
+    printIDs(polygonMap.ids());
+}
+
+
+void printIDs(const std::vector<std::string> &ids, std::ostream &os) {
+    if (not ids.empty()) {
+        auto it = ids.begin();
+        os << *it;
+        for (++it; it != ids.end(); ++it)
+            os << ' ' << *it;
     }
-    std::cout << std::endl;
+    os << std::endl;
 }
 
 
@@ -127,15 +197,7 @@ void list(const PolygonMap &polygonMap) {
 //-------- GET POLYGON --------//
 
 const ConvexPolygon &getPolygon(const std::string &id, const PolygonMap &polygonMap) {
-    auto it = polygonMap.find(id);
-    if (it == polygonMap.end()) throw error::UndefinedID(id);
-    return it->second;
-}
-
-
-ConvexPolygon &getPolygon(const std::string &id, PolygonMap &polygons) {
-    // Behaviour is same as const version, so we just cast away to avoid duplication
-    return const_cast<ConvexPolygon &>(getPolygon(id, const_cast<const PolygonMap &>(polygons)));
+    return polygonMap.at(id);
 }
 
 ConstRange<ConvexPolygon> getPolygons(const std::vector<std::string> &polygonIDs, const PolygonMap &polygonMap) {
@@ -148,3 +210,17 @@ ConstRange<ConvexPolygon> getPolygons(const std::vector<std::string> &polygonIDs
     return boost::adaptors::transform(polygonIDs, getter);
 }
 
+
+std::vector<PolygonMap::Handle> getHandles(const std::vector<std::string> &polygonIDs, const PolygonMap &polygonMap) {
+    std::vector<PolygonMap::Handle> handles;
+    handles.reserve(polygonIDs.size());
+    for (const std::string &id : polygonIDs) handles.push_back(polygonMap.handle(id));
+    return handles;
+}
+
+
+ConstRange<ConvexPolygon> getPolygons(const std::vector<PolygonMap::Handle> &handles, const PolygonMap &polygonMap) {
+    auto getter = [&polygonMap](PolygonMap::Handle h) -> const ConvexPolygon & { return polygonMap.get(h); };
+    return boost::adaptors::transform(handles, getter);
+}
+
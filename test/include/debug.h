@@ -21,7 +21,7 @@ std::ostream &operator<<(std::ostream &os, const std::vector<T> &vec) {
 
 inline
 std::ostream &operator<<(std::ostream &os, const ConvexPolygon &pol) {
-    return os << pol.getVertices();
+    return os << Points(pol.getVertices());
 }
 
 
@@ -0,0 +1,85 @@
+#include <doctest.h>
+#include <cmath>
+#include <random>
+
+#include "class/CompactPolygon.h"
+#include "errors.h"
+
+
+TEST_SUITE("CompactPolygon") {
+
+    TEST_CASE("round trip") {
+        std::mt19937 randGen(42);
+        std::uniform_real_distribution<double> coord(-1e6, 1e6);
+        Points points(1000);
+        for (Point &P : points) P = {coord(randGen), coord(randGen)};
+        const ConvexPolygon pol(points);
+
+        const CompactPolygon compact(pol);
+        REQUIRE(compact.vertexCount() == pol.vertexCount());
+        const Box box = pol.boundingBox();
+        CHECK(compact.step().x == doctest::Approx((box.NE().x - box.SW().x)/(std::pow(2.0, 32) - 2)));
+        CHECK(compact.step().y == doctest::Approx((box.NE().y - box.SW().y)/(std::pow(2.0, 32) - 2)));
+        CHECK(compact.boundingBox().SW().x == doctest::Approx(box.SW().x));
+        CHECK(compact.boundingBox().NE().y == doctest::Approx(box.NE().y));
+        for (unsigned long i = 0; i < pol.vertexCount(); ++i) {
+            CHECK(std::abs(compact.vertex(i).x - pol.getVertices()[i].x) <= compact.step().x);
+            CHECK(std::abs(compact.vertex(i).y - pol.getVertices()[i].y) <= compact.step().y);
+        }
+
+        const ConvexPolygon decoded = compact.decode();
+        CHECK(decoded.vertexCount() == pol.vertexCount());
+        CHECK(decoded.area() == doctest::Approx(pol.area()));
+
+        // Small polygons are decoded within numeric tolerance:
+        const ConvexPolygon small({{0, 0}, {0, 1e-3}, {1e-3, 2e-3}, {2e-3, 0}});
+        CHECK(CompactPolygon(small).decode() == small);
+    }
+
+    TEST_CASE("queries") {
+        const ConvexPolygon hexagon({{0, 0}, {-1, 1}, {0, 2}, {2, 2}, {3, 1}, {2, 0}});
+        const CompactPolygon compact(hexagon);
+        CHECK(compact.area() == doctest::Approx(hexagon.area()));
+        CHECK(compact.perimeter() == doctest::Approx(hexagon.perimeter()));
+        CHECK(compact.boundingBox() == hexagon.boundingBox());
+
+        for (const Point &P : Points{{1, 1}, {-1, 1}, {0.5, 0}, {2.5, 0.5}, {3, 2}, {-0.6, 0.4}, {1, 2.1}})
+            CHECK(compact.contains(P) == isInside(P, hexagon));
+
+        const CompactPolygon segment(ConvexPolygon(Points{{0, 0}, {3, 4}}));
+        CHECK(segment.perimeter() == doctest::Approx(5));
+        CHECK(segment.area() == 0);
+        CHECK(segment.contains({1.5, 2}));
+        CHECK_FALSE(segment.contains({1.5, 2.1}));
+    }
+
+    TEST_CASE("degenerate polygons") {
+        const CompactPolygon empty((ConvexPolygon()));
+        CHECK(empty.empty());
+        CHECK(empty.decode().empty());
+        CHECK(empty.area() == 0);
+        CHECK(empty.perimeter() == 0);
+        CHECK_FALSE(empty.contains({0, 0}));
+        CHECK_THROWS_AS(empty.boundingBox(), error::ValueError);
+
+        const CompactPolygon point(ConvexPolygon({{1e9, -2}}));
+        CHECK(point.vertexCount() == 1);
+        CHECK(point.step().x == 0);
+        CHECK(point.step().y == 0);
+        CHECK(point.decode() == ConvexPolygon({{1e9, -2}}));
+        CHECK(point.contains({1e9, -2}));
+        CHECK_FALSE(point.contains({1e9, -1}));
+    }
+
+    TEST_CASE("color") {
+        ConvexPolygon pol({{0, 0}, {1, 1}, {1, 0}});
+        pol.setColor(RGBColor(1, 0.5, 0));
+        CompactPolygon compact(pol);
+        CHECK(compact.getColor() == RGBColor::unpack(RGBColor(1, 0.5, 0).pack()));
+        CHECK(compact.decode().getColor() == compact.getColor());
+
+        compact.setColor(RGBColor(0, 0, 1));
+        CHECK(compact.getColor() == RGBColor(0, 0, 1));
+    }
+
+}
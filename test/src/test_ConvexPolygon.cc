@@ -3,8 +3,14 @@
 #include <algorithm>
 #include <random>
 #include <cmath>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
 
 #include "class/ConvexPolygon.h"
+#include "geom.h"
+#include "hull.h"
 #include "errors.h"
 
 
@@ -70,6 +76,39 @@ TEST_SUITE("ConvexPolygon") {
                   == Points{{0, 1}, {0, 3}, {1, 4}, {3, 4}, {4, 3}, {4, 1}, {0, 1}});
         }
 
+        SUBCASE("explicit hull algorithm") {
+            std::mt19937 randGen(42);
+            std::normal_distribution<double> normal(0, 10);
+            Points points(10000);
+            for (Point &P : points) P = {normal(randGen), normal(randGen)};
+
+            hull::Config &config = hull::config();
+            const hull::Config defaults = config;
+            config.algorithm = hull::Algorithm::monotoneChain;
+            const ConvexPolygon monotone(points);
+            config.algorithm = hull::Algorithm::chan;
+            const ConvexPolygon chan(points);
+            config = defaults;
+
+            CHECK(chan.getVertices() == monotone.getVertices());
+            CHECK(ConvexPolygon(points).getVertices() == monotone.getVertices());
+        }
+
+        SUBCASE("from hull") {
+            CHECK(ConvexPolygon::fromHull({}).getVertices() == Points());
+            CHECK(ConvexPolygon::fromHull({{1, 1}}).getVertices() == Points{{1, 1}, {1, 1}});
+            CHECK(ConvexPolygon::fromHull({{0, 0}, {0, 1}, {1, 1}, {1, 0}}) == square);
+            CHECK(ConvexPolygon::fromHull(Points(hexagon.getVertices())) == hexagon);  // closed, so recomputed
+
+            // not a hull (counter-clockwise, and an interior point), so it's computed:
+            CHECK(ConvexPolygon::fromHull({{0, 0}, {1, 0}, {0.5, 0.5}, {1, 1}, {0, 1}}) == square);
+
+            // trusted sequences are used as-is:
+            Points counterClockwise = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+            CHECK(ConvexPolygon::fromHull(counterClockwise, true).getVertices()
+                  == Points{{0, 0}, {1, 0}, {1, 1}, {0, 1}, {0, 0}});
+        }
+
         SUBCASE("from Box") {
             Box box({0, 0}, {1, 1});
             ConvexPolygon pol = box;
@@ -117,12 +156,152 @@ TEST_SUITE("ConvexPolygon") {
             CHECK(vertex.boundingBox() == Box({0, 0}, {0, 0}));
             CHECK(line.boundingBox() == Box({{0, 0}, {1, 1}}));
         }
+        SUBCASE("vertex arrays") {
+            const VertexArrays &arrays = hexagon.getVertexArrays();
+            REQUIRE(arrays.x.size() == hexagon.getVertices().size());
+            for (unsigned long i = 0; i < arrays.x.size(); ++i)
+                CHECK(Point{arrays.x[i], arrays.y[i]} == hexagon.getVertices()[i]);
+            CHECK(reinterpret_cast<std::uintptr_t>(arrays.x.data())%64 == 0);
+
+            ConvexPolygon copy = hexagon;
+            CHECK(&copy.getVertexArrays() == &arrays);  // shared between copies
+            copy.insert({3, 0});
+            CHECK(copy.getVertexArrays().x.size() == copy.getVertices().size());  // rebuilt
+            CHECK(copy.area() == 14);
+            CHECK(&hexagon.getVertexArrays() == &arrays);
+        }
+        SUBCASE("vertex storage") {
+            CHECK(triangle.getVertices().isInline());
+            CHECK(ConvexPolygon(Box({0, 0}, {1, 1})).getVertices().isInline());
+            CHECK_FALSE(hexagon.getVertices().isInline());
+
+            ConvexPolygon pol = square;
+            pol.insert({2, 0.5});  // becomes a pentagon
+            CHECK_FALSE(pol.getVertices().isInline());
+            CHECK(pol.getVertices() == Points{{0, 0}, {0, 1}, {1, 1}, {2, 0.5}, {1, 0}, {0, 0}});
+        }
+        SUBCASE("shared vertices") {
+            ConvexPolygon::resetStorageStats();
+            ConvexPolygon pol = hexagon, other;
+            other = pol;
+            CHECK(&pol.getVertices() == &hexagon.getVertices());  // copies share the buffer
+            CHECK(&other.getVertices() == &hexagon.getVertices());
+            CHECK(ConvexPolygon(triangle).getVertices().isInline());  // (small ones are just copied)
+
+            const Vertices before = hexagon.getVertices();
+            pol.insert({3, 0});  // copied on write
+            CHECK(&pol.getVertices() != &hexagon.getVertices());
+            CHECK(hexagon.getVertices() == before);
+            CHECK(other == hexagon);
+            CHECK(pol.getVertices()[3] == Point{3, 0});  // (in place of {2, 0})
+
+            const Point *data = pol.getVertices().data();
+            pol.insert({4, 0});  // not shared anymore: modified in place
+            CHECK(pol.getVertices().data() == data);
+            CHECK(pol.area() == 16);
+
+            const ConvexPolygon::StorageStats stats = ConvexPolygon::storageStats();
+            CHECK(stats.buffers == 1);
+            CHECK(stats.shares == 2);
+            CHECK(stats.copies == 1);
+        }
+        SUBCASE("memoization") {
+            ConvexPolygon pol = hexagon;
+            pol.insert({3, 0});  // so that nothing is memoized yet
+            ConvexPolygon::resetCacheStats();
+
+            CHECK(pol.area() == 14);
+            CHECK(pol.area() == 14);
+            CHECK(pol.boundingBox() == Box({-2, -2}, {3, 2}));
+            CHECK(ConvexPolygon(pol).boundingBox() == Box({-2, -2}, {3, 2}));  // copies share the values
+            CHECK(ConvexPolygon::cacheStats().misses == 2);
+            CHECK(ConvexPolygon::cacheStats().hits == 2);
+
+            pol.insert({4, 0});  // invalidates the memoized values
+            CHECK(pol.area() == 16);
+            CHECK(pol.boundingBox() == Box({-2, -2}, {4, 2}));
+            CHECK(ConvexPolygon::cacheStats().misses == 4);
+
+            // Concurrent first queries compute each value only once:
+            pol.insert({5, 0});
+            ConvexPolygon::resetCacheStats();
+            std::vector<std::thread> threads;
+            std::vector<double> perimeters(8);
+            for (double &perimeter : perimeters)
+                threads.emplace_back([&pol, &perimeter]{ perimeter = pol.perimeter(); });
+            for (std::thread &thread : threads) thread.join();
+            CHECK(ConvexPolygon::cacheStats().misses == 1);
+            CHECK(ConvexPolygon::cacheStats().hits == 7);
+            for (double perimeter : perimeters) CHECK(perimeter == pol.perimeter());
+        }
     }
 }
 
 
 TEST_SUITE("Polygon operations") {
 
+    TEST_CASE("insert") {
+        SUBCASE("degenerate") {
+            ConvexPolygon pol;
+            CHECK(pol.insert({1, 1}));
+            CHECK(pol.getVertices() == Points{{1, 1}, {1, 1}});
+            CHECK_FALSE(pol.insert({1, 1}));
+            CHECK(pol.insert({0, 0}));
+            CHECK(pol.getVertices() == Points{{0, 0}, {1, 1}, {0, 0}});
+            CHECK(pol.insert({1, 0}));
+            CHECK(pol.getVertices() == Points{{0, 0}, {1, 1}, {1, 0}, {0, 0}});
+        }
+        SUBCASE("square") {
+            ConvexPolygon pol = square;
+            CHECK_FALSE(pol.insert({0.5, 0.5}));  // inside
+            CHECK_FALSE(pol.insert({1, 0.5}));  // on the boundary
+            CHECK(pol == square);
+
+            CHECK(pol.insert({2, 0.5}));  // removes no vertices
+            CHECK(pol.getVertices() == Points{{0, 0}, {0, 1}, {1, 1}, {2, 0.5}, {1, 0}, {0, 0}});
+            CHECK(pol.insert({3, 0.5}));  // removes a vertex
+            CHECK(pol.getVertices() == Points{{0, 0}, {0, 1}, {1, 1}, {3, 0.5}, {1, 0}, {0, 0}});
+            CHECK(pol.insert({-1, 0.5}));  // new first vertex
+            CHECK(pol.getVertices() == Points{{-1, 0.5}, {0, 1}, {1, 1}, {3, 0.5}, {1, 0}, {0, 0}, {-1, 0.5}});
+            CHECK(pol.insert({-1.5, 0.5}));  // removes the first vertex
+            CHECK(pol.getVertices() == Points{{-1.5, 0.5}, {0, 1}, {1, 1}, {3, 0.5}, {1, 0}, {0, 0}, {-1.5, 0.5}});
+            CHECK(pol.insert({-1, -0.5}));  // collinear with an edge, removes two vertices
+            CHECK(pol.getVertices() == Points{{-1.5, 0.5}, {0, 1}, {1, 1}, {3, 0.5}, {-1, -0.5}, {-1.5, 0.5}});
+        }
+        SUBCASE("same as building the hull") {
+            std::mt19937 randGen(42);
+            std::uniform_int_distribution<int> coord(-20, 20);  // lots of collinearities
+            std::normal_distribution<double> normal(0, 10);
+
+            for (bool grid : {true, false}) {
+                Points points;
+                ConvexPolygon pol;
+                for (int i = 0; i < 2000; ++i) {
+                    Point P = grid ? Point{double(coord(randGen)), double(coord(randGen))}
+                                   : Point{normal(randGen), normal(randGen)};
+                    points.push_back(P);
+                    pol.insert(P);
+                    if (i%100 == 0) REQUIRE(pol.getVertices() == ConvexPolygon(points).getVertices());
+                }
+                CHECK(pol.getVertices() == ConvexPolygon(points).getVertices());
+            }
+        }
+        SUBCASE("near-collinear points") {
+            // (within the tolerance of the turn tests, the vertices depend on the order of
+            // insertion, but the polygon is always a valid hull)
+            std::mt19937 randGen(42);
+            std::uniform_real_distribution<double> t(-1, 1), noise(-1e-11, 1e-11);
+            for (int run = 0; run < 20; ++run) {
+                ConvexPolygon pol;
+                for (int i = 0; i < 200; ++i) {
+                    const double x = t(randGen);
+                    pol.insert({x, (x < 0 ? 0.5*x : -0.25*x) + noise(randGen)});
+                    REQUIRE(hull::isHull(pol.getVertices().data(), pol.getVertices().size()));
+                }
+            }
+        }
+    }
+
     TEST_CASE("isInside") {
         SUBCASE("single point") {
             CHECK(not isInside({0, 0}, emptyPol));
@@ -156,6 +335,79 @@ TEST_SUITE("Polygon operations") {
             CHECK(isInside(smallSquare, square));
             CHECK(isInside(smallSquare, hexagon));
             CHECK(isInside(square, hexagon));
+            CHECK(not isInside(hexagon, square));
+            CHECK(not isInside(rectangle1, rectangle2));
+
+            CHECK(isInside(line2, square));  // along a vertical edge
+            CHECK(not isInside(ConvexPolygon(Points{{0, 0}, {0, 2}}), square));
+            CHECK(not isInside(ConvexPolygon(Points{{1, -1}, {1, 0.5}}), square));
+        }
+        SUBCASE("big polygons") {  // (by walking both boundaries, or by binary search for tiny ones)
+            Points points;
+            for (int i = 0; i < 1000; ++i) points.push_back({std::cos(2*M_PI*i/1000), std::sin(2*M_PI*i/1000)});
+            const ConvexPolygon circle(points);
+            CHECK(not isInside(square, circle));
+            CHECK(isInside(ConvexPolygon({{0, 0}, {0.5, 0.5}, {0.5, -0.5}}), circle));
+            CHECK(isInside(circle, circle));
+            CHECK(isInside(circle, ConvexPolygon({{-1, -1}, {-1, 1}, {1, 1}, {1, -1}})));
+            CHECK(not isInside(circle, ConvexPolygon({{-1, -1}, {-1, 1}, {0.99, 1}, {0.99, -1}})));
+
+            Points bigger;
+            for (const Point &P : points) bigger.push_back({1.001*P.x, 1.001*P.y});
+            CHECK(isInside(circle, ConvexPolygon(bigger)));
+            CHECK(not isInside(ConvexPolygon(bigger), circle));
+        }
+        SUBCASE("many points") {
+            Points vertices;
+            for (int i = 0; i < 1000; ++i)
+                vertices.push_back({2 + std::cos(2*M_PI*i/1000), 1 + 0.5*std::sin(2*M_PI*i/1000)});
+            const ConvexPolygon ellipse(vertices);
+            const Point center = ellipse.centroid();
+
+            std::mt19937 randGen(42);
+            std::uniform_real_distribution<double> coord(-1.5, 1.5);
+            Points points(5000);
+            for (Point &P : points) P = {center.x + coord(randGen), center.y + coord(randGen)};
+            auto check = [&](const Points &points) {
+                std::unique_ptr<bool[]> inside(new bool[points.size()]);
+                isInside(points.data(), points.size(), ellipse, inside.get());
+                for (unsigned long i = 0; i < points.size(); ++i) {
+                    CAPTURE(points[i]);
+                    REQUIRE(inside[i] == isInside(points[i], ellipse));
+                }
+            };
+
+            check(points);  // (binary searches)
+            check(Points(points.begin(), points.begin() + 10));  // (one by one)
+
+            // Sorted clockwise by angle around the centroid, starting anywhere (sweep):
+            auto angle = [&center](const Point &P) {
+                return std::fmod(std::atan2(P.y - center.y, P.x - center.x) + 4, 2*M_PI);
+            };
+            std::sort(points.begin(), points.end(), [&](const Point &P, const Point &Q) {
+                return angle(P) > angle(Q);
+            });
+            check(points);
+
+            std::swap(points[3000], points[3001]);  // (sweep, and then binary searches)
+            check(points);
+
+            // Points within the tolerance of the boundary (the sweep must agree with the scalar test):
+            const Vertices &V = ellipse.getVertices();
+            // (the edges are short, so the turn tests tolerate distances of about 1e-10 from them)
+            std::uniform_real_distribution<double> t(0, 1), offset(-4e-10, 4e-10);
+            std::uniform_int_distribution<unsigned long> edge(0, ellipse.vertexCount() - 1);
+            Points boundary(5000);
+            for (Point &P : boundary) {
+                const unsigned long i = edge(randGen);
+                const Vector2D along = V[i + 1] - V[i], normal = Vector2D{-along.y, along.x}/along.norm();
+                P = V[i] + t(randGen)*along + offset(randGen)*normal;
+                if (i%2 == 0) P = {V[i].x + offset(randGen), V[i].y + offset(randGen)};  // (around a vertex)
+            }
+            std::sort(boundary.begin(), boundary.end(), [&](const Point &P, const Point &Q) {
+                return angle(P) > angle(Q);
+            });
+            check(boundary);
         }
     }
 
@@ -168,6 +420,9 @@ TEST_SUITE("Polygon operations") {
         }
 
         CHECK(convexUnion(square, square2) == squareUnion);
+        CHECK(convexUnion(square, hexagon) == hexagon);
+        CHECK(convexUnion(line, square) == square);
+        CHECK(convexUnion(square, square) == square);
     }
 
 
@@ -195,6 +450,187 @@ TEST_SUITE("Polygon operations") {
             REQUIRE(result.vertexCount() == 8);
             CHECK(result == c);
         }
+        SUBCASE("containment, contact and disjoint") {
+            const ConvexPolygon big({{-3, -3}, {-3, 3}, {3, 3}, {3, -3}});
+            CHECK(intersection(square, big) == square);
+            CHECK(intersection(big, square) == square);
+            CHECK(intersection(square, square) == square);
+            CHECK(intersection(square, ConvexPolygon({{1, 0}, {1, 1}, {2, 1}, {2, 0}})) == ConvexPolygon(Points{{1, 0}, {1, 1}}));
+            CHECK(intersection(square, ConvexPolygon({{1, 1}, {2, 1}, {2, 2}})) == ConvexPolygon({{1, 1}}));
+            CHECK(intersection(square, ConvexPolygon({{2, 0}, {2, 1}, {3, 1}})).empty());
+            CHECK(intersection(triangle, ConvexPolygon({{1, 1}, {0.6, 1}, {1, 0.6}})).empty());  // parallel edges
+            CHECK(intersection(triangle, ConvexPolygon({{0.5, 0.5}, {1, 1}, {1, 0}})) == ConvexPolygon(Points{{0.5, 0.5}, {1, 0}}));
+
+            ConvexPolygon colored = square;
+            colored.setColor(RGBColor(1, 0, 0));
+            CHECK(intersection(colored, big).getColor() == RGBColor());
+        }
+        SUBCASE("same as the hull of the intersection points") {
+            std::mt19937 randGen(42);
+            std::uniform_int_distribution<int> coord(-10, 10);  // lots of collinearities and contacts
+            std::normal_distribution<double> normal(0, 10);
+
+            for (bool grid : {true, false}) {
+                for (int i = 0; i < 500; ++i) {
+                    Points points1, points2;
+                    for (Points *points : {&points1, &points2})
+                        for (int j = 0; j < 12; ++j)
+                            points->push_back(grid ? Point{double(coord(randGen)), double(coord(randGen))}
+                                                   : Point{normal(randGen), normal(randGen) + 5});
+                    const ConvexPolygon pol1(points1), pol2(points2);
+
+                    // Brute force: every vertex inside the other polygon, and every crossing of two edges
+                    Points expected;
+                    const Vertices &v1 = pol1.getVertices(), &v2 = pol2.getVertices();
+                    for (const Point &P : v1) if (isInside(P, pol2)) expected.push_back(P);
+                    for (const Point &P : v2) if (isInside(P, pol1)) expected.push_back(P);
+                    for (unsigned long j = 0; j + 1 < v1.size(); ++j)
+                        for (unsigned long k = 0; k + 1 < v2.size(); ++k) {
+                            geom::IntersectResult result = geom::intersect({v1[j], v1[j + 1]}, {v2[k], v2[k + 1]});
+                            if (result) expected.push_back(result.getPoint());
+                        }
+
+                    CAPTURE(pol1);
+                    CAPTURE(pol2);
+                    REQUIRE(intersection(pol1, pol2) == ConvexPolygon(expected));
+                    REQUIRE(intersection(pol2, pol1) == ConvexPolygon(expected));
+                }
+            }
+        }
+    }
+
+
+    TEST_CASE("intersects") {
+        SUBCASE("trivial") {
+            CHECK_FALSE(intersects(emptyPol, emptyPol));
+            CHECK_FALSE(intersects(emptyPol, square));
+            CHECK(intersects(vertex, square));
+            CHECK(intersects(line, line2));
+        }
+        SUBCASE("containment, contact and disjoint") {
+            CHECK(intersects(square, hexagon));
+            CHECK(intersects(square, square2));
+            CHECK(intersects(square, ConvexPolygon({{1, 0}, {1, 1}, {2, 1}, {2, 0}})));
+            CHECK(intersects(square, ConvexPolygon({{1, 1}, {2, 1}, {2, 2}})));
+            CHECK_FALSE(intersects(square, ConvexPolygon({{2, 0}, {2, 1}, {3, 1}})));
+            CHECK_FALSE(intersects(triangle, ConvexPolygon({{1, 1}, {0.6, 1}, {1, 0.6}})));  // parallel edges
+        }
+        SUBCASE("same as the emptiness of the intersection") {
+            std::mt19937 randGen(42);
+            std::normal_distribution<double> normal(0, 10);
+            std::uniform_int_distribution<int> size(1, 20);
+            for (int i = 0; i < 2000; ++i) {
+                Points points1(size(randGen)), points2(size(randGen));
+                const double offset = normal(randGen);
+                for (Point &P : points1) P = {normal(randGen), normal(randGen)};
+                for (Point &P : points2) P = {normal(randGen) + offset, normal(randGen) + 3*offset};
+                const ConvexPolygon pol1(points1), pol2(points2);
+                CAPTURE(pol1);
+                CAPTURE(pol2);
+                REQUIRE(intersects(pol1, pol2) == not intersection(pol1, pol2).empty());
+            }
+        }
+    }
+
+
+    TEST_CASE("distance") {
+        SUBCASE("trivial") {
+            CHECK_THROWS_AS(distance(Point{0, 0}, emptyPol), error::ValueError);
+            CHECK_THROWS_AS(distance(square, emptyPol), error::ValueError);
+            CHECK(distance(Point{3, 4}, vertex) == 5);
+            CHECK(distance(Point{0.5, 0.5}, square) == 0);
+            CHECK(distance(Point{0.5, 3}, square) == 2);
+            CHECK(distance(Point{4, 5}, square) == 5);
+        }
+        SUBCASE("polygons") {
+            CHECK(distance(square, square2) == 0);
+            CHECK(distance(square, ConvexPolygon({{2, 0}, {2, 1}, {3, 1}})) == doctest::Approx(1));
+            CHECK(distance(triangle, ConvexPolygon({{1, 1}, {0.6, 1}, {1, 0.6}})) == doctest::Approx(0.3*std::sqrt(2)));
+            CHECK(distance(hexagon, ConvexPolygon({{5, 5}})) == doctest::Approx(geom::distance({5, 5}, {{1, 2}, {2, 0}})));
+        }
+        SUBCASE("many points") {
+            std::mt19937 randGen(42);
+            std::normal_distribution<double> normal(0, 3);
+            Points points(10000);
+            for (Point &P : points) P = {normal(randGen), normal(randGen)};
+            std::unique_ptr<double[]> result(new double[points.size()]);
+            distance(points.data(), points.size(), hexagon, result.get());
+            for (unsigned long i = 0; i < points.size(); ++i) CHECK(result[i] == distance(points[i], hexagon));
+        }
+    }
+
+
+    TEST_CASE("rotating calipers") {
+        const ConvexPolygon rotated({{0, 1}, {1, 2}, {2, 1}, {1, 0}});
+        const geom::Segment d = diameter(rotated), w = width(rotated);
+        CHECK(distance(d.startPt, d.endPt) == 2);
+        CHECK(distance(w.startPt, w.endPt) == doctest::Approx(std::sqrt(2)));
+        CHECK(minAreaRectangle(rotated) == rotated);
+        CHECK(minAreaRectangle(line) == line);
+        CHECK(minAreaRectangle(hexagon).area() == doctest::Approx(16));
+        CHECK_THROWS_AS(diameter(emptyPol), error::ValueError);
+    }
+
+
+    TEST_CASE("Minkowski sum") {
+        CHECK(minkowskiSum(emptyPol, square) == emptyPol);
+        CHECK(minkowskiSum(vertex, hexagon) == hexagon);
+        CHECK(minkowskiSum(ConvexPolygon({{1, 2}}), triangle) == ConvexPolygon({{1, 2}, {2, 2}, {1, 3}}));
+        CHECK(minkowskiSum(line, line2) == ConvexPolygon({{0, 0}, {0, 1}, {1, 2}, {1, 1}}));
+        CHECK(minkowskiSum(square, triangle) == ConvexPolygon({{0, 0}, {0, 2}, {1, 2}, {2, 1}, {2, 0}}));
+
+        // A circle inflated by a smaller one, approximately:
+        Points points1, points2;
+        for (int i = 0; i < 1000; ++i) {
+            points1.push_back({std::cos(2*M_PI*i/1000), std::sin(2*M_PI*i/1000)});
+            points2.push_back({0.5*std::cos(2*M_PI*(i + 0.5)/1000), 0.5*std::sin(2*M_PI*(i + 0.5)/1000)});
+        }
+        const ConvexPolygon sum = minkowskiSum(ConvexPolygon(points1), ConvexPolygon(points2));
+        CHECK(sum.vertexCount() == 2000);
+        CHECK(sum.area() == doctest::Approx(M_PI*1.5*1.5).epsilon(1e-4));
+    }
+
+
+    TEST_CASE("n-ary operations") {
+        SUBCASE("trivial") {
+            CHECK(convexUnion(std::vector<ConvexPolygon>()) == emptyPol);
+            CHECK_THROWS_AS(intersection(std::vector<ConvexPolygon>()), error::ValueError);
+            CHECK(convexUnion(std::vector<ConvexPolygon>{square}) == square);
+            CHECK(intersection(std::vector<ConvexPolygon>{square}) == square);
+        }
+        SUBCASE("small") {
+            const std::vector<ConvexPolygon> polygons = {square, square2, rectangle1, rectangle2};
+            CHECK(convexUnion(polygons) == (squareUnion | rectangle1 | rectangle2));
+            CHECK(intersection(polygons) == smallSquare);
+            CHECK(intersection(std::vector<ConvexPolygon>{square, hexagon, rectangle1, rectangle2}) == square);
+            CHECK(intersection(std::vector<ConvexPolygon>{square, hexagon, ConvexPolygon({{3, 0}})}) == emptyPol);
+        }
+        SUBCASE("big (in parallel)") {
+            // Circles of radius 1 around a point that moves along a circle of radius 0.1:
+            const int n = 5000, count = 20;
+            std::vector<ConvexPolygon> circles;
+            for (int k = 0; k < count; ++k) {
+                Points points(n);
+                for (int i = 0; i < n; ++i) {
+                    const double angle = 2*M_PI*(i + k/double(count))/n, shift = 2*M_PI*k/count;
+                    points[i] = {std::cos(angle) + 0.1*std::cos(shift), std::sin(angle) + 0.1*std::sin(shift)};
+                }
+                circles.push_back(ConvexPolygon(points));
+            }
+
+            ConvexPolygon unionFold = circles[0], intersectionFold = circles[0];
+            for (const ConvexPolygon &circle : circles) {
+                unionFold = unionFold | circle;
+                intersectionFold = intersectionFold & circle;
+            }
+            CHECK(convexUnion(circles) == unionFold);
+            const ConvexPolygon its = intersection(circles);
+            CHECK(its.vertexCount() == intersectionFold.vertexCount());
+            CHECK(its.area() == doctest::Approx(intersectionFold.area()).epsilon(1e-12));
+
+            circles.push_back(ConvexPolygon({{5, 5}, {5, 6}, {6, 5}}));  // disjoint from the rest
+            CHECK(intersection(circles) == emptyPol);
+        }
     }
 
 }
@@ -0,0 +1,127 @@
+#include <doctest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "class/DynamicHull.h"
+#include "hull.h"
+
+
+TEST_SUITE("DynamicHull") {
+
+    TEST_CASE("degenerate") {
+        DynamicHull hull;
+        CHECK(hull.empty());
+        CHECK(hull.polygon().getVertices() == Points());
+        CHECK_FALSE(hull.erase({0, 0}));
+
+        hull.insert({1, 1});
+        hull.insert({1, 1});
+        CHECK(hull.size() == 2);
+        CHECK(hull.polygon().getVertices() == Points{{1, 1}, {1, 1}});
+
+        hull.insert({0, 2});
+        hull.insert({0, 0});
+        hull.insert({0, 1});
+        CHECK(hull.polygon().getVertices() == Points{{0, 0}, {0, 2}, {1, 1}, {0, 0}});
+
+        CHECK(hull.erase({1, 1}));
+        CHECK(hull.polygon().getVertices() == Points{{0, 0}, {0, 2}, {1, 1}, {0, 0}});  // one copy left
+        CHECK(hull.erase({1, 1}));
+        CHECK(hull.polygon().getVertices() == Points{{0, 0}, {0, 2}, {0, 0}});
+        CHECK_FALSE(hull.erase({1, 1}));
+        CHECK(hull.size() == 3);
+    }
+
+    TEST_CASE("square") {
+        DynamicHull hull({{0, 0}, {0, 1}, {1, 1}, {1, 0}, {0.5, 0.5}, {0.5, 0}});
+        CHECK(hull.polygon().getVertices() == Points{{0, 0}, {0, 1}, {1, 1}, {1, 0}, {0, 0}});
+
+        // removing a vertex makes the points behind it resurface:
+        hull.erase({1, 0});
+        CHECK(hull.polygon().getVertices() == Points{{0, 0}, {0, 1}, {1, 1}, {0.5, 0}, {0, 0}});
+        hull.erase({0.5, 0});
+        CHECK(hull.polygon().getVertices() == Points{{0, 0}, {0, 1}, {1, 1}, {0, 0}});
+        hull.insert({2, 0});
+        CHECK(hull.polygon().getVertices() == Points{{0, 0}, {0, 1}, {1, 1}, {2, 0}, {0, 0}});
+    }
+
+    TEST_CASE("same hull as ConvexPolygon") {
+        std::mt19937 randGen(42);
+        std::uniform_int_distribution<int> coord(-15, 15);  // lots of duplicates and collinearities
+        std::normal_distribution<double> normal(0, 10);
+
+        for (bool grid : {true, false}) {
+            auto random = [&]() -> Point {
+                if (grid) return {double(coord(randGen)), double(coord(randGen))};
+                return {normal(randGen), normal(randGen)};
+            };
+
+            Points points(200);
+            for (Point &P : points) P = random();
+            DynamicHull hull(points);
+            CHECK(hull.polygon().getVertices() == ConvexPolygon(points).getVertices());
+
+            // random interleaved insertions and deletions:
+            for (int i = 0; i < 2000; ++i) {
+                if (points.empty() or randGen()%3 == 0) {
+                    points.push_back(random());
+                    hull.insert(points.back());
+                }
+                else {
+                    std::swap(points[randGen()%points.size()], points.back());
+                    CHECK(hull.erase(points.back()));
+                    points.pop_back();
+                }
+                REQUIRE(hull.size() == points.size());
+                if (i%10 == 0) CHECK(hull.polygon().getVertices() == ConvexPolygon(points).getVertices());
+            }
+            CHECK(points.empty() == hull.empty());
+        }
+    }
+
+    TEST_CASE("points on a circle") {
+        Points circle;
+        for (int i = 0; i < 500; ++i)
+            circle.push_back({std::cos(2*M_PI*i/500), std::sin(2*M_PI*i/500)});
+        std::shuffle(circle.begin(), circle.end(), std::mt19937(42));
+
+        DynamicHull hull;
+        for (const Point &P : circle) hull.insert(P);
+        CHECK(hull.polygon().getVertices() == ConvexPolygon(circle).getVertices());
+
+        for (int i = 0; i < 400; ++i) {
+            hull.erase(circle.back());
+            circle.pop_back();
+        }
+        CHECK(hull.polygon().getVertices() == ConvexPolygon(circle).getVertices());
+    }
+
+    TEST_CASE("near-collinear points") {
+        // (within the tolerance of the turn tests, which of them are vertices depends on the
+        // order in which they're tested, but the result is always a valid hull of the points)
+        std::mt19937 randGen(42);
+        std::uniform_real_distribution<double> t(-1, 1), noise(-1e-11, 1e-11);
+        for (int run = 0; run < 20; ++run) {
+            Points points(400);
+            for (Point &P : points) {
+                const double x = t(randGen);
+                P = {x, (x < 0 ? 0.5*x : -0.25*x) + noise(randGen)};
+            }
+            DynamicHull hull;
+            for (const Point &P : points) hull.insert(P);
+            for (int i = 0; i < 100; ++i) {
+                CHECK(hull.erase(points.back()));
+                points.pop_back();
+            }
+
+            const ConvexPolygon pol = hull.polygon();
+            REQUIRE(hull::isHull(pol.getVertices().data(), pol.getVertices().size()));
+            const ConvexPolygon expected(points);
+            CHECK(pol.getVertices().front() == expected.getVertices().front());
+            CHECK(pol.boundingBox() == expected.boundingBox());
+            CHECK(pol.area() == doctest::Approx(expected.area()));
+        }
+    }
+
+}
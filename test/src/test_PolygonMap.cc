@@ -0,0 +1,178 @@
+#include <doctest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "class/PolygonMap.h"
+#include "errors.h"
+
+
+TEST_SUITE("PolygonMap") {
+
+    TEST_CASE("access") {
+        PolygonMap polygons;
+        CHECK(polygons.empty());
+        CHECK_THROWS_AS(polygons.at("a"), error::UndefinedID);
+
+        polygons.assign("b", ConvexPolygon(Points{{0, 0}, {1, 1}}));
+        polygons.insert("a");
+        CHECK(polygons.size() == 2);
+        CHECK(polygons.count("a") == 1);
+        CHECK(polygons.at("a").empty());
+        CHECK(polygons.ids() == std::vector<std::string>{"a", "b"});
+
+        PolygonMap copy = polygons;
+        CHECK(copy == polygons);
+        CHECK(polygons.erase("a"));
+        CHECK_FALSE(polygons.erase("a"));
+        CHECK(copy != polygons);
+        CHECK(copy.ids() == std::vector<std::string>{"a", "b"});
+        CHECK(copy.ids(copy.containing({0.5, 0.5})) == std::vector<std::string>{"b"});
+    }
+
+    TEST_CASE("handles") {
+        PolygonMap polygons;
+        const PolygonMap::Handle a = polygons.insert("a");
+        CHECK(polygons.insert("a") == a);
+        CHECK(polygons.find("a") == a);
+        CHECK(polygons.find("b") == PolygonMap::NONE);
+        CHECK_THROWS_AS(polygons.handle("b"), error::UndefinedID);
+        CHECK(polygons.id(a) == "a");
+        CHECK(polygons.assign("a", ConvexPolygon({{1, 2}})) == a);
+        CHECK(&polygons.at("a") == &polygons.get(a));
+
+        // Many IDs (the table grows, and erasing shifts the probe sequences back):
+        const ConvexPolygon &ref = polygons.at("a");
+        std::vector<PolygonMap::Handle> handles;
+        for (int i = 0; i < 5000; ++i) handles.push_back(polygons.insert("id" + std::to_string(i)));
+        for (int i = 0; i < 5000; i += 3) CHECK(polygons.erase("id" + std::to_string(i)));
+        for (int i = 0; i < 5000; ++i) {
+            const PolygonMap::Handle h = polygons.find("id" + std::to_string(i));
+            CHECK(h == (i%3 == 0 ? PolygonMap::NONE : handles[i]));
+        }
+        CHECK(polygons.size() == 1 + 5000 - 1667);
+        CHECK(&ref == &polygons.at("a"));  // (references stay valid)
+        CHECK(ref == ConvexPolygon({{1, 2}}));
+
+        const PolygonMap::Handle reused = polygons.insert("new");
+        CHECK(reused == handles[4998]);  // (the last one freed)
+        CHECK(polygons.get(reused).empty());
+    }
+
+    TEST_CASE("spatial queries") {
+        PolygonMap polygons;
+        polygons.assign("square", ConvexPolygon({{0, 0}, {0, 2}, {2, 2}, {2, 0}}));
+        polygons.assign("triangle", ConvexPolygon({{1, 1}, {3, 3}, {3, 1}}));
+        polygons.assign("far", ConvexPolygon({{10, 10}, {11, 10}, {10, 11}}));
+        polygons.insert("empty");
+
+        CHECK(polygons.ids(polygons.containing({1.5, 1.2})) == std::vector<std::string>{"square", "triangle"});
+        CHECK(polygons.ids(polygons.containing({2, 2})) == std::vector<std::string>{"square", "triangle"});  // (boundaries)
+        CHECK(polygons.ids(polygons.containing({1.5, 1.8})) == std::vector<std::string>{"square"});  // (inside the triangle's box)
+        CHECK(polygons.containing({5, 5}).empty());
+        CHECK(polygons.ids(polygons.overlapping(polygons.at("triangle"))) == std::vector<std::string>{"square", "triangle"});
+        CHECK(polygons.ids(polygons.overlapping(ConvexPolygon({{2, 3}, {3, 4}, {3, 3}}))) == std::vector<std::string>{"triangle"});
+        CHECK(polygons.overlapping(ConvexPolygon()).empty());
+
+        // The index follows the changes:
+        polygons.assign("far", ConvexPolygon({{1, 1}}));
+        polygons.modify(polygons.handle("square"), [](ConvexPolygon &pol) { pol.insert({5, 5}); });
+        polygons.erase("triangle");
+        CHECK(polygons.ids(polygons.containing({1, 1})) == std::vector<std::string>{"far", "square"});
+        CHECK(polygons.ids(polygons.containing({4, 4})) == std::vector<std::string>{"square"});
+        CHECK(polygons.containing({10.2, 10.2}).empty());
+
+        // References taken before a query see the modifications made after it:
+        const ConvexPolygon &square = polygons.at("square");
+        CHECK(polygons.containing({6, 6}).empty());
+        polygons.modify(polygons.handle("square"), [](ConvexPolygon &pol) { pol.insert({6, 6}); });
+        CHECK(isInside(Point{6, 6}, square));  // (the same polygon)
+        CHECK(polygons.ids(polygons.containing({5.5, 5.5})) == std::vector<std::string>{"square"});
+    }
+
+    TEST_CASE("compact mode") {
+        PolygonMap polygons;
+        polygons.assign("square", ConvexPolygon({{0, 0}, {0, 2}, {2, 2}, {2, 0}}));
+        polygons.assign("triangle", ConvexPolygon({{1, 1}, {3, 3}, {3, 1}}));
+        polygons.insert("empty");
+        polygons.modify(polygons.handle("square"), [](ConvexPolygon &pol) { pol.setColor(RGBColor(1, 0, 0)); });
+        const PolygonMap original = polygons;
+
+        polygons.setCompact(true);
+        CHECK(polygons.compact());
+        CHECK(polygons == original);  // (the vertices are exact multiples of the step)
+        CHECK(polygons.area(polygons.handle("square")) == doctest::Approx(4));
+        CHECK(polygons.perimeter(polygons.handle("triangle")) == doctest::Approx(4 + 2*std::sqrt(2)));
+        CHECK(polygons.boundingBox(polygons.handle("triangle")) == Box({1, 1}, {3, 3}));
+        CHECK(polygons.boundingBox({polygons.handle("empty"), polygons.handle("square"), polygons.handle("triangle")})
+              == Box({0, 0}, {3, 3}));
+        CHECK_THROWS_AS(polygons.boundingBox({polygons.handle("empty")}), error::ValueError);
+        CHECK(polygons.contains(polygons.handle("triangle"), {2, 1.5}));
+        CHECK(polygons.ids(polygons.containing({1.5, 1.2})) == std::vector<std::string>{"square", "triangle"});
+        CHECK(polygons.at("square").getColor() == RGBColor(1, 0, 0));
+
+        // Modifications are encoded again, by the next query or on release:
+        polygons.modify(polygons.handle("square"), [](ConvexPolygon &pol) { pol.insert({5, 5}); });
+        CHECK(polygons.ids(polygons.containing({4, 4})) == std::vector<std::string>{"square"});
+        polygons.release();
+        CHECK(polygons.area(polygons.handle("square")) == doctest::Approx(10));
+        polygons.assign("new", ConvexPolygon({{10, 10}, {11, 10}, {10, 11}}));
+        polygons.erase("triangle");
+        polygons.release();
+        CHECK(polygons.ids(polygons.containing({10.2, 10.2})) == std::vector<std::string>{"new"});
+        CHECK(polygons.ids(polygons.overlapping(polygons.at("square"))) == std::vector<std::string>{"square"});
+
+        polygons.setCompact(false);
+        CHECK_FALSE(polygons.compact());
+        CHECK(polygons.at("square").vertexCount() == 4);  // (rounded, but the same shape)
+        CHECK(polygons.at("square").area() == doctest::Approx(10));
+        CHECK(polygons.ids() == std::vector<std::string>{"empty", "new", "square"});
+        CHECK(polygons.ids(polygons.containing({10.2, 10.2})) == std::vector<std::string>{"new"});
+    }
+
+    TEST_CASE("same as brute force") {
+        std::mt19937 randGen(7);
+        std::uniform_real_distribution<double> coord(0, 100), offset(-3, 3);
+        std::uniform_int_distribution<int> idGen(0, 999), size(1, 8);
+        auto randomPolygon = [&]{
+            const Point center = {coord(randGen), coord(randGen)};
+            Points points(size(randGen));
+            for (Point &P : points) P = {center.x + offset(randGen), center.y + offset(randGen)};
+            return ConvexPolygon(points);
+        };
+
+        PolygonMap polygons;
+        for (int i = 0; i < 2000; ++i) polygons.assign(std::to_string(idGen(randGen)), randomPolygon());
+
+        for (int step = 0; step < 3000; ++step) {
+            const std::string id = std::to_string(idGen(randGen));
+            switch (step%5) {
+                case 0: polygons.assign(id, randomPolygon()); break;
+                case 1: polygons.erase(id); break;
+                case 2: {
+                    const Point P = {coord(randGen), coord(randGen)};
+                    if (polygons.count(id)) polygons.modify(polygons.handle(id), [&P](ConvexPolygon &pol) { pol.insert(P); });
+                    break;
+                }
+                case 3: {
+                    const Point P = {coord(randGen), coord(randGen)};
+                    std::vector<std::string> expected;
+                    for (const std::string &other : polygons.ids())
+                        if (isInside(P, polygons.at(other))) expected.push_back(other);
+                    REQUIRE(polygons.ids(polygons.containing(P)) == expected);
+                    break;
+                }
+                default: {
+                    const ConvexPolygon pol = randomPolygon();
+                    std::vector<std::string> expected;
+                    for (const std::string &other : polygons.ids())
+                        if (intersects(pol, polygons.at(other))) expected.push_back(other);
+                    REQUIRE(polygons.ids(polygons.overlapping(pol)) == expected);
+                }
+            }
+        }
+    }
+
+}
@@ -1,4 +1,5 @@
 #include <doctest.h>
+#include <cmath>
 #include "class/RGBColor.h"
 #include "errors.h"
 
@@ -17,4 +18,18 @@ TEST_SUITE("RGBColor") {
         CHECK(col == RGBColor{0.5, 0.2, 1});
     }
 
+    TEST_CASE("packing") {
+        CHECK(RGBColor(1, 0, 0.5).pack() == 0xFF0080);
+        CHECK(RGBColor::unpack(0xFF0080) == RGBColor(1, 0, 128/255.0));
+        CHECK(RGBColor::unpack(0x12FFFFFF) == RGBColor(1, 1, 1));  // (higher bits ignored)
+
+        for (double value = 0; value <= 1; value += 0.01) {
+            const RGBColor col(value, 1 - value, value/2), unpacked = RGBColor::unpack(col.pack());
+            CHECK(std::abs(unpacked.R() - col.R()) <= 1/510.0);
+            CHECK(std::abs(unpacked.G() - col.G()) <= 1/510.0);
+            CHECK(std::abs(unpacked.B() - col.B()) <= 1/510.0);
+            CHECK(unpacked.pack() == col.pack());
+        }
+    }
+
 };
@@ -0,0 +1,122 @@
+#include <doctest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "class/RTree.h"
+
+
+TEST_SUITE("RTree") {
+
+    // Brute force: the values of the boxes in `boxes` (null if erased) that overlap `query`
+    std::vector<unsigned long> overlapping(const std::vector<const Box *> &boxes, const Box &query) {
+        std::vector<unsigned long> result;
+        for (unsigned long i = 0; i < boxes.size(); ++i) {
+            const Box *box = boxes[i];
+            if (box and box->SW().x <= query.NE().x and query.SW().x <= box->NE().x
+                    and box->SW().y <= query.NE().y and query.SW().y <= box->NE().y)
+                result.push_back(i);
+        }
+        return result;
+    }
+
+    std::vector<unsigned long> sorted(std::vector<unsigned long> values) {
+        std::sort(values.begin(), values.end());
+        return values;
+    }
+
+
+    TEST_CASE("empty and small") {
+        RTree tree;
+        std::vector<unsigned long> result;
+        tree.search(Point{0, 0}, result);
+        CHECK(result.empty());
+        CHECK_FALSE(tree.erase(3));
+
+        tree.insert(3, Box({0, 0}, {1, 1}));
+        tree.insert(5, Box({2, 2}, {2, 2}));  // (a single point)
+        CHECK(tree.size() == 2);
+        CHECK(tree.contains(3));
+        CHECK_FALSE(tree.contains(4));
+        tree.search(Point{1, 0.5}, result);
+        CHECK(result == std::vector<unsigned long>{3});
+        result.clear();
+        tree.search(Box({1, 1}, {3, 3}), result);
+        CHECK(sorted(result) == std::vector<unsigned long>{3, 5});
+
+        tree.insert(3, Box({10, 10}, {11, 11}));  // moved
+        result.clear();
+        tree.search(Point{0.5, 0.5}, result);
+        CHECK(result.empty());
+        CHECK(tree.size() == 2);
+
+        CHECK(tree.erase(3));
+        CHECK(tree.erase(5));
+        CHECK(tree.empty());
+        tree.search(Box({-100, -100}, {100, 100}), result);
+        CHECK(result.empty());
+    }
+
+    TEST_CASE("same as brute force") {
+        std::mt19937 randGen(42);
+        std::uniform_real_distribution<double> coord(0, 100), side(0, 5);
+        auto randomBox = [&]{
+            const Point SW = {coord(randGen), coord(randGen)};
+            return Box(SW, {SW.x + side(randGen), SW.y + side(randGen)});
+        };
+
+        const unsigned long n = 3000;
+        std::vector<Box> boxes;
+        std::vector<const Box *> present(n, nullptr);
+        for (unsigned long i = 0; i < n; ++i) boxes.push_back(randomBox());
+
+        for (bool bulk : {true, false}) {
+            CAPTURE(bulk);
+            RTree tree;
+            if (bulk) {
+                std::vector<RTree::Entry> entries;
+                for (unsigned long i = 0; i < n; i += 2) entries.push_back({boxes[i], i});
+                tree = RTree(entries);
+                for (unsigned long i = 0; i < n; ++i) present[i] = i%2 == 0 ? &boxes[i] : nullptr;
+            }
+            else {
+                for (unsigned long i = 0; i < n; i += 2) tree.insert(i, boxes[i]);
+                for (unsigned long i = 0; i < n; ++i) present[i] = i%2 == 0 ? &boxes[i] : nullptr;
+            }
+
+            // Mixed updates (insertions, moves and deletions) and queries:
+            std::uniform_int_distribution<unsigned long> value(0, n - 1);
+            for (int step = 0; step < 20000; ++step) {
+                const unsigned long i = value(randGen);
+                switch (step%4) {
+                    case 0:
+                        boxes[i] = randomBox();
+                        tree.insert(i, boxes[i]);
+                        present[i] = &boxes[i];
+                        break;
+                    case 1:
+                        CHECK(tree.erase(i) == (present[i] != nullptr));
+                        present[i] = nullptr;
+                        break;
+                    default: {
+                        const Box query = step%4 == 2 ? randomBox() : Box(boxes[i].SW(), boxes[i].SW());
+                        std::vector<unsigned long> result;
+                        if (step%4 == 2) tree.search(query, result);
+                        else tree.search(query.SW(), result);
+                        REQUIRE(sorted(result) == overlapping(present, query));
+                    }
+                }
+            }
+            CHECK(tree.size() == (unsigned long) std::count_if(present.begin(), present.end(),
+                                                               [](const Box *box) { return box != nullptr; }));
+
+            // Erase everything:
+            for (unsigned long i = 0; i < n; ++i) tree.erase(i);
+            CHECK(tree.empty());
+            std::vector<unsigned long> result;
+            tree.search(Box({0, 0}, {200, 200}), result);
+            CHECK(result.empty());
+        }
+    }
+
+}
@@ -0,0 +1,81 @@
+#include <doctest.h>
+#include <cstdint>
+#include <thread>
+
+#include "class/ScratchArena.h"
+#include "class/ConvexPolygon.h"
+#include "consts.h"
+
+
+TEST_SUITE("ScratchArena") {
+
+    TEST_CASE("allocation and reset") {
+        ScratchArena arena(1024);
+        CHECK(arena.capacity() == 1024);
+        const void *first;
+        {
+            ScratchArena::Scope scope(arena);
+            ScratchVector<double> values(10, 1.0, scope.resource());
+            first = values.data();
+            ScratchVector<char> chars(3, 'a', scope.resource());
+            ScratchVector<double> aligned(1, 2.0, scope.resource());
+            CHECK(reinterpret_cast<std::uintptr_t>(aligned.data())%alignof(double) == 0);
+            CHECK(arena.used() >= 10*sizeof(double) + 3 + sizeof(double));
+
+            {
+                ScratchArena::Scope inner(arena);  // (nested: doesn't reset the arena)
+                ScratchVector<int> more(4, 0, inner.resource());
+            }
+            CHECK(arena.used() >= 10*sizeof(double) + 3 + sizeof(double) + 4*sizeof(int));
+            CHECK(values == ScratchVector<double>(10, 1.0));
+        }
+        CHECK(arena.used() == 0);
+
+        // The buffer is reused:
+        ScratchArena::Scope scope(arena);
+        ScratchVector<double> values(10, 1.0, scope.resource());
+        CHECK(values.data() == first);
+    }
+
+    TEST_CASE("growth") {
+        ScratchArena arena;
+        CHECK(arena.capacity() == 0);
+        {
+            ScratchArena::Scope scope(arena);
+            ScratchVector<double> values(1000, 1.0, scope.resource());  // (from the heap)
+            values.resize(3000, 2.0);
+            CHECK(arena.used() >= 4000*sizeof(double));
+        }
+        CHECK(arena.capacity() >= 4000*sizeof(double));  // grown to the peak usage
+
+        const std::size_t capacity = arena.capacity();
+        {
+            ScratchArena::Scope scope(arena);
+            ScratchVector<double> values(3000, 1.0, scope.resource());  // fits now
+        }
+        CHECK(arena.capacity() == capacity);
+
+        {
+            ScratchArena::Scope scope(arena);
+            ScratchVector<char> huge(scratch::MAX_CAPACITY + 1, 'x', scope.resource());
+            CHECK(huge.back() == 'x');
+        }
+        CHECK(arena.capacity() == scratch::MAX_CAPACITY);
+    }
+
+    TEST_CASE("per thread") {
+        const ScratchArena *main = &ScratchArena::local(), *other = nullptr;
+        std::thread thread([&other]{ other = &ScratchArena::local(); });
+        thread.join();
+        CHECK(main != other);
+        CHECK(&ScratchArena::local() == main);
+    }
+
+    TEST_CASE("algorithms leave it empty") {
+        const ConvexPolygon square({{0, 0}, {0, 2}, {2, 2}, {2, 0}}), triangle({{1, 1}, {3, 3}, {3, 1}});
+        CHECK(intersection(square, triangle) == ConvexPolygon({{1, 1}, {2, 2}, {2, 1}}));
+        CHECK(convexUnion(square, triangle) == ConvexPolygon({{0, 0}, {0, 2}, {3, 3}, {3, 1}, {2, 0}}));
+        CHECK(ScratchArena::local().used() == 0);
+    }
+
+}
@@ -0,0 +1,112 @@
+#include <doctest.h>
+#include <cmath>
+#include <deque>
+#include <random>
+
+#include "class/SlidingWindowHull.h"
+#include "errors.h"
+#include "hull.h"
+
+
+TEST_SUITE("SlidingWindowHull") {
+
+    TEST_CASE("degenerate") {
+        SlidingWindowHull window;
+        CHECK(window.empty());
+        CHECK(window.polygon().getVertices() == Points());
+        CHECK_THROWS_AS(window.pop(), error::ValueError);
+
+        window.push({1, 1});
+        window.push({1, 1});
+        CHECK(window.polygon().getVertices() == Points{{1, 1}, {1, 1}});
+        window.push({2, 2});
+        window.push({0, 0});
+        CHECK(window.polygon().getVertices() == Points{{0, 0}, {2, 2}, {0, 0}});
+
+        window.pop();
+        window.pop();
+        CHECK(window.size() == 2);
+        CHECK(window.polygon().getVertices() == Points{{0, 0}, {2, 2}, {0, 0}});
+        window.pop();
+        CHECK(window.polygon().getVertices() == Points{{0, 0}, {0, 0}});
+        window.pop();
+        CHECK(window.empty());
+        CHECK_THROWS_AS(window.pop(), error::ValueError);
+    }
+
+    TEST_CASE("same hull as ConvexPolygon") {
+        std::mt19937 randGen(42);
+        std::uniform_int_distribution<int> coord(-15, 15);  // lots of duplicates and collinearities
+        std::normal_distribution<double> normal(0, 10);
+
+        for (bool grid : {true, false}) {
+            SlidingWindowHull window;
+            std::deque<Point> points;
+
+            for (int i = 0; i < 3000; ++i) {
+                // the window grows and shrinks randomly:
+                if (points.empty() or randGen()%2 == 0) {
+                    Point P = grid ? Point{double(coord(randGen)), double(coord(randGen))}
+                                   : Point{normal(randGen), normal(randGen)};
+                    window.push(P);
+                    points.push_back(P);
+                }
+                else {
+                    window.pop();
+                    points.pop_front();
+                }
+                REQUIRE(window.size() == points.size());
+                if (i%10 == 0) {
+                    CHECK(window.polygon().getVertices()
+                          == ConvexPolygon(Points(points.begin(), points.end())).getVertices());
+                }
+            }
+        }
+    }
+
+    TEST_CASE("points on a circle") {
+        SlidingWindowHull window;
+        std::deque<Point> points;
+        for (int i = 0; i < 2000; ++i) {
+            const Point P = {std::cos(0.01*i*i), std::sin(0.01*i*i)};
+            window.push(P);
+            points.push_back(P);
+            if (points.size() > 300) {
+                window.pop();
+                points.pop_front();
+            }
+            if (i%50 == 0) {
+                CHECK(window.polygon().getVertices()
+                      == ConvexPolygon(Points(points.begin(), points.end())).getVertices());
+            }
+        }
+    }
+
+    TEST_CASE("near-collinear points") {
+        // (within the tolerance of the turn tests, which of them are vertices depends on the
+        // order in which they're tested, but the result is always a valid hull of the points)
+        std::mt19937 randGen(42);
+        std::uniform_real_distribution<double> t(-1, 1), noise(-1e-11, 1e-11);
+        for (int run = 0; run < 20; ++run) {
+            SlidingWindowHull window;
+            std::deque<Point> points;
+            for (int i = 0; i < 400; ++i) {
+                const double x = t(randGen);
+                points.push_back({x, (x < 0 ? 0.5*x : -0.25*x) + noise(randGen)});
+                window.push(points.back());
+            }
+            for (int i = 0; i < 100; ++i) {
+                window.pop();
+                points.pop_front();
+            }
+
+            const ConvexPolygon pol = window.polygon();
+            REQUIRE(hull::isHull(pol.getVertices().data(), pol.getVertices().size()));
+            const ConvexPolygon expected(Points(points.begin(), points.end()));
+            CHECK(pol.getVertices().front() == expected.getVertices().front());
+            CHECK(pol.boundingBox() == expected.boundingBox());
+            CHECK(pol.area() == doctest::Approx(expected.area()));
+        }
+    }
+
+}
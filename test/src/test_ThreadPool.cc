@@ -0,0 +1,62 @@
+#include <doctest.h>
+#include <chrono>
+#include <ctime>  // clock_gettime
+#include <stdexcept>
+#include "class/ThreadPool.h"
+
+
+TEST_SUITE("ThreadPool") {
+
+    TEST_CASE("submit") {
+        ThreadPool pool(2);
+        CHECK(pool.size() == 2);
+
+        std::vector<std::future<int>> results;
+        for (int i = 0; i < 100; ++i)
+            results.push_back(pool.submit([i]{ return i*i; }));
+        for (int i = 0; i < 100; ++i)
+            CHECK(pool.get(results[i]) == i*i);
+    }
+
+    TEST_CASE("exceptions") {
+        ThreadPool pool(1);
+        auto result = pool.submit([]() -> int { throw std::runtime_error("oops"); });
+        CHECK_THROWS_AS(pool.get(result), std::runtime_error);
+    }
+
+    TEST_CASE("nested tasks") {
+        // every worker waits for a task queued behind it; get() must not deadlock
+        ThreadPool pool(2);
+        std::vector<std::future<int>> outer;
+        for (int i = 0; i < 8; ++i)
+            outer.push_back(pool.submit([&pool, i]{
+                auto inner = pool.submit([i]{ return i + 1; });
+                return pool.get(inner);
+            }));
+        for (int i = 0; i < 8; ++i)
+            CHECK(pool.get(outer[i]) == i + 1);
+    }
+
+    TEST_CASE("waiting for a running task") {
+        auto cpuTime = []{
+            timespec t;
+            clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t);
+            return t.tv_sec + t.tv_nsec*1e-9;
+        };
+        ThreadPool pool(1);
+        std::promise<void> started;
+        auto result = pool.submit([&pool, &started]{
+            started.set_value();
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            auto inner = pool.submit([]{ return 1; });  // (wakes up the waiting thread, which may run it)
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            return pool.get(inner) + 1;
+        });
+        started.get_future().wait();  // (the task is running, and the queue is empty)
+
+        const double start = cpuTime();
+        CHECK(pool.get(result) == 2);
+        CHECK(cpuTime() - start < 0.05);  // blocks instead of spinning
+    }
+
+}
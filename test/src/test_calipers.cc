@@ -0,0 +1,99 @@
+#include "debug.h"
+#include <doctest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "calipers.h"
+#include "hull.h"
+#include "errors.h"
+
+
+TEST_SUITE("calipers") {
+
+    // Brute force: the extents of a hull along and across each of its edges
+    struct Extents { double along, across; };
+    std::vector<Extents> edgeExtents(const Points &hull) {
+        std::vector<Extents> result;
+        for (unsigned long i = 0; i + 1 < hull.size(); ++i) {
+            const Vector2D edge = hull[i + 1] - hull[i];
+            double minAlong = INFINITY, maxAlong = -INFINITY, maxAcross = 0;
+            for (const Point &P : hull) {
+                minAlong = std::min(minAlong, geom::dotProd(P - hull[i], edge)/edge.norm());
+                maxAlong = std::max(maxAlong, geom::dotProd(P - hull[i], edge)/edge.norm());
+                maxAcross = std::max(maxAcross, std::abs(geom::crossProd(P - hull[i], edge))/edge.norm());
+            }
+            result.push_back({maxAlong - minAlong, maxAcross});
+        }
+        return result;
+    }
+
+
+    TEST_CASE("degenerate") {
+        const Points point = {{1, 2}, {1, 2}}, segment = {{0, 0}, {3, 4}, {0, 0}};
+        CHECK_THROWS_AS(calipers::diameter(nullptr, 0), error::ValueError);
+        CHECK_THROWS_AS(calipers::minAreaRectangle(nullptr, 0), error::ValueError);
+
+        CHECK(distance(calipers::diameter(point.data(), 1).startPt, calipers::diameter(point.data(), 1).endPt) == 0);
+        CHECK(distance(calipers::diameter(segment.data(), 2).startPt, calipers::diameter(segment.data(), 2).endPt) == 5);
+        CHECK(calipers::width(segment.data(), 2).direction().isNull());
+        CHECK(calipers::minAreaRectangle(segment.data(), 2) == segment);
+    }
+
+    TEST_CASE("rectangles") {
+        const Points square = {{0, 0}, {0, 1}, {1, 1}, {1, 0}, {0, 0}};
+        CHECK(calipers::minAreaRectangle(square.data(), 4) == square);
+
+        const Points rhombus = {{-2, 0}, {0, 2}, {2, 0}, {0, -2}, {-2, 0}};
+        CHECK(calipers::minAreaRectangle(rhombus.data(), 4) == rhombus);
+        const geom::Segment width = calipers::width(rhombus.data(), 4);
+        CHECK((width.endPt - width.startPt).norm() == doctest::Approx(2*std::sqrt(2)));
+        const geom::Segment diameter = calipers::diameter(rhombus.data(), 4);
+        CHECK((diameter.endPt - diameter.startPt).norm() == 4);
+
+        const Points triangle = {{0, 0}, {1, 1}, {4, 0}, {0, 0}};  // (obtuse, so only one side fits best)
+        CHECK(calipers::minAreaRectangle(triangle.data(), 3) == Points{{0, 0}, {0, 1}, {4, 1}, {4, 0}, {0, 0}});
+    }
+
+    TEST_CASE("same as brute force") {
+        std::mt19937 randGen(42);
+        std::uniform_int_distribution<int> coord(-10, 10);  // lots of parallel edges
+        std::normal_distribution<double> normal(0, 10);
+        std::uniform_int_distribution<int> size(3, 30);
+
+        for (bool grid : {true, false}) {
+            for (int i = 0; i < 2000; ++i) {
+                Points points(size(randGen));
+                for (Point &P : points)
+                    P = grid ? Point{double(coord(randGen)), double(coord(randGen))} : Point{normal(randGen), normal(randGen)};
+                const Points hull = hull::monotoneChain(points);
+                const unsigned long n = hull.size() - 1;
+                if (n < 3) continue;
+                CAPTURE(hull);
+
+                double maxDist = 0;
+                for (const Point &P : hull)
+                    for (const Point &Q : hull) maxDist = std::max(maxDist, distance(P, Q));
+                const geom::Segment diameter = calipers::diameter(hull.data(), n);
+                CHECK(distance(diameter.startPt, diameter.endPt) == doctest::Approx(maxDist));
+
+                const std::vector<Extents> extents = edgeExtents(hull);
+                double minWidth = INFINITY, minArea = INFINITY;
+                for (const Extents &e : extents) {
+                    minWidth = std::min(minWidth, e.across);
+                    minArea = std::min(minArea, e.along*e.across);
+                }
+                const geom::Segment width = calipers::width(hull.data(), n);
+                CHECK(distance(width.startPt, width.endPt) == doctest::Approx(minWidth));
+
+                const Points rectangle = calipers::minAreaRectangle(hull.data(), n);
+                REQUIRE(rectangle.size() == 5);
+                const double area = distance(rectangle[0], rectangle[1])*distance(rectangle[1], rectangle[2]);
+                CHECK(area == doctest::Approx(minArea));
+                for (const Point &P : hull) CHECK(hull::contains(P, rectangle.data(), 4));
+            }
+        }
+    }
+
+}
@@ -11,8 +11,8 @@ TEST_SUITE("from file") {
         bool found = testMap.count("circ") and testMap.count("circ-rot");
         REQUIRE(found);
 
-        ConvexPolygon &circ = getPolygon("circ", testMap);
-        ConvexPolygon &circ_rot = getPolygon("circ-rot", testMap);
+        const ConvexPolygon &circ = getPolygon("circ", testMap);
+        const ConvexPolygon &circ_rot = getPolygon("circ-rot", testMap);
         ConvexPolygon its = intersection(circ, circ_rot);
 
         CHECK(its.vertexCount() == 200000);
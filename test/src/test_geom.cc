@@ -1,11 +1,31 @@
 #include <doctest.h>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <string>
 #include <vector>
 #include "geom.h"
+#include "hull.h"
 
 
 typedef std::vector<Point> Points;
 
 
+// Runs a check with every instruction set supported by this CPU:
+static void forEachLevel(const std::function<void()> &check) {
+    using namespace geom;
+    const simd::Level detected = simd::detect();
+    for (simd::Level level : {simd::Level::scalar, simd::Level::sse2, simd::Level::avx2, simd::Level::avx512}) {
+        if (level > detected) break;
+        const std::string name = simd::name(level);
+        CAPTURE(name);
+        simd::level() = level;
+        check();
+    }
+    simd::level() = detected;
+}
+
+
 
 TEST_SUITE("geom") {
 
@@ -85,10 +105,150 @@ TEST_SUITE("geom") {
         CHECK(isInSegment({1 + 1e-13}, seg));
     }
 
+    TEST_CASE("distance to a segment") {
+        Segment seg = {{0, 0}, {2, 0}};
+
+        CHECK(geom::distance({1, 0}, seg) == 0);
+        CHECK(geom::distance({1, -3}, seg) == 3);
+        CHECK(geom::distance({-3, 4}, seg) == 5);
+        CHECK(geom::distance({5, 4}, seg) == 5);
+        CHECK(geom::distance({3, 4}, Segment{{0, 0}, {0, 0}}) == 5);
+    }
+
     TEST_CASE("Vector2D cross prod") {
                 CHECK(crossProd({1, 1}, {2, 2}) == 0);
                 CHECK(crossProd({1, 0}, {0, 1}) == 1);
                 CHECK(crossProd({0, 1}, {1, 0}) == -1);
     }
 
+    TEST_CASE("Vector2D dot prod") {
+        CHECK(dotProd({1, 1}, {2, 2}) == 4);
+        CHECK(dotProd({1, 0}, {0, 1}) == 0);
+        CHECK(dotProd({1, 2}, {-3, 1}) == -1);
+    }
+
+
+    TEST_CASE("batch turns") {
+        // Cross products near ±EPSILON (tiny offsets from a line), collinear and duplicate points:
+        std::mt19937 randGen(42);
+        std::uniform_int_distribution<int> coord(-5, 5);
+        std::uniform_real_distribution<double> offset(-3e-12, 3e-12);
+        const Point A = {0, 0}, B = {1, 0};
+
+        Points points(1003);  // not a multiple of any vector width
+        for (Point &P : points) {
+            P = {double(coord(randGen)), double(coord(randGen))};
+            if (randGen()%2) P.y = offset(randGen);
+        }
+
+        SUBCASE("single segment") {
+            forEachLevel([&]{
+                bool cw[1003], ccw[1003];
+                clockwiseTurns(A, B, points.data(), points.size(), cw);
+                counterClockwiseTurns(A, B, points.data(), points.size(), ccw);
+                for (unsigned long i = 0; i < points.size(); ++i) {
+                    CHECK(cw[i] == isClockwiseTurn(A, B, points[i]));
+                    CHECK(ccw[i] == isCounterClockwiseTurn(A, B, points[i]));
+                }
+            });
+        }
+        SUBCASE("along a chain") {
+            const Point square[5] = {{-2, -2}, {-2, 2}, {2, 2}, {2, -2}, {-2, -2}};
+            forEachLevel([&]{
+                bool inside[1003];
+                clockwiseTurnsAlong(square, 4, points.data(), points.size(), inside);
+                for (unsigned long i = 0; i < points.size(); ++i) {
+                    bool expected = true;
+                    for (int j = 0; j < 4; ++j) expected &= isClockwiseTurn(square[j], square[j + 1], points[i]);
+                    CHECK(inside[i] == expected);
+                }
+            });
+        }
+        SUBCASE("consecutive triples") {
+            Points circle;  // every turn is clockwise
+            for (int i = 0; i < 100; ++i) circle.push_back({-std::cos(0.03*i), std::sin(0.03*i)});
+
+            forEachLevel([&]{
+                for (unsigned long n = 0; n < 40; ++n) {
+                    bool expected = true;
+                    for (unsigned long i = 0; i + 2 < n; ++i)
+                        expected &= isClockwiseTurn(points[i], points[i + 1], points[i + 2]);
+                    CHECK(allClockwiseTurns(points.data(), n) == expected);
+                }
+
+                CHECK(allClockwiseTurns(circle.data(), circle.size()));
+                for (unsigned long i : {0ul, 1ul, 57ul, 98ul}) {
+                    Points broken = circle;
+                    broken[i + 1] = broken[i];
+                    CHECK_FALSE(allClockwiseTurns(broken.data(), broken.size()));
+                }
+            });
+        }
+    }
+
+
+    TEST_CASE("batch metrics") {
+        std::mt19937 randGen(42);
+        std::uniform_int_distribution<int> coord(-100, 100);  // exact sums
+        std::vector<double> x(1003), y(1003);
+        for (unsigned long i = 0; i < x.size(); ++i) x[i] = coord(randGen), y[i] = coord(randGen);
+
+        forEachLevel([&]{
+            for (unsigned long n : {0ul, 1ul, 2ul, 3ul, 7ul, 8ul, 9ul, 17ul, 1002ul}) {
+                CAPTURE(n);
+                double shoelace = 0, length = 0;
+                Point sum = {0, 0}, min = {x[0], y[0]}, max = min;
+                for (unsigned long i = 0; i < n; ++i) {
+                    shoelace += (x[i + 1] - x[i])*(y[i + 1] + y[i]);
+                    length += std::sqrt((x[i + 1] - x[i])*(x[i + 1] - x[i]) + (y[i + 1] - y[i])*(y[i + 1] - y[i]));
+                    sum.x += x[i], sum.y += y[i];
+                    min = {std::min(min.x, x[i]), std::min(min.y, y[i])};
+                    max = {std::max(max.x, x[i]), std::max(max.y, y[i])};
+                }
+                CHECK(shoelaceSum(x.data(), y.data(), n) == shoelace);
+                CHECK(chainLength(x.data(), y.data(), n) == doctest::Approx(length));
+                CHECK(coordinateSum(x.data(), y.data(), n) == sum);
+                if (n == 0) continue;
+                Point foundMin, foundMax;
+                coordinateBounds(x.data(), y.data(), n, foundMin, foundMax);
+                CHECK(foundMin == min);
+                CHECK(foundMax == max);
+            }
+        });
+    }
+
+
+    TEST_CASE("batch point location") {
+        // Grid points, on lots of edges, vertices and lines through the first vertex:
+        std::mt19937 randGen(42);
+        std::uniform_int_distribution<int> coord(-8, 8);
+        Points points(1003);
+        for (Point &P : points) P = {double(coord(randGen)), double(coord(randGen))};
+
+        std::vector<Points> polygons = {{}, {{1, 1}}, {{0, 0}, {3, 3}}};
+        for (int size : {3, 5, 10, 40, 200}) {
+            Points sample(size);
+            for (Point &P : sample) P = {double(coord(randGen)), double(coord(randGen))};
+            polygons.push_back(hull::monotoneChain(sample));
+        }
+        Points circle;
+        for (int i = 0; i < 1000; ++i) circle.push_back({8*std::cos(-2*M_PI*i/1000), 8*std::sin(-2*M_PI*i/1000)});
+        polygons.push_back(hull::monotoneChain(circle));
+
+        for (const Points &polygon : polygons) {
+            const unsigned long n = polygon.empty() ? 0 : polygon.size() - 1;
+            std::vector<double> x, y;
+            for (const Point &P : polygon) x.push_back(P.x), y.push_back(P.y);
+            CAPTURE(polygon);
+            forEachLevel([&]{
+                bool inside[1003];
+                insideConvexPolygon(x.data(), y.data(), n, points.data(), points.size(), inside);
+                for (unsigned long i = 0; i < points.size(); ++i) {
+                    CAPTURE(points[i]);
+                    REQUIRE(inside[i] == hull::contains(points[i], polygon.data(), n));
+                }
+            });
+        }
+    }
+
 }
@@ -1,12 +1,75 @@
 #include <doctest.h>
 #include "details/handlers.h"
+#include <iostream>
+#include <sstream>
 #include "errors.h"
 
 
+// Redirects std::cout to a string stream while it's alive (restoring it even if a check throws)
+struct CaptureOutput {
+    std::ostringstream out;
+    std::streambuf *original = std::cout.rdbuf(out.rdbuf());
+
+    ~CaptureOutput() { std::cout.rdbuf(original); }
+};
+
+
 TEST_SUITE("handlers") {
     
     TEST_CASE("unknown command") {
         CHECK_THROWS_AS(getCommandHandler("pripprò"), error::UnknownCommand);
     }
-    
+
+    TEST_CASE("union and intersection") {
+        PolygonMap polygons;
+        polygons.assign("a", ConvexPolygon({{0, 0}, {0, 2}, {2, 2}, {2, 0}}));
+        polygons.assign("b", ConvexPolygon({{1, 1}, {1, 3}, {3, 3}, {3, 1}}));
+        polygons.assign("c", ConvexPolygon({{1, 0}, {1, 3}, {3, 3}, {3, 0}}));
+        const ConvexPolygon a = polygons.at("a"), b = polygons.at("b"), c = polygons.at("c");
+        CaptureOutput capture;
+
+        parseCommand("union u a b c", polygons);
+        CHECK(polygons.at("u") == (a | b | c));
+        parseCommand("intersection i a b c", polygons);
+        CHECK(polygons.at("i") == ConvexPolygon({{1, 1}, {1, 2}, {2, 2}, {2, 1}}));
+        parseCommand("intersection i2 a b", polygons);
+        CHECK(polygons.at("i2") == polygons.at("i"));
+
+        parseCommand("union a b", polygons);  // two IDs: the first one gets updated
+        CHECK(polygons.at("a") == (a | b));
+
+        parseCommand("minkowski m b c", polygons);
+        CHECK(polygons.at("m") == minkowskiSum(b, c));
+        parseCommand("minkowski m c", polygons);
+        CHECK(polygons.at("m") == minkowskiSum(minkowskiSum(b, c), c));
+
+        parseCommand("rectangle r a c", polygons);
+        CHECK(polygons.at("r") == ConvexPolygon({{0, 0}, {0, 3}, {3, 3}, {3, 0}}));
+        CHECK(capture.out.str() == "ok\nok\nok\nok\nok\nok\nok\n");  // (one for each command)
+
+        std::istringstream args("u");
+        CHECK_THROWS_AS(getCommandHandler("union")("union", args, polygons), error::SyntaxError);
+        std::istringstream undefined("x a y");
+        CHECK_THROWS_AS(getCommandHandler("intersection")("intersection", undefined, polygons), error::UndefinedID);
+        CHECK(polygons.count("x") == 0);
+    }
+
+    TEST_CASE("spatial queries") {
+        PolygonMap polygons;
+        CaptureOutput capture;
+        std::ostringstream &out = capture.out;
+        parseCommand("polygon a 0 0 0 2 2 2 2 0", polygons);
+        parseCommand("polygon b 1 1 3 3 3 1", polygons);
+        parseCommand("polygon c 5 5 6 6 6 5", polygons);
+        out.str("");
+
+        parseCommand("containing 1.5 1.2", polygons);
+        parseCommand("overlapping b", polygons);
+        parseCommand("delete a", polygons);
+        parseCommand("bbox d b c", polygons);
+        parseCommand("containing 1.5 1.2", polygons);
+        parseCommand("overlapping c", polygons);
+        CHECK(out.str() == "a b\na\nok\nok\nb d\nd\n");
+    }
+
 }
@@ -0,0 +1,480 @@
+#include "debug.h"
+#include <doctest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "hull.h"
+#include "geom.h"
+#include "errors.h"
+
+
+TEST_SUITE("hull") {
+
+    TEST_CASE("monotone chain") {
+        SUBCASE("degenerate") {
+            CHECK(hull::monotoneChain({}) == Points());
+            CHECK(hull::monotoneChain({{1, 1}, {1, 1}}) == Points{{1, 1}, {1, 1}});
+            CHECK(hull::monotoneChain({{0, 2}, {0, 0}, {0, 1}}) == Points{{0, 0}, {0, 2}, {0, 0}});
+            CHECK(hull::monotoneChain({{2, 2}, {0, 0}, {1, 1}}) == Points{{0, 0}, {2, 2}, {0, 0}});
+        }
+        SUBCASE("square with interior and boundary points") {
+            Points points = {{1, 0}, {0.5, 0}, {0, 1}, {0.5, 0.5}, {1, 1}, {0, 0}, {0, 0.5}};
+            CHECK(hull::monotoneChain(points) == Points{{0, 0}, {0, 1}, {1, 1}, {1, 0}, {0, 0}});
+        }
+        SUBCASE("same output as the graham scan") {
+            std::mt19937 randGen(42);  // seed a generator for reproducible results
+            std::uniform_int_distribution<int> coord(-20, 20);  // small grid, lots of collinearities
+
+            for (int size : {1, 2, 3, 5, 10, 100, 1000}) {
+                Points points(size);
+                for (Point &P : points) P = {double(coord(randGen)), double(coord(randGen))};
+                CHECK(hull::monotoneChain(points) == hull::grahamScan(points));
+            }
+        }
+    }
+
+    TEST_CASE("parallel monotone chain") {
+        std::mt19937 randGen(42);
+        std::uniform_int_distribution<int> coord(-50, 50);
+
+        CHECK(hull::parallelMonotoneChain({}, 4) == Points());
+        CHECK(hull::parallelMonotoneChain({{1, 1}, {1, 1}, {1, 1}}, 4) == Points{{1, 1}, {1, 1}});
+
+        for (int size : {2, 3, 10, 100, 1000, 10000}) {
+            Points points(size);
+            for (Point &P : points) P = {double(coord(randGen)), double(coord(randGen))};
+            for (unsigned chunks : {2u, 3u, 8u})
+                CHECK(hull::parallelMonotoneChain(points, chunks) == hull::monotoneChain(points));
+        }
+
+        SUBCASE("near-collinear points") {
+            // points within the tolerance of the turn tests from a few lines
+            std::uniform_real_distribution<double> t(-1, 1), noise(-1e-11, 1e-11);
+            for (int size : {10, 100, 1000, 10000}) {
+                Points points(size);
+                for (Point &P : points) {
+                    const double x = t(randGen);
+                    P = {x, (x < 0 ? 0.5*x : -0.25*x) + noise(randGen)};
+                }
+                for (unsigned chunks : {2u, 3u, 8u})
+                    CHECK(hull::parallelMonotoneChain(points, chunks) == hull::monotoneChain(points));
+            }
+        }
+        SUBCASE("many points on a circle") {
+            Points circle;
+            for (int i = 0; i < 100000; ++i)
+                circle.push_back({std::cos(2*M_PI*i/100000), std::sin(2*M_PI*i/100000)});
+            std::shuffle(circle.begin(), circle.end(), std::mt19937(42));
+            CHECK(hull::parallelMonotoneChain(circle, 8) == hull::monotoneChain(circle));
+        }
+    }
+
+    TEST_CASE("Chan's algorithm") {
+        SUBCASE("degenerate") {
+            CHECK(hull::chan({}) == Points());
+            CHECK(hull::chan({{1, 1}, {1, 1}}) == Points{{1, 1}, {1, 1}});
+            CHECK(hull::chan({{0, 2}, {0, 0}, {0, 1}, {0, 1}, {0, 0}}) == Points{{0, 0}, {0, 2}, {0, 0}});
+            CHECK(hull::chan(Points(100, {3, 4})) == Points{{3, 4}, {3, 4}});
+        }
+        SUBCASE("same output as the monotone chain") {
+            std::mt19937 randGen(42);
+            std::uniform_int_distribution<int> coord(-30, 30);  // lots of duplicates and collinearities
+            std::normal_distribution<double> normal(0, 10);
+
+            for (int size : {1, 2, 3, 5, 10, 100, 1000, 10000, 100000}) {
+                Points grid(size), cloud(size);
+                for (Point &P : grid) P = {double(coord(randGen)), double(coord(randGen))};
+                for (Point &P : cloud) P = {normal(randGen), normal(randGen)};
+                CHECK(hull::chan(grid) == hull::monotoneChain(grid));
+                CHECK(hull::chan(cloud) == hull::monotoneChain(cloud));
+            }
+        }
+        SUBCASE("near-collinear points") {
+            // (which of the points within the tolerance of the turn tests are kept depends on
+            // the order in which they're tested, but the result is always a valid hull)
+            std::mt19937 randGen(42);
+            std::uniform_real_distribution<double> t(-1, 1), noise(-1e-11, 1e-11);
+            for (int size : {100, 1000, 10000}) {
+                for (int run = 0; run < 20; ++run) {
+                    Points points(size);
+                    for (Point &P : points) {
+                        const double x = t(randGen);
+                        P = {x, (x < 0 ? 0.5*x : -0.25*x) + noise(randGen)};
+                    }
+                    const Points hull = hull::chan(points), reference = hull::monotoneChain(points);
+                    CHECK(hull::isHull(hull));
+                    CHECK(hull.front() == reference.front());  // (leftmost and rightmost points)
+                    CHECK(*std::max_element(hull.begin(), hull.end(), geom::comp::xCoord)
+                          == *std::max_element(reference.begin(), reference.end(), geom::comp::xCoord));
+                }
+            }
+        }
+        SUBCASE("many hull vertices") {
+            Points circle;
+            for (int i = 0; i < 1000; ++i)
+                circle.push_back({std::cos(2*M_PI*i/1000), std::sin(2*M_PI*i/1000)});
+            std::shuffle(circle.begin(), circle.end(), std::mt19937(42));
+            CHECK(hull::chan(circle) == hull::monotoneChain(circle));
+        }
+    }
+
+    TEST_CASE("merge") {
+        // Merges two sets of points' hulls, and checks the result against the hull of all the points:
+        auto check = [](const Points &points1, const Points &points2) {
+            const Points hull1 = hull::monotoneChain(points1), hull2 = hull::monotoneChain(points2);
+            Points all = points1;
+            all.insert(all.end(), points2.begin(), points2.end());
+            const unsigned long n = hull1.empty() ? 0 : hull1.size() - 1, m = hull2.empty() ? 0 : hull2.size() - 1;
+            CAPTURE(hull1);
+            CAPTURE(hull2);
+            CHECK(hull::merge(hull1.data(), n, hull2.data(), m) == hull::monotoneChain(all));
+            CHECK(hull::merge(hull2.data(), m, hull1.data(), n) == hull::monotoneChain(all));
+        };
+
+        SUBCASE("degenerate") {
+            check({}, {});
+            check({}, {{1, 1}});
+            check({{1, 1}}, {{1, 1}});
+            check({{0, 0}}, {{1, 1}});
+            check({{0, 0}, {2, 2}}, {{1, 1}, {3, 3}});
+            check({{0, 0}, {0, 1}, {1, 1}, {1, 0}}, {{0, 0}, {0, 1}, {1, 1}, {1, 0}});
+        }
+        SUBCASE("same size") {
+            std::mt19937 randGen(42);
+            std::uniform_int_distribution<int> coord(-10, 10);  // lots of collinearities and shared vertices
+            for (int i = 0; i < 500; ++i) {
+                Points points1(10), points2(10);
+                for (Points *points : {&points1, &points2})
+                    for (Point &P : *points) P = {double(coord(randGen)), double(coord(randGen))};
+                check(points1, points2);
+            }
+        }
+        SUBCASE("a small one and a big one") {  // (by tangents)
+            std::mt19937 randGen(42);
+            std::uniform_real_distribution<double> angle(0, 2*M_PI), radius(0.5, 1.5);
+            Points circle;
+            for (int i = 0; i < 500; ++i) circle.push_back({std::cos(0.01*i), std::sin(0.01*i)});  // arc: it has corners
+
+            for (int i = 0; i < 3000; ++i) {
+                Points small(1 + i%6);
+                const Point center = {radius(randGen)*std::cos(angle(randGen)), radius(randGen)*std::sin(angle(randGen))};
+                for (Point &P : small) {
+                    const double a = angle(randGen), r = 0.1 + 0.5*(i%3);
+                    P = {center.x + r*std::cos(a), center.y + r*std::sin(a)};
+                }
+                check(circle, small);
+            }
+            check(circle, {{-10, -10}, {-10, 10}, {10, 10}, {10, -10}});  // covers the big one
+            check(circle, {circle[0], circle[499], circle[250]});  // shares vertices with it
+        }
+    }
+
+
+    TEST_CASE("distances") {
+        // Brute force: the closest pair among every vertex and every edge of the other polygon
+        auto edgeDistance = [](const Point &P, const Points &hull) {
+            double result = INFINITY;
+            for (unsigned long i = 0; i + 1 < hull.size(); ++i)
+                result = std::min(result, geom::distance(P, geom::Segment{hull[i], hull[i + 1]}));
+            return result;
+        };
+
+        std::mt19937 randGen(42);
+        std::uniform_int_distribution<int> coord(-6, 6);
+        std::normal_distribution<double> normal(0, 10);
+        std::uniform_int_distribution<int> size(1, 12);
+        for (bool grid : {true, false}) {
+            for (int i = 0; i < 3000; ++i) {
+                Points points1(size(randGen)), points2(size(randGen));
+                const double offset = normal(randGen);
+                for (Points *points : {&points1, &points2})
+                    for (Point &P : *points)
+                        P = grid ? Point{double(coord(randGen)), double(coord(randGen))}
+                                 : Point{normal(randGen) + (points == &points2)*offset, normal(randGen)};
+                const Points hull1 = hull::monotoneChain(points1), hull2 = hull::monotoneChain(points2);
+                const unsigned long n = hull1.size() - 1, m = hull2.size() - 1;
+                CAPTURE(hull1);
+                CAPTURE(hull2);
+
+                for (const Point &P : points2) {
+                    const double expected = hull::contains(P, hull1.data(), n) ? 0 : edgeDistance(P, hull1);
+                    CHECK(hull::distance(P, hull1.data(), n) == doctest::Approx(expected));
+                }
+
+                double expected = 0;
+                if (not hull::intersects(hull1.data(), n, hull2.data(), m)) {
+                    expected = INFINITY;
+                    for (const Point &P : hull1) expected = std::min(expected, edgeDistance(P, hull2));
+                    for (const Point &P : hull2) expected = std::min(expected, edgeDistance(P, hull1));
+                }
+                CHECK(hull::distance(hull1.data(), n, hull2.data(), m) == doctest::Approx(expected));
+            }
+        }
+
+        // Logarithmic for big polygons:
+        Points circle;
+        for (int i = 0; i < 100000; ++i)
+            circle.push_back({std::cos(2*M_PI*i/100000), std::sin(2*M_PI*i/100000)});
+        circle = hull::monotoneChain(circle);
+        const Points square = {{2, -1}, {2, 1}, {4, 1}, {4, -1}, {2, -1}};
+        CHECK(hull::distance({0, 3}, circle.data(), circle.size() - 1) == doctest::Approx(2));
+        CHECK(hull::distance(circle.data(), circle.size() - 1, square.data(), 4) == doctest::Approx(1));
+        CHECK_THROWS_AS(hull::distance({0, 0}, nullptr, 0), error::ValueError);
+    }
+
+
+    TEST_CASE("Minkowski sum") {
+        // Checks the merge of edges against the hull of every sum of two vertices:
+        auto bruteForce = [](const Points &hull1, const Points &hull2) {
+            Points sums;
+            for (const Point &P : hull1)
+                for (const Point &Q : hull2) sums.push_back({P.x + Q.x, P.y + Q.y});
+            return hull::monotoneChain(sums);
+        };
+
+        std::mt19937 randGen(42);
+        std::uniform_int_distribution<int> coord(-6, 6);  // lots of parallel edges
+        std::normal_distribution<double> normal(0, 10);
+        std::uniform_int_distribution<int> size(1, 12);
+        for (bool grid : {true, false}) {
+            for (int i = 0; i < 3000; ++i) {
+                Points points1(size(randGen)), points2(size(randGen));
+                for (Points *points : {&points1, &points2})
+                    for (Point &P : *points)
+                        P = grid ? Point{double(coord(randGen)), double(coord(randGen))}
+                                 : Point{normal(randGen), normal(randGen)};
+                const Points hull1 = hull::monotoneChain(points1), hull2 = hull::monotoneChain(points2);
+                const Points sum = hull::minkowskiSum(hull1.data(), hull1.size() - 1, hull2.data(), hull2.size() - 1);
+                CAPTURE(hull1);
+                CAPTURE(hull2);
+                CHECK(hull::isHull(sum));
+                CHECK(sum == bruteForce(hull1, hull2));
+                CHECK(hull::minkowskiSum(hull2.data(), hull2.size() - 1, hull1.data(), hull1.size() - 1) == sum);
+            }
+        }
+
+        const Points square = {{0, 0}, {0, 1}, {1, 1}, {1, 0}, {0, 0}};
+        CHECK(hull::minkowskiSum(square.data(), 4, nullptr, 0).empty());
+        CHECK(hull::minkowskiSum(square.data(), 4, square.data(), 4) == Points{{0, 0}, {0, 2}, {2, 2}, {2, 0}, {0, 0}});
+        const Points vertical = {{0, 0}, {0, 1}, {0, 0}}, horizontal = {{0, 0}, {1, 0}, {0, 0}};
+        CHECK(hull::minkowskiSum(vertical.data(), 2, vertical.data(), 2) == Points{{0, 0}, {0, 2}, {0, 0}});
+        CHECK(hull::minkowskiSum(vertical.data(), 2, horizontal.data(), 2) == square);
+    }
+
+
+    TEST_CASE("polygon containment") {
+        // Checks the boundary walk against locating each vertex by binary search:
+        auto check = [](const Points &hull1, const Points &hull2) {
+            const unsigned long n = hull1.size() - 1, m = hull2.size() - 1;
+            auto inside = [&](const Point &P) { return hull::contains(P, hull1.data(), n); };
+            CAPTURE(hull1);
+            CAPTURE(hull2);
+            CHECK(hull::contains(hull1.data(), n, hull2.data(), m) == std::all_of(hull2.begin(), hull2.end(), inside));
+        };
+
+        std::mt19937 randGen(42);
+        std::uniform_int_distribution<int> coord(-6, 6);  // lots of shared vertices and edges
+        std::uniform_int_distribution<int> size(1, 12);
+        for (int i = 0; i < 5000; ++i) {
+            Points points1(size(randGen)), points2(size(randGen));
+            for (Points *points : {&points1, &points2})
+                for (Point &P : *points) P = {double(coord(randGen)), double(coord(randGen))};
+            const Points hull1 = hull::monotoneChain(points1), hull2 = hull::monotoneChain(points2);
+            check(hull1, hull2);
+            points1.push_back(points2.front());
+            check(hull::monotoneChain(points1), hull1);  // mostly inside
+        }
+        check({{-1, -1}, {-1, 1}, {1, 1}, {1, -1}, {-1, -1}}, {{-1, 0}, {-1, 2}, {-1, 0}});  // beyond a vertical edge
+        check({{-1, -1}, {-1, 1}, {1, 1}, {1, -1}, {-1, -1}}, {{1, -2}, {1, 0}, {1, -2}});
+        check({{-1, -1}, {-1, 1}, {1, 1}, {1, -1}, {-1, -1}}, {{-1, -1}, {-1, 1}, {1, -1}, {-1, -1}});
+    }
+
+
+    TEST_CASE("extreme vertex") {
+        std::mt19937 randGen(42);
+        std::uniform_int_distribution<int> coord(-6, 6);  // lots of vertical edges
+        std::uniform_int_distribution<int> size(1, 12);
+        for (int i = 0; i < 2000; ++i) {
+            Points points(size(randGen));
+            for (Point &P : points) P = {double(coord(randGen)), double(coord(randGen))};
+            const Points hull = hull::monotoneChain(points);
+            const unsigned long n = hull.size() - 1;
+            for (int j = 0; j < 10; ++j) {
+                const Vector2D d = {double(coord(randGen)), double(coord(randGen))};
+                auto projection = [&d](const Point &P) { return d.x*P.x + d.y*P.y; };
+                const unsigned long index = hull::extreme(d, hull.data(), n);
+                CAPTURE(hull);
+                CAPTURE(d);
+                REQUIRE(index < n);
+                for (const Point &P : hull) CHECK(projection(P) <= projection(hull[index]));
+            }
+        }
+    }
+
+
+    TEST_CASE("polygon intersection test") {
+        // Checks GJK against a separating axis test over every edge (which is exact on a grid):
+        auto check = [](const Points &hull1, const Points &hull2) {
+            std::vector<Vector2D> axes = {{1, 0}, {0, 1}};
+            for (const Points *hull : {&hull1, &hull2})
+                for (unsigned long i = 0; i + 1 < hull->size(); ++i) {
+                    const Vector2D edge = (*hull)[i + 1] - (*hull)[i];
+                    axes.push_back(edge);
+                    axes.push_back({-edge.y, edge.x});
+                }
+            bool separated = false;
+            for (const Vector2D &axis : axes) {
+                auto projection = [&axis](const Point &P) { return axis.x*P.x + axis.y*P.y; };
+                auto less = [&](const Point &P, const Point &Q) { return projection(P) < projection(Q); };
+                const auto range1 = std::minmax_element(hull1.begin(), hull1.end(), less);
+                const auto range2 = std::minmax_element(hull2.begin(), hull2.end(), less);
+                separated |= projection(*range1.second) < projection(*range2.first)
+                             or projection(*range2.second) < projection(*range1.first);
+            }
+            CAPTURE(hull1);
+            CAPTURE(hull2);
+            CHECK(hull::intersects(hull1.data(), hull1.size() - 1, hull2.data(), hull2.size() - 1) == not separated);
+            CHECK(hull::intersects(hull2.data(), hull2.size() - 1, hull1.data(), hull1.size() - 1) == not separated);
+        };
+
+        std::mt19937 randGen(42);
+        std::uniform_int_distribution<int> coord(-6, 6);  // lots of touching vertices and edges
+        std::uniform_int_distribution<int> size(1, 12);
+        for (int i = 0; i < 5000; ++i) {
+            Points points1(size(randGen)), points2(size(randGen));
+            for (Points *points : {&points1, &points2})
+                for (Point &P : *points) P = {double(coord(randGen)), double(coord(randGen))};
+            check(hull::monotoneChain(points1), hull::monotoneChain(points2));
+        }
+        const Points square = {{-1, -1}, {-1, 1}, {1, 1}, {1, -1}, {-1, -1}};
+        check(square, {{1, 1}, {2, 3}, {3, 1}, {1, 1}});  // a shared vertex
+        check(square, {{1, -3}, {1, 3}, {1, -3}});  // along an edge
+        check(square, {{0, 2}, {1, 2}, {0, 2}});
+        check(square, {{2, 0}, {2, 0}});
+        check(square, {{0.5, 0.5}, {0.5, 0.5}});
+        CHECK_FALSE(hull::intersects(square.data(), 4, nullptr, 0));
+
+        // GJK stays logarithmic for big polygons:
+        Points circle;
+        for (int i = 0; i < 100000; ++i)
+            circle.push_back({std::cos(2*M_PI*i/100000), std::sin(2*M_PI*i/100000)});
+        circle = hull::monotoneChain(circle);
+        const Points far = {{1.01, -0.1}, {1.01, 0.1}, {1.2, 0}, {1.01, -0.1}};
+        const Points near = {{0.99, -0.1}, {0.99, 0.1}, {1.2, 0}, {0.99, -0.1}};
+        CHECK_FALSE(hull::intersects(circle.data(), circle.size() - 1, far.data(), 3));
+        CHECK(hull::intersects(circle.data(), circle.size() - 1, near.data(), 3));
+    }
+
+
+    TEST_CASE("hull check") {
+        CHECK(hull::isHull({}));
+        CHECK(hull::isHull({{1, 1}, {1, 1}}));
+        CHECK(hull::isHull({{0, 0}, {0, 2}, {0, 0}}));
+        CHECK(hull::isHull({{0, 0}, {0, 1}, {1, 1}, {1, 0}, {0, 0}}));
+
+        CHECK_FALSE(hull::isHull({{1, 1}}));  // not closed
+        CHECK_FALSE(hull::isHull({{0, 2}, {0, 0}, {0, 2}}));  // doesn't start at the lowest point
+        CHECK_FALSE(hull::isHull({{0, 0}, {0, 1}, {1, 1}, {1, 0}}));  // not closed
+        CHECK_FALSE(hull::isHull({{0, 0}, {1, 0}, {1, 1}, {0, 1}, {0, 0}}));  // counter-clockwise
+        CHECK_FALSE(hull::isHull({{0, 0}, {0, 1}, {0, 2}, {1, 1}, {0, 0}}));  // collinear vertices
+        CHECK_FALSE(hull::isHull({{0, 0}, {0, 1}, {1, 1}, {1, 1}, {1, 0}, {0, 0}}));  // repeated vertex
+        CHECK_FALSE(hull::isHull({{0, 1}, {1, 2}, {1, 0}, {2, 1}, {0, 1}}));  // not convex
+
+        // a pentagram has clockwise turns at every vertex, but winds around twice:
+        Points pentagram;
+        for (int i : {0, 2, 4, 1, 3, 0})
+            pentagram.push_back({-std::cos(2*M_PI*i/5), std::sin(2*M_PI*i/5)});
+        CHECK_FALSE(hull::isHull(pentagram));
+
+        std::mt19937 randGen(42);
+        std::normal_distribution<double> normal(0, 10);
+        Points cloud(1000);
+        for (Point &P : cloud) P = {normal(randGen), normal(randGen)};
+        CHECK(hull::isHull(hull::monotoneChain(cloud)));
+    }
+
+    TEST_CASE("hull algorithm heuristic") {
+        std::mt19937 randGen(42);
+        std::uniform_real_distribution<double> coord(-1, 1);
+
+        Points square(100000), circle;
+        for (Point &P : square) P = {coord(randGen), coord(randGen)};
+        for (int i = 0; i < 100000; ++i)
+            circle.push_back({std::cos(2*M_PI*i/100000), std::sin(2*M_PI*i/100000)});
+
+        CHECK(hull::choose(square) == hull::Algorithm::chan);
+        CHECK(hull::choose(circle) == hull::Algorithm::monotoneChain);
+        CHECK(hull::choose(Points(square.begin(), square.begin() + 100)) == hull::Algorithm::monotoneChain);
+    }
+
+    TEST_CASE("Akl-Toussaint filter") {
+        SUBCASE("square") {
+            Points points = {{0, 0}, {0.5, 0.5}, {0, 1}, {0.2, 0.7}, {1, 1}, {1, 0}, {0.5, 0}};
+            hull::FilterStats &stats = hull::filterStats();
+            stats.reset();
+
+            CHECK(hull::aklToussaintFilter(points) == 2);
+            CHECK(points == Points{{0, 0}, {0, 1}, {1, 1}, {1, 0}, {0.5, 0}});  // order is kept
+            CHECK(stats.calls == 1);
+            CHECK(stats.examined == 7);
+            CHECK(stats.discarded == 2);
+        }
+        SUBCASE("degenerate") {
+            Points points = {{0, 0}, {1, 1}, {2, 2}, {0.5, 0.5}};
+            CHECK(hull::aklToussaintFilter(points) == 0);
+            CHECK(points.size() == 4);
+        }
+        SUBCASE("hull is unchanged") {
+            std::mt19937 randGen(42);
+            std::uniform_int_distribution<int> coord(-30, 30);
+            std::normal_distribution<double> normal(0, 10);
+
+            for (int size : {3, 10, 100, 1000, 10000}) {
+                Points grid(size), cloud(size);
+                for (Point &P : grid) P = {double(coord(randGen)), double(coord(randGen))};
+                for (Point &P : cloud) P = {normal(randGen), normal(randGen)};
+
+                for (const Points &points : {grid, cloud}) {
+                    Points filtered = points;
+                    hull::aklToussaintFilter(filtered);
+                    CHECK(hull::monotoneChain(filtered) == hull::monotoneChain(points));
+                }
+            }
+        }
+        SUBCASE("near-collinear points") {
+            // Points within the tolerance of the turn tests from the edges of a triangle, and some
+            // interior ones: the hull can change (in which nearly collinear points are vertices),
+            // but it's still a valid hull of the same shape
+            std::mt19937 randGen(42);
+            std::uniform_real_distribution<double> u(0, 1), noise(-1e-11, 1e-11);
+            const Point triangle[] = {{0, 0}, {0.5, 1}, {1, 0}, {0, 0}};
+            auto doubleArea = [](const Points &V) {
+                double sum = 0;
+                for (unsigned long i = 0; i + 1 < V.size(); ++i) sum += V[i].x*V[i + 1].y - V[i + 1].x*V[i].y;
+                return sum;
+            };
+
+            int changed = 0;
+            for (int run = 0; run < 100; ++run) {
+                Points points(200);
+                for (Point &P : points) {
+                    const Point &A = triangle[int(3*u(randGen))], &B = (&A)[1];
+                    const double t = u(randGen);
+                    P = {A.x + t*(B.x - A.x) + noise(randGen), A.y + t*(B.y - A.y) + noise(randGen)};
+                }
+                for (int i = 0; i < 100; ++i) points.push_back({0.2 + 0.6*u(randGen), 0.1 + 0.3*u(randGen)});
+
+                Points filtered = points;
+                hull::aklToussaintFilter(filtered);
+                const Points result = hull::monotoneChain(filtered), expected = hull::monotoneChain(points);
+                REQUIRE(hull::isHull(result.data(), result.size()));
+                CHECK(result.front() == expected.front());
+                CHECK(doubleArea(result) == doctest::Approx(doubleArea(expected)));
+                changed += result != expected;
+            }
+            CHECK(changed > 0);  // (the filter isn't output-neutral here)
+        }
+    }
+
+}
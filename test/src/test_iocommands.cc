@@ -1,4 +1,6 @@
 #include <doctest.h>
+#include <cstdio>
+#include <fstream>
 #include <sstream>
 #include "io-commands.h"
 #include "errors.h"
@@ -9,7 +11,7 @@ TEST_SUITE("io commands") {
     TEST_CASE("PolygonMap") {
         ConvexPolygon pol({{0, 0}});
         PolygonMap testMap;
-        testMap["p1"] = pol; testMap["p2"];
+        testMap.assign("p1", pol); testMap.insert("p2");
 
         SUBCASE("getPolygon") {
             CHECK_THROWS_AS(getPolygon("p3", testMap), error::UndefinedID);
@@ -21,6 +23,12 @@ TEST_SUITE("io commands") {
             CHECK_THROWS_AS(getPolygons({"p3"}, testMap).front(), error::UndefinedID);
             CHECK(getPolygons({"p1"}, testMap).front() == pol);
         }
+        SUBCASE("getHandles") {
+            CHECK_THROWS_AS(getHandles({"p1", "p3"}, testMap), error::UndefinedID);
+            const std::vector<PolygonMap::Handle> handles = getHandles({"p1", "p2"}, testMap);
+            CHECK(handles == std::vector<PolygonMap::Handle>{testMap.find("p1"), testMap.find("p2")});
+            CHECK(getPolygons(handles, testMap).front() == pol);
+        }
     }
 
     TEST_CASE("read") {
@@ -28,11 +36,54 @@ TEST_SUITE("io commands") {
 		
         std::istringstream iss1("p1 0 0");
         readPolygon(iss1, testMap);
-        CHECK(testMap["p1"] == ConvexPolygon({{0, 0}}));
+        CHECK(testMap.at("p1") == ConvexPolygon({{0, 0}}));
 
         std::istringstream iss2("1 1");
         readPolygon(iss2, testMap, "p1");
-        CHECK(testMap["p1"] == ConvexPolygon({{1, 1}}));
+        CHECK(testMap.at("p1") == ConvexPolygon({{1, 1}}));
+    }
+
+    TEST_CASE("save and load") {
+        const std::string file = "test-save-load.txt";
+        PolygonMap saved, loaded;
+        saved.assign("square", ConvexPolygon({{0, 0}, {0, 1}, {1, 1}, {1, 0}, {0.5, 0.5}}));
+        saved.assign("point", ConvexPolygon({{2, 2}}));
+        saved.insert("empty");
+        save(file, {"square", "point", "empty"}, saved);
+
+        load(file, loaded);
+        CHECK(loaded == saved);
+
+        for (const char *line : {"p 1 2 3 x 4", "p 1 2 3", "p 1 2 x"}) {
+            {
+                std::ofstream fileStream(file);
+                fileStream << line << "\n";
+            }
+            CHECK_THROWS_AS(load(file, loaded), error::SyntaxError);
+        }
+        std::remove(file.c_str());
+    }
+
+    TEST_CASE("points") {
+        const std::string file = "test-points.txt";
+        {
+            std::ofstream fileStream(file);
+            fileStream << "0.5 0.5\n2 2\n  1 0 \n";
+        }
+        const Points points = loadPoints(file);
+        CHECK(points == Points{{0.5, 0.5}, {2, 2}, {1, 0}});
+
+        std::ostringstream oss;
+        printClassification(ConvexPolygon({{0, 0}, {0, 1}, {1, 1}, {1, 0}}), points, oss);
+        CHECK(oss.str() == "101\n");
+
+        {
+            std::ofstream fileStream(file);
+            fileStream << "0.5 0.5\n2\n";
+        }
+        CHECK_THROWS_AS(loadPoints(file), error::SyntaxError);
+        std::remove(file.c_str());
+        CHECK_THROWS_AS(loadPoints(file), error::IOError);
     }
 
     TEST_CASE("print") {
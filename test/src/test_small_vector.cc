@@ -0,0 +1,65 @@
+#include <doctest.h>
+#include <vector>
+#include "details/small_vector.h"
+
+
+
+TEST_SUITE("SmallVector") {
+
+    TEST_CASE("inline and heap storage") {
+        SmallVector<int, 4> vec = {1, 2, 3};
+        CHECK(vec.isInline());
+        CHECK(vec == std::vector<int>{1, 2, 3});
+
+        vec.push_back(4);
+        CHECK(vec.isInline());
+        vec.insert(vec.begin() + 1, 5);  // doesn't fit anymore
+        CHECK_FALSE(vec.isInline());
+        CHECK(vec == std::vector<int>{1, 5, 2, 3, 4});
+
+        vec.erase(vec.begin(), vec.begin() + 3);
+        CHECK(vec == std::vector<int>{3, 4});
+        CHECK_FALSE(vec.isInline());  // stays on the heap
+    }
+
+    TEST_CASE("modifiers inline") {
+        SmallVector<int, 8> vec = {1, 2, 3, 4};
+        vec.insert(vec.begin(), 0);
+        vec.insert(vec.end(), 5);
+        CHECK(vec == std::vector<int>{0, 1, 2, 3, 4, 5});
+        vec.erase(vec.begin() + 2);
+        vec.pop_back();
+        CHECK(vec == std::vector<int>{0, 1, 3, 4});
+        CHECK(std::vector<int>(vec.rbegin(), vec.rend()) == std::vector<int>{4, 3, 1, 0});
+        CHECK(vec.front() == 0);
+        CHECK(vec.back() == 4);
+        vec.clear();
+        CHECK(vec.empty());
+        CHECK(vec.isInline());
+    }
+
+    TEST_CASE("vector conversions") {
+        std::vector<int> big = {1, 2, 3, 4, 5, 6};
+        const int *buffer = big.data();
+        SmallVector<int, 4> vec(std::move(big));
+        CHECK(vec.data() == buffer);  // adopted without copying
+
+        SmallVector<int, 4> copy = vec;
+        CHECK(copy == vec);
+        CHECK(copy.data() != buffer);
+
+        std::vector<int> back = std::vector<int>(std::move(vec));
+        CHECK(back.data() == buffer);
+        CHECK(vec.empty());
+
+        SmallVector<int, 4> small(std::vector<int>{7, 8});
+        CHECK(small.isInline());
+        SmallVector<int, 4> moved = std::move(small);
+        CHECK(moved == std::vector<int>{7, 8});
+        moved = std::move(copy);
+        CHECK(moved == std::vector<int>{1, 2, 3, 4, 5, 6});
+        CHECK_FALSE(moved.isInline());
+        CHECK(copy.empty());
+    }
+
+}